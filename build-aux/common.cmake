@@ -199,5 +199,8 @@ macro(CL_BUILD_COMPILER_PLUGIN PLUGIN ANALYZER LIBCL_PATH)
     else()
         target_link_libraries(${PLUGIN} ${CLGCC_LIB})
     endif()
-    target_link_libraries(${PLUGIN} ${CL_LIB} ${ANALYZER})
+    # CodeStorage images are linked in parallel threads (see storage_io.cc)
+    find_package(Threads REQUIRED)
+    target_link_libraries(${PLUGIN} ${CL_LIB} ${ANALYZER}
+        ${CMAKE_THREAD_LIBS_INIT})
 endmacro()
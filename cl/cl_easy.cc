@@ -31,8 +31,10 @@
 #include "loopscan.hh"
 #include "pointsto.hh"
 #include "stopwatch.hh"
+#include "storage_io.hh"
 
 #include <string>
+#include <vector>
 
 #define _CL_PRINT_TIME(mech, watch) mech("clEasyRun() took " << watch)
 
@@ -42,6 +44,38 @@
 #   define CL_PRINT_TIME(watch) _CL_PRINT_TIME(CL_DEBUG, watch)
 #endif
 
+namespace {
+    void runEasy(CodeStorage::Storage &stor, const std::string &configString)
+    {
+        if (!stor.fncs.size() && !stor.vars.size()) {
+            // avoid confusing the ccache wrapper when called on empty input
+            CL_DEBUG("CodeStorage::Storage appears empty, giving up...");
+            return;
+        }
+
+        CL_DEBUG("building call-graph...");
+        CodeStorage::CallGraph::buildCallGraph(stor);
+        printMemUsage("buildCallGraph");
+
+        CL_DEBUG("scanning CFG for loop-closing edges...");
+        findLoopClosingEdges(stor);
+        printMemUsage("findLoopClosingEdges");
+
+        CL_DEBUG("perform points-to analysis...");
+        pointsToAnalyse(stor, configString);
+        printMemUsage("pointsToAnalyse");
+
+        CL_DEBUG("killing local variables...");
+        killLocalVariables(stor);
+        printMemUsage("killLocalVariables");
+
+        CL_DEBUG("ClEasy is calling the analyzer...");
+        StopWatch watch;
+        clEasyRun(stor, configString.c_str());
+        CL_PRINT_TIME(watch);
+    }
+}
+
 class ClEasy: public ClStorageBuilder {
     public:
         ClEasy(const char *configString):
@@ -54,33 +88,7 @@ class ClEasy: public ClStorageBuilder {
     protected:
         virtual void run(CodeStorage::Storage &stor) {
             printMemUsage("buildStorage");
-
-            if (!stor.fncs.size() && !stor.vars.size()) {
-                // avoid confusing the ccache wrapper when called on empty input
-                CL_DEBUG("CodeStorage::Storage appears empty, giving up...");
-                return;
-            }
-
-            CL_DEBUG("building call-graph...");
-            CodeStorage::CallGraph::buildCallGraph(stor);
-            printMemUsage("buildCallGraph");
-
-            CL_DEBUG("scanning CFG for loop-closing edges...");
-            findLoopClosingEdges(stor);
-            printMemUsage("findLoopClosingEdges");
-
-            CL_DEBUG("perform points-to analysis...");
-            pointsToAnalyse(stor, configString_);
-            printMemUsage("pointsToAnalyse");
-
-            CL_DEBUG("killing local variables...");
-            killLocalVariables(stor);
-            printMemUsage("killLocalVariables");
-
-            CL_DEBUG("ClEasy is calling the analyzer...");
-            StopWatch watch;
-            clEasyRun(stor, configString_.c_str());
-            CL_PRINT_TIME(watch);
+            runEasy(stor, configString_);
         }
 
     private:
@@ -94,3 +102,37 @@ ICodeListener* createClEasy(const char *configString)
 {
     return new ClEasy(configString);
 }
+
+bool cl_easy_run_on_storage(const char *file_names, int jobs,
+                            const char *config_string)
+{
+    try {
+        // split the comma-separated list of images
+        std::vector<std::string> fileNames;
+        std::string fileName;
+        for (const char *s = file_names; *s; ++s) {
+            if (',' != *s) {
+                fileName.push_back(*s);
+                continue;
+            }
+
+            fileNames.push_back(fileName);
+            fileName.clear();
+        }
+        fileNames.push_back(fileName);
+
+        CodeStorage::StorageImage image;
+        const bool ok = (1 == fileNames.size())
+            ? image.load(file_names)
+            : image.link(fileNames, (0 < jobs) ? jobs : 1);
+        if (!ok)
+            return false;
+
+        printMemUsage("StorageImage");
+        runEasy(image.stor(), config_string);
+        return true;
+    }
+    catch (...) {
+        CL_DIE("uncaught exception in cl_easy_run_on_storage()");
+    }
+}
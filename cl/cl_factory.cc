@@ -31,6 +31,7 @@
 #include "clf_intchk.hh"
 #include "clf_unilabel.hh"
 #include "clf_unswitch.hh"
+#include "storage_io.hh"
 
 #include "util.hh"
 
@@ -296,6 +297,7 @@ ClFactory::ClFactory():
     d(new Private)
 {
     d->map["dotgen"]        = &createClDotGenerator;
+    d->map["dump_storage"]  = &createClStorageDump;
     d->map["easy"]          = &createClEasy;
     d->map["locator"]       = &createClLocator;
     d->map["pp"]            = &createClPrettyPrintDef;
@@ -91,6 +91,9 @@ static struct cl_init_data init_data = {
     0                      // .debug_level
 };
 
+static int cnt_errors;
+static int cnt_warnings;
+
 void cl_debug(const char *msg)
 {
     init_data.debug(msg);
@@ -100,12 +103,14 @@ void cl_warn(const char *msg)
 {
     CHK_LAST(msg, /* filter */ true);
     init_data.warn(msg);
+    ++cnt_warnings;
 }
 
 void cl_error(const char *msg)
 {
     CHK_LAST(msg, /* filter */ true);
     init_data.error(msg);
+    ++cnt_errors;
 }
 
 void cl_note(const char *msg)
@@ -121,6 +126,16 @@ void cl_die(const char *msg)
     abort();
 }
 
+int cl_cnt_errors(void)
+{
+    return cnt_errors;
+}
+
+int cl_cnt_warnings(void)
+{
+    return cnt_warnings;
+}
+
 int cl_debug_level(void)
 {
     return init_data.debug_level;
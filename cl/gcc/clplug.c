@@ -219,8 +219,11 @@ static struct plugin_info cl_info = {
 "    -fplugin-arg-%s-args=PEER_ARGS                 args given to analyzer\n"
 "    -fplugin-arg-%s-dry-run                        do not run the analyzer\n"
 "    -fplugin-arg-%s-dump-pp[=OUTPUT_FILE]          dump linearized code\n"
+"    -fplugin-arg-%s-dump-storage=IMAGE_FILE        write CodeStorage image\n"
 "    -fplugin-arg-%s-dump-types                     dump also type info\n"
 "    -fplugin-arg-%s-gen-dot[=GLOBAL_CG_FILE]       generate CFGs\n"
+"    -fplugin-arg-%s-link-jobs=N                    link images in N threads\n"
+"    -fplugin-arg-%s-load-storage=IMAGE_FILE[,...]  analyze the image(s) instead\n"
 "    -fplugin-arg-%s-pid-file=FILE                  write PID of self to FILE\n"
 "    -fplugin-arg-%s-preserve-ec                    do not affect exit code\n"
 "    -fplugin-arg-%s-type-dot=TYPE_GRAPH_FILE       generate type graphs\n"
@@ -271,7 +274,8 @@ static void init_plugin_name(const struct plugin_name_args *info)
     if (-1 == asprintf(&msg, cl_info.help, plugin_base_name,
                        name, name, name, name,
                        name, name, name, name,
-                       name, name, name, name))
+                       name, name, name, name,
+                       name, name, name))
         // OOM
         abort();
     else
@@ -2091,6 +2095,24 @@ static struct register_pass_info cl_plugin_pass = {
     C99_FIELD(pos_op                  ) PASS_POS_INSERT_AFTER
 };
 
+// FIXME: suboptimal interface of CL messaging
+static void report_exit_code(void)
+{
+    if (preserve_ec)
+        return;
+
+    if (cnt_errors) {
+        // this causes non-zero exit code of gcc
+        error_at(input_location,
+                 "%s has detected some errors", plugin_name);
+    }
+    else if (cnt_warnings) {
+        // this causes non-zero exit code of gcc in case of -Werror
+        warning_at(input_location, 0,
+                   "%s has reported some warnings", plugin_name);
+    }
+}
+
 // callback called as last (if the plug-in does not crash before)
 static void cb_finish(void *gcc_data, void *user_data)
 {
@@ -2104,19 +2126,7 @@ static void cb_finish(void *gcc_data, void *user_data)
         // this should trigger the code listener analyzer (if any)
         cl->acknowledge(cl);
 
-    // FIXME: suboptimal interface of CL messaging
-    if (!preserve_ec) {
-        if (cnt_errors) {
-            // this causes non-zero exit code of gcc
-            error_at(input_location,
-                     "%s has detected some errors", plugin_name);
-        }
-        else if (cnt_warnings) {
-            // this causes non-zero exit code of gcc in case of -Werror
-            warning_at(input_location, 0,
-                       "%s has reported some warnings", plugin_name);
-        }
-    }
+    report_exit_code();
 
     // final cleanup
     cl->destroy(cl);
@@ -2188,6 +2198,9 @@ struct cl_plug_options {
     const char              *analyzer_args;
     const char              *type_dot_file;
     const char              *pid_file;
+    const char              *dump_storage_file;
+    const char              *load_storage_file;
+    int                     link_jobs;
 };
 
 static int clplug_init(const struct plugin_name_args *info,
@@ -2237,6 +2250,14 @@ static int clplug_init(const struct plugin_name_args *info,
             opt->use_pp         = true;
             opt->pp_out_file    = value;
         }
+        else if (STREQ(key, "dump-storage")) {
+            if (value)
+                opt->dump_storage_file = value;
+            else {
+                CL_ERROR("mandatory value omitted for dump-storage");
+                return EXIT_FAILURE;
+            }
+        }
         else if (STREQ(key, "dump-types")) {
             opt->dump_types     = true;
             // TODO: warn about ignoring extra value?
@@ -2250,6 +2271,22 @@ static int clplug_init(const struct plugin_name_args *info,
             preserve_ec = true;
             // TODO: warn about ignoring extra value?
         }
+        else if (STREQ(key, "link-jobs")) {
+            if (value)
+                opt->link_jobs = atoi(value);
+            else {
+                CL_ERROR("mandatory value omitted for link-jobs");
+                return EXIT_FAILURE;
+            }
+        }
+        else if (STREQ(key, "load-storage")) {
+            if (value)
+                opt->load_storage_file = value;
+            else {
+                CL_ERROR("mandatory value omitted for load-storage");
+                return EXIT_FAILURE;
+            }
+        }
         else if (STREQ(key, "pid-file")) {
             if (value)
                 opt->pid_file = value;
@@ -2353,6 +2390,13 @@ create_cl_chain(const struct cl_plug_options *opt)
                 opt->type_dot_file, opt))
         return NULL;
 
+    // the image is meant to be analyzed later, so use the analyzer's filters
+    if (opt->dump_storage_file && !cl_append_listener(chain,
+                "listener=\"dump_storage\" listener_args=\"%s\" "
+                "clf=\"unfold_switch,unify_labels_gl\"",
+                opt->dump_storage_file))
+        return NULL;
+
     if (opt->use_analyzer
             && !cl_append_def_listener(chain, "easy", opt->analyzer_args, opt))
         return NULL;
@@ -2360,6 +2404,26 @@ create_cl_chain(const struct cl_plug_options *opt)
     return chain;
 }
 
+// callback called as last if the analyzer is run on a CodeStorage image
+static void cb_finish_storage(void *gcc_data, void *user_data)
+{
+    (void) gcc_data;
+    const struct cl_plug_options *opt =
+        (const struct cl_plug_options *) user_data;
+
+    if (opt->use_analyzer && !cl_easy_run_on_storage(opt->load_storage_file,
+                                                     opt->link_jobs,
+                                                     opt->analyzer_args))
+        CL_ERROR("failed to analyze CodeStorage image(s) %s",
+                 opt->load_storage_file);
+
+    report_exit_code();
+
+    // final cleanup
+    cl_global_cleanup();
+    free_plugin_name();
+}
+
 static bool write_pid_file(const char *pid_file)
 {
     if (!pid_file)
@@ -2389,7 +2453,8 @@ __attribute__ ((__visibility__ ("default")))
 int plugin_init(struct plugin_name_args *plugin_info,
                 struct plugin_gcc_version *version)
 {
-    struct cl_plug_options opt;
+    // needs to be valid until cb_finish_storage() is called
+    static struct cl_plug_options opt;
 
     // global initialization
     init_plugin_name(plugin_info);
@@ -2432,6 +2497,21 @@ int plugin_init(struct plugin_name_args *plugin_info,
         init.debug = trivial_printer;
 
     cl_global_init(&init);
+
+    if (opt.load_storage_file) {
+        // the code being compiled is not needed, the image describes it all
+        register_callback(plugin_info->base_name, PLUGIN_FINISH,
+                          cb_finish_storage,
+                          /* user_data */  &opt);
+
+        register_callback(plugin_info->base_name, PLUGIN_INFO,
+                          /* callback */   NULL,
+                          &cl_info);
+
+        CL_DEBUG("plug-in initialized to load %s", opt.load_storage_file);
+        return 0;
+    }
+
     cl = create_cl_chain(&opt);
     CL_ASSERT(cl);
 
@@ -22,27 +22,78 @@
 #include <cl/cl_msg.hh>
 #include <cl/memdebug.hh>
 
+#include <algorithm>
 #include <iomanip>
+#include <ostream>
+#include <vector>
+
+#include <fcntl.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#   if __GLIBC_PREREQ(2, 33)
+#       define HAVE_MALLINFO2 1
+#   endif
+#endif
 
-#if DEBUG_MEM_USAGE
-#   include <malloc.h>
-
-static bool overflowDetected;
 static ssize_t peak;
+static ssize_t peakRss;
 
-bool rawMemUsage(ssize_t *pDst)
+/// /proc/self/statm, kept open for the next samples
+static int statmFd = -1;
+
+/// the process that has opened statmFd
+static pid_t statmPid;
+
+bool rawRssUsage(ssize_t *pDst)
 {
-    if (::overflowDetected)
+    const pid_t pid = getpid();
+    if (0 <= ::statmFd && pid != ::statmPid) {
+        // a forked process would read the statm of its parent otherwise
+        close(::statmFd);
+        ::statmFd = -1;
+    }
+
+    if (::statmFd < 0) {
+        ::statmFd = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+        if (::statmFd < 0)
+            return false;
+
+        ::statmPid = pid;
+    }
+
+    char buf[0x100];
+    const ssize_t len = pread(::statmFd, buf, sizeof buf - 1, /* off */ 0);
+    if (len <= 0)
         return false;
 
-    struct mallinfo info = mallinfo();
-    const ssize_t raw = info.uordblks;
-    const unsigned mib = raw >> /* MiB */ 20;
-    if (2048U < mib) {
-        // mallinfo() is broken by design <https://bugzilla.redhat.com/173813>
-        ::overflowDetected = true;
+    buf[len] = '\0';
+    long size, resident;
+    if (2 != sscanf(buf, "%ld %ld", &size, &resident))
         return false;
-    }
+
+    *pDst = static_cast<ssize_t>(resident) * sysconf(_SC_PAGESIZE);
+    if (peakRss < *pDst)
+        peakRss = *pDst;
+
+    return true;
+}
+
+bool rawMemUsage(ssize_t *pDst)
+{
+    ssize_t raw;
+#ifdef HAVE_MALLINFO2
+    // unlike mallinfo(), the fields of mallinfo2() do not overflow at 2 GiB
+    const struct mallinfo2 info = mallinfo2();
+    raw = info.uordblks + info.hblkhd;
+#else
+    // mallinfo() is broken by design <https://bugzilla.redhat.com/173813>
+    if (!rawRssUsage(&raw))
+        return false;
+#endif
 
     *pDst = raw;
     if (peak < raw)
@@ -52,6 +103,15 @@ bool rawMemUsage(ssize_t *pDst)
     return true;
 }
 
+bool trimMemUsage()
+{
+#ifdef __GLIBC__
+    return !!malloc_trim(/* pad */ 0);
+#else
+    return false;
+#endif
+}
+
 static ssize_t memDrift;
 
 bool initMemDrift()
@@ -74,6 +134,100 @@ bool currentMemUsage(ssize_t *pDst)
     return true;
 }
 
+typedef std::vector<MemCounter *> TCounterList;
+
+static TCounterList& counterList()
+{
+    // constructed on first use, counters live in other translation units
+    static TCounterList list;
+    return list;
+}
+
+MemCounter::MemCounter(const char *name):
+    name_(name),
+    value_(0)
+{
+    counterList().push_back(this);
+}
+
+struct MemSample {
+    size_t                  seq;
+    const char             *fnc;
+    ssize_t                 heap;
+    ssize_t                 rss;
+    std::vector<ssize_t>    counters;
+};
+
+typedef std::vector<MemSample> TSampleList;
+
+/// once the limit is reached, every other sample is dropped
+static const size_t maxSamples = 0x10000;
+
+static TSampleList samples;
+static size_t cntCalls;
+static size_t sampleStride = 1U;
+
+static void takeSample(const char *fnc, const ssize_t heap)
+{
+    const size_t seq = ::cntCalls++;
+    if (seq % ::sampleStride)
+        return;
+
+    if (maxSamples <= ::samples.size()) {
+        // halve the resolution of the time series recorded so far
+        size_t dst = 0U;
+        for (size_t src = 0U; src < ::samples.size(); src += 2U)
+            std::swap(::samples[dst++], ::samples[src]);
+
+        ::samples.resize(dst);
+        ::sampleStride <<= 1;
+        if (seq % ::sampleStride)
+            return;
+    }
+
+    ::samples.push_back(MemSample());
+    MemSample &sample = ::samples.back();
+    sample.seq = seq;
+    sample.fnc = fnc;
+    sample.heap = heap;
+    if (!rawRssUsage(&sample.rss))
+        sample.rss = -1;
+
+    const TCounterList &cl = counterList();
+    sample.counters.resize(cl.size());
+    for (size_t i = 0U; i < cl.size(); ++i)
+        sample.counters[i] = cl[i]->value();
+}
+
+bool writeMemUsageSeries(std::ostream &str)
+{
+    const TCounterList &cl = counterList();
+    str << "seq\tfnc\theap\trss";
+    for (size_t i = 0U; i < cl.size(); ++i)
+        str << "\t" << cl[i]->name();
+    str << "\n";
+
+    for (size_t i = 0U; i < ::samples.size(); ++i) {
+        const MemSample &sample = ::samples[i];
+        str << sample.seq << "\t" << sample.fnc
+            << "\t" << sample.heap
+            << "\t" << sample.rss;
+
+        for (size_t j = 0U; j < cl.size(); ++j) {
+            const ssize_t val = (j < sample.counters.size())
+                ? sample.counters[j]
+                : 0;
+
+            str << "\t" << val;
+        }
+
+        str << "\n";
+    }
+
+    str.flush();
+    return !!str;
+}
+
 struct AmountFormatter {
     float       value;
     unsigned    width;
@@ -102,7 +256,6 @@ std::ostream& operator<<(std::ostream &str, const AmountFormatter &fmt)
     return str;
 }
 
-#include <iostream>
 bool printMemUsage(const char *fnc)
 {
     ssize_t cb;
@@ -110,55 +263,39 @@ bool printMemUsage(const char *fnc)
         // instead of printing misleading numbers, we rather print nothing
         return false;
 
+    takeSample(fnc, cb);
+
+#if DEBUG_MEM_USAGE
     CL_DEBUG("current memory usage: " << AmountFormatter(cb,
                 /* MiB */ 20,
                 /* int digits */ 4,
                 /* dec digits */ 2)
             << " MB (just completed " << fnc << "())");
+#endif
 
     return true;
 }
 
 bool printPeakMemUsage()
 {
-    if (::overflowDetected)
-        return false;
+    // the kernel knows the peak resident set size better than our samples
+    struct rusage usage;
+    if (!getrusage(RUSAGE_SELF, &usage)) {
+        const ssize_t maxRss = static_cast<ssize_t>(usage.ru_maxrss) << 10;
+        if (::peakRss < maxRss)
+            ::peakRss = maxRss;
+    }
 
     const ssize_t diff = ::peak - ::memDrift;
     CL_NOTE("peak memory usage: " << AmountFormatter(diff,
                 /* MiB */ 20,
                 /* int digits */ 0,
                 /* dec digits */ 2)
-            << " MB");
+            << " MB (resident: " << AmountFormatter(::peakRss,
+                /* MiB */ 20,
+                /* int digits */ 0,
+                /* dec digits */ 2)
+            << " MB)");
 
     return true;
 }
-
-#else // DEBUG_MEM_USAGE
-
-bool rawMemUsage(ssize_t *)
-{
-    return false;
-}
-
-bool initMemDrift()
-{
-    return false;
-}
-
-bool currentMemUsage(ssize_t *)
-{
-    return false;
-}
-
-bool printMemUsage(const char *)
-{
-    return false;
-}
-
-bool printPeakMemUsage()
-{
-    return false;
-}
-
-#endif
@@ -25,7 +25,10 @@
 #include "cl_storage.hh"
 #include "util.hh"
 
+#include <deque>
+#include <list>
 #include <map>
+#include <set>
 #include <stack>
 
 #include <boost/foreach.hpp>
@@ -381,6 +384,237 @@ bool Block::isLoopEntry() const
 }
 
 
+// /////////////////////////////////////////////////////////////////////////////
+// WtoScheduler implementation
+struct WtoScheduler::Private {
+    typedef std::map<const Block *, unsigned>       TIndex;
+    typedef std::list<const Block *>                TOrder;
+
+    TIndex                          index;
+    std::vector<const Block *>      byIndex;
+    std::set<unsigned>              todo;
+    std::vector<bool>               visited;
+    unsigned                        cntVisits;
+    unsigned                        cntBlocksVisited;
+
+    // used only while computing the order
+    TIndex                          dfn;
+    std::stack<const Block *>       stack;
+    unsigned                        num;
+
+    Private():
+        cntVisits(0),
+        cntBlocksVisited(0),
+        num(0)
+    {
+    }
+
+    void computeOrder(const Block *entry, TOrder &dst);
+};
+
+namespace {
+    /// an activation of visit() or component() of Bourdoncle's algorithm
+    struct WtoFrame {
+        typedef std::list<const Block *>            TOrder;
+
+        enum EKind {
+            WF_VISIT,
+            WF_COMPONENT
+        };
+
+        EKind                       kind;
+        const Block                *bb;
+        TOrder                     *partition;
+        unsigned                    head;
+        bool                        loop;
+        unsigned                    idxSucc;
+        TOrder                      body;
+
+        WtoFrame(const Block *bb_, TOrder *partition_):
+            kind(WF_VISIT),
+            bb(bb_),
+            partition(partition_),
+            head(0),
+            loop(false),
+            idxSucc(0)
+        {
+        }
+    };
+}
+
+/**
+ * the recursive strategy of Bourdoncle's algorithm, with the recursion replaced
+ * by an explicit stack of frames, so that huge CFGs cannot overflow the stack
+ */
+void WtoScheduler::Private::computeOrder(const Block *entry, TOrder &dst)
+{
+    static const unsigned DONE = static_cast<unsigned>(-1);
+
+    // frames are only pushed to or popped from the back of the deque, which
+    // keeps the references to the remaining ones (and their bodies) valid
+    std::deque<WtoFrame> frames;
+    frames.push_back(WtoFrame(entry, &dst));
+    bool enter = true;
+
+    // head of the block whose visit() has just returned (if not enter)
+    unsigned headRet = 0;
+    bool returned = false;
+
+    while (!frames.empty()) {
+        WtoFrame &f = frames.back();
+        const Block *bb = f.bb;
+        const TTargetList &succs = bb->targets();
+
+        if (enter) {
+            // entering visit() of bb
+            enter = false;
+            this->stack.push(bb);
+            f.head = this->dfn[bb] = ++this->num;
+        }
+
+        if (returned) {
+            returned = false;
+            if (WtoFrame::WF_VISIT == f.kind && headRet <= f.head) {
+                f.head = headRet;
+                f.loop = true;
+            }
+        }
+
+        bool descend = false;
+        while (!descend && f.idxSucc < succs.size()) {
+            const Block *succ = succs[f.idxSucc++];
+            const unsigned min = this->dfn[succ];
+            if (!min) {
+                // call visit() on succ
+                frames.push_back(WtoFrame(succ, (WtoFrame::WF_VISIT == f.kind)
+                            ? f.partition
+                            : &f.body));
+                enter = true;
+                descend = true;
+            }
+            else if (WtoFrame::WF_VISIT == f.kind && min <= f.head) {
+                f.head = min;
+                f.loop = true;
+            }
+        }
+
+        if (descend)
+            continue;
+
+        if (WtoFrame::WF_COMPONENT == f.kind) {
+            // component() of bb is complete
+            f.body.push_front(bb);
+            f.partition->splice(f.partition->begin(), f.body);
+            headRet = f.head;
+            returned = true;
+            frames.pop_back();
+            continue;
+        }
+
+        if (f.head != this->dfn[bb]) {
+            // bb is inside of a loop headed by a block on the stack
+            headRet = f.head;
+            returned = true;
+            frames.pop_back();
+            continue;
+        }
+
+        this->dfn[bb] = DONE;
+        const Block *top = this->stack.top();
+        this->stack.pop();
+
+        if (!f.loop) {
+            f.partition->push_front(bb);
+            headRet = f.head;
+            returned = true;
+            frames.pop_back();
+            continue;
+        }
+
+        // bb is the entry of a loop, order the rest of the loop once again
+        while (top != bb) {
+            this->dfn[top] = 0;
+            top = this->stack.top();
+            this->stack.pop();
+        }
+
+        // continue by component() of bb in the same frame
+        f.kind = WtoFrame::WF_COMPONENT;
+        f.idxSucc = 0;
+    }
+}
+
+WtoScheduler::WtoScheduler(const ControlFlow &cfg):
+    d(new Private)
+{
+    Private::TOrder order;
+    if (cfg.size())
+        d->computeOrder(cfg.entry(), order);
+
+    // the blocks not reachable from entry go last
+    d->byIndex.assign(order.begin(), order.end());
+    BOOST_FOREACH(const Block *bb, cfg)
+        if (!hasKey(d->dfn, bb))
+            d->byIndex.push_back(bb);
+
+    d->dfn.clear();
+    for (unsigned idx = 0; idx < d->byIndex.size(); ++idx)
+        d->index[d->byIndex[idx]] = idx;
+
+    d->visited.resize(d->byIndex.size(), false);
+}
+
+WtoScheduler::~WtoScheduler()
+{
+    delete d;
+}
+
+bool WtoScheduler::schedule(const Block *bb)
+{
+    return d->todo.insert(this->indexOf(bb)).second;
+}
+
+bool WtoScheduler::next(const Block *&dst)
+{
+    if (d->todo.empty())
+        return false;
+
+    const unsigned idx = *d->todo.begin();
+    d->todo.erase(d->todo.begin());
+    dst = d->byIndex[idx];
+
+    ++d->cntVisits;
+    if (!d->visited[idx]) {
+        d->visited[idx] = true;
+        ++d->cntBlocksVisited;
+    }
+
+    return true;
+}
+
+bool WtoScheduler::empty() const
+{
+    return d->todo.empty();
+}
+
+unsigned WtoScheduler::indexOf(const Block *bb) const
+{
+    const Private::TIndex::const_iterator it = d->index.find(bb);
+    CL_BREAK_IF(d->index.end() == it);
+    return it->second;
+}
+
+unsigned WtoScheduler::cntVisits() const
+{
+    return d->cntVisits;
+}
+
+unsigned WtoScheduler::cntBlocksVisited() const
+{
+    return d->cntBlocksVisited;
+}
+
+
 // /////////////////////////////////////////////////////////////////////////////
 // PointsTo implementation
 
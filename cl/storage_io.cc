@@ -0,0 +1,1537 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config_cl.h"
+#include "storage_io.hh"
+
+#include <cl/cl_msg.hh>
+#include <cl/storage.hh>
+
+#include "cl_storage.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/foreach.hpp>
+
+namespace CodeStorage {
+
+// /////////////////////////////////////////////////////////////////////////////
+// layout of the image
+//
+// The image starts with Header, which is followed by the sections listed in
+// ESection.  The sections of cl_* objects are arrays of the structures as they
+// are laid out in memory, pointers inside of them are stored as (index + 1)
+// into the section of the pointed objects (strings use byte offsets), zero
+// stands for NULL.  The loader only rewrites the pointers in place.  The rest
+// of the storage is described by a stream of 32-bit words (SEC_RECORDS).
+// ImageWriter refuses to write a storage whose indices do not fit into them.
+namespace {
+    typedef uint32_t TWord;
+
+    enum ESection {
+        SEC_STRINGS,
+        SEC_TYPES,
+        SEC_TYPE_ITEMS,
+        SEC_VARS,
+        SEC_ACCESSORS,
+        SEC_OPERANDS,
+        SEC_RECORDS,
+        SEC_TOTAL
+    };
+
+    struct Section {
+        uint64_t                    offset;
+        uint64_t                    count;
+    };
+
+    struct Header {
+        char                        magic[8];
+        TWord                       version;
+        TWord                       sizeofPtr;
+        TWord                       sizeofType;
+        TWord                       sizeofTypeItem;
+        TWord                       sizeofVar;
+        TWord                       sizeofAccessor;
+        TWord                       sizeofOperand;
+        TWord                       sizeofLong;
+        Section                     sections[SEC_TOTAL];
+    };
+
+    const char imageMagic[8] = "CLSTOR";
+
+    /// bump this whenever the layout of the image changes
+    const TWord imageVersion = 2;
+
+    const size_t sectionAlign = 16;
+
+    /// the header that the image needs to match on this host
+    void initHeader(Header &hdr)
+    {
+        memset(&hdr, 0, sizeof hdr);
+        memcpy(hdr.magic, imageMagic, sizeof hdr.magic);
+        hdr.version         = imageVersion;
+        hdr.sizeofPtr       = sizeof(void *);
+        hdr.sizeofType      = sizeof(struct cl_type);
+        hdr.sizeofTypeItem  = sizeof(struct cl_type_item);
+        hdr.sizeofVar       = sizeof(struct cl_var);
+        hdr.sizeofAccessor  = sizeof(struct cl_accessor);
+        hdr.sizeofOperand   = sizeof(struct cl_operand);
+        hdr.sizeofLong      = sizeof(long);
+    }
+
+    template <class T>
+    T* asRef(size_t ref)
+    {
+        return reinterpret_cast<T *>(static_cast<uintptr_t>(ref));
+    }
+
+    inline size_t alignUp(size_t off)
+    {
+        return (off + sectionAlign - 1) / sectionAlign * sectionAlign;
+    }
+}
+
+
+// /////////////////////////////////////////////////////////////////////////////
+// ImageWriter
+namespace {
+
+typedef std::map<const Block *, TWord>                  TBlockIdx;
+
+class ImageWriter {
+    public:
+        ImageWriter():
+            overflow_(false)
+        {
+        }
+
+        void writeStorage(const Storage &);
+        bool flush(const char *fileName) const;
+
+    private:
+        size_t strRef(const char *);
+        size_t typeRef(const struct cl_type *);
+        size_t varRef(const struct cl_var *);
+        size_t accessorRef(const struct cl_accessor *);
+        size_t operandRef(const struct cl_operand &);
+        void storeOperand(size_t idx, const struct cl_operand &);
+        struct cl_loc encodeLoc(const struct cl_loc &);
+
+        void push(TWord w) { records_.push_back(w); }
+        void pushIdx(size_t);
+        void pushLoc(const struct cl_loc &);
+        void pushInsn(const Insn &, const TBlockIdx &);
+        void pushVar(const Var &);
+        void pushFnc(const Fnc &);
+        void pushNames(const NameDb &);
+
+    private:
+        typedef std::map<std::string, size_t>           TStrMap;
+        typedef std::map<const struct cl_type *, size_t> TTypeMap;
+        typedef std::map<const struct cl_var *, size_t> TVarMap;
+
+        TStrMap                             strMap_;
+        std::string                         strings_;
+        TTypeMap                            typeMap_;
+        std::vector<struct cl_type>         types_;
+        std::vector<struct cl_type_item>    items_;
+        TVarMap                             varMap_;
+        std::vector<struct cl_var>          vars_;
+        std::vector<struct cl_accessor>     accessors_;
+        std::vector<struct cl_operand>      operands_;
+        std::vector<TWord>                  records_;
+        bool                                overflow_;  ///< TWord too small
+};
+
+/// push an index, an offset, or a count, none of them can exceed a TWord
+void ImageWriter::pushIdx(size_t idx)
+{
+    if (static_cast<TWord>(idx) != idx)
+        overflow_ = true;
+
+    records_.push_back(idx);
+}
+
+size_t ImageWriter::strRef(const char *str)
+{
+    if (!str)
+        return 0;
+
+    TStrMap::const_iterator it = strMap_.find(str);
+    if (strMap_.end() != it)
+        return it->second;
+
+    const size_t ref = strings_.size() + 1;
+    strings_.append(str);
+    strings_.push_back('\0');
+    strMap_[str] = ref;
+    return ref;
+}
+
+struct cl_loc ImageWriter::encodeLoc(const struct cl_loc &src)
+{
+    struct cl_loc dst;
+    memset(&dst, 0, sizeof dst);
+    dst.file    = asRef<const char>(this->strRef(src.file));
+    dst.line    = src.line;
+    dst.column  = src.column;
+    dst.sysp    = src.sysp;
+    return dst;
+}
+
+size_t ImageWriter::typeRef(const struct cl_type *clt)
+{
+    if (!clt)
+        return 0;
+
+    TTypeMap::const_iterator it = typeMap_.find(clt);
+    if (typeMap_.end() != it)
+        return it->second + 1;
+
+    // reserve the slot first, the type graph may be cyclic
+    const size_t idx = types_.size();
+    typeMap_[clt] = idx;
+    types_.push_back(cl_type());
+
+    const size_t cnt = clt->item_cnt;
+    const size_t first = items_.size();
+    items_.resize(first + cnt);
+    for (size_t i = 0; i < cnt; ++i) {
+        const struct cl_type_item &src = clt->items[i];
+        struct cl_type_item item;
+        memset(&item, 0, sizeof item);
+        item.type   = asRef<const struct cl_type>(this->typeRef(src.type));
+        item.name   = asRef<const char>(this->strRef(src.name));
+        item.offset = src.offset;
+        items_[first + i] = item;
+    }
+
+    struct cl_type dst;
+    memset(&dst, 0, sizeof dst);
+    dst.uid         = clt->uid;
+    dst.code        = clt->code;
+    dst.loc         = this->encodeLoc(clt->loc);
+    dst.scope       = clt->scope;
+    dst.name        = asRef<const char>(this->strRef(clt->name));
+    dst.size        = clt->size;
+    dst.item_cnt    = clt->item_cnt;
+    dst.items       = (cnt) ? asRef<struct cl_type_item>(first + 1) : 0;
+    dst.array_size  = clt->array_size;
+    dst.is_unsigned = clt->is_unsigned;
+    dst.is_const    = clt->is_const;
+    dst.ptr_type    = clt->ptr_type;
+    types_[idx] = dst;
+
+    return idx + 1;
+}
+
+size_t ImageWriter::varRef(const struct cl_var *clv)
+{
+    if (!clv)
+        return 0;
+
+    TVarMap::const_iterator it = varMap_.find(clv);
+    if (varMap_.end() != it)
+        return it->second + 1;
+
+    // initializers are kept by CodeStorage::Var, we do not need them here
+    struct cl_var dst;
+    memset(&dst, 0, sizeof dst);
+    dst.uid         = clv->uid;
+    dst.name        = asRef<const char>(this->strRef(clv->name));
+    dst.artificial  = clv->artificial;
+    dst.loc         = this->encodeLoc(clv->loc);
+    dst.initial     = 0;
+    dst.initialized = clv->initialized;
+    dst.is_extern   = clv->is_extern;
+
+    const size_t idx = vars_.size();
+    varMap_[clv] = idx;
+    vars_.push_back(dst);
+    return idx + 1;
+}
+
+size_t ImageWriter::accessorRef(const struct cl_accessor *ac)
+{
+    if (!ac)
+        return 0;
+
+    // a chain of accessors is stored as a continuous sequence
+    size_t cnt = 0;
+    for (const struct cl_accessor *it = ac; it; it = it->next)
+        ++cnt;
+
+    const size_t first = accessors_.size();
+    accessors_.resize(first + cnt);
+
+    for (size_t i = 0; ac; ac = ac->next, ++i) {
+        struct cl_accessor dst;
+        memset(&dst, 0, sizeof dst);
+        dst.code = ac->code;
+        dst.type = asRef<struct cl_type>(this->typeRef(ac->type));
+        dst.next = (ac->next)
+            ? asRef<struct cl_accessor>(first + i + /* next */ 1 + 1)
+            : 0;
+
+        switch (ac->code) {
+            case CL_ACCESSOR_DEREF_ARRAY:
+                dst.data.array.index = asRef<struct cl_operand>(
+                        this->operandRef(*ac->data.array.index));
+                break;
+
+            case CL_ACCESSOR_ITEM:
+                dst.data.item.id = ac->data.item.id;
+                break;
+
+            case CL_ACCESSOR_OFFSET:
+                dst.data.offset.off = ac->data.offset.off;
+                break;
+
+            case CL_ACCESSOR_REF:
+            case CL_ACCESSOR_DEREF:
+                break;
+        }
+
+        accessors_[first + i] = dst;
+    }
+
+    return first + 1;
+}
+
+size_t ImageWriter::operandRef(const struct cl_operand &op)
+{
+    const size_t idx = operands_.size();
+    operands_.push_back(cl_operand());
+    this->storeOperand(idx, op);
+    return idx + 1;
+}
+
+void ImageWriter::storeOperand(size_t idx, const struct cl_operand &src)
+{
+    struct cl_operand dst;
+    memset(&dst, 0, sizeof dst);
+    dst.code    = src.code;
+    dst.scope   = src.scope;
+    dst.type    = asRef<struct cl_type>(this->typeRef(src.type));
+
+    const enum cl_operand_e code = src.code;
+    switch (code) {
+        case CL_OPERAND_VOID:
+            // accessors of void operands are not owned by the storage
+            break;
+
+        case CL_OPERAND_VAR:
+            dst.accessor = asRef<struct cl_accessor>(
+                    this->accessorRef(src.accessor));
+            dst.data.var = asRef<struct cl_var>(this->varRef(src.data.var));
+            break;
+
+        case CL_OPERAND_CST: {
+            dst.accessor = asRef<struct cl_accessor>(
+                    this->accessorRef(src.accessor));
+
+            const struct cl_cst &cst = src.data.cst;
+            struct cl_cst &cstDst = dst.data.cst;
+            cstDst.code = cst.code;
+            switch (cst.code) {
+                case CL_TYPE_FNC:
+                    cstDst.data.cst_fnc.uid = cst.data.cst_fnc.uid;
+                    cstDst.data.cst_fnc.name = asRef<const char>(
+                            this->strRef(cst.data.cst_fnc.name));
+                    cstDst.data.cst_fnc.is_extern = cst.data.cst_fnc.is_extern;
+                    cstDst.data.cst_fnc.loc =
+                        this->encodeLoc(cst.data.cst_fnc.loc);
+                    break;
+
+                case CL_TYPE_STRING:
+                    cstDst.data.cst_string.value = asRef<const char>(
+                            this->strRef(cst.data.cst_string.value));
+                    break;
+
+                case CL_TYPE_REAL:
+                    cstDst.data.cst_real.value = cst.data.cst_real.value;
+                    break;
+
+                default:
+                    // cst_uint shares the storage with cst_int
+                    cstDst.data.cst_int.value = cst.data.cst_int.value;
+                    break;
+            }
+            break;
+        }
+    }
+
+    operands_[idx] = dst;
+}
+
+void ImageWriter::pushLoc(const struct cl_loc &loc)
+{
+    this->pushIdx(this->strRef(loc.file));
+    this->push(loc.line);
+    this->push(loc.column);
+    this->push(loc.sysp);
+}
+
+void ImageWriter::pushInsn(const Insn &insn, const TBlockIdx &bbIdx)
+{
+    const enum cl_insn_e code = insn.code;
+    this->push(code);
+    this->push((CL_INSN_UNOP == code || CL_INSN_BINOP == code)
+            ? insn.subCode
+            : 0);
+    this->pushLoc(insn.loc);
+
+    // operands of an insn are stored as a continuous sequence
+    const size_t cntOps = insn.operands.size();
+    const size_t first = operands_.size();
+    operands_.resize(first + cntOps);
+    for (size_t i = 0; i < cntOps; ++i)
+        this->storeOperand(first + i, insn.operands[i]);
+
+    this->pushIdx(cntOps);
+    this->pushIdx(first);
+
+    this->pushIdx(insn.targets.size());
+    BOOST_FOREACH(const Block *bb, insn.targets) {
+        TBlockIdx::const_iterator it = bbIdx.find(bb);
+        this->push((bbIdx.end() == it)
+                ? 0
+                : it->second + 1);
+    }
+}
+
+void ImageWriter::pushVar(const Var &var)
+{
+    this->push(var.code);
+    this->push(var.uid);
+    this->pushIdx(this->typeRef(var.type));
+    this->pushLoc(var.loc);
+    this->pushIdx(this->strRef(var.name.c_str()));
+    this->push(var.initialized);
+    this->push(var.isExtern);
+    this->push(var.mayBePointed);
+
+    const TBlockIdx noBlocks;
+    this->pushIdx(var.initials.size());
+    BOOST_FOREACH(const Insn *insn, var.initials)
+        this->pushInsn(*insn, noBlocks);
+}
+
+void ImageWriter::pushFnc(const Fnc &fnc)
+{
+    this->push(uidOf(fnc));
+    this->pushIdx(this->operandRef(fnc.def));
+
+    this->pushIdx(fnc.vars.size());
+    BOOST_FOREACH(const int uid, fnc.vars)
+        this->push(uid);
+
+    this->pushIdx(fnc.args.size());
+    BOOST_FOREACH(const int uid, fnc.args)
+        this->push(uid);
+
+    // names of blocks go first so that targets can be resolved by index
+    const ControlFlow &cfg = fnc.cfg;
+    TBlockIdx bbIdx;
+    this->pushIdx(cfg.size());
+    BOOST_FOREACH(const Block *bb, cfg) {
+        const TWord idx = bbIdx.size();
+        bbIdx[bb] = idx;
+        this->pushIdx(this->strRef(bb->name().c_str()));
+    }
+
+    BOOST_FOREACH(const Block *bb, cfg) {
+        this->pushIdx(bb->inbound().size());
+        BOOST_FOREACH(const Block *pred, bb->inbound())
+            this->push(bbIdx[pred]);
+
+        this->pushIdx(bb->size());
+        BOOST_FOREACH(const Insn *insn, *bb)
+            this->pushInsn(*insn, bbIdx);
+    }
+}
+
+void ImageWriter::pushNames(const NameDb &db)
+{
+    typedef NameDb::TNameMap::const_reference TNameRef;
+    typedef NameDb::TFileMap::const_reference TFileRef;
+
+    this->pushIdx(db.glNames.size());
+    BOOST_FOREACH(TNameRef item, db.glNames) {
+        this->pushIdx(this->strRef(item.first.c_str()));
+        this->push(item.second);
+    }
+
+    this->pushIdx(db.lcNames.size());
+    BOOST_FOREACH(TFileRef file, db.lcNames) {
+        this->pushIdx(this->strRef(file.first.c_str()));
+        this->pushIdx(file.second.size());
+        BOOST_FOREACH(TNameRef item, file.second) {
+            this->pushIdx(this->strRef(item.first.c_str()));
+            this->push(item.second);
+        }
+    }
+}
+
+void ImageWriter::writeStorage(const Storage &stor)
+{
+    // names go first, the linker needs them before the rest is read
+    this->pushNames(stor.varNames);
+    this->pushNames(stor.fncNames);
+
+    this->pushIdx(stor.types.size());
+    BOOST_FOREACH(const struct cl_type *clt, stor.types)
+        this->pushIdx(this->typeRef(clt));
+
+    this->pushIdx(stor.vars.size());
+    BOOST_FOREACH(const Var &var, stor.vars)
+        this->pushVar(var);
+
+    this->pushIdx(stor.fncs.size());
+    BOOST_FOREACH(const Fnc *fnc, stor.fncs)
+        this->pushFnc(*fnc);
+}
+
+template <class TVec>
+void describeSection(Section &sec, size_t &off, const TVec &vec)
+{
+    sec.offset = off = alignUp(off);
+    sec.count = vec.size();
+    off += vec.size() * sizeof(typename TVec::value_type);
+}
+
+template <class TVec>
+bool writeSection(FILE *file, size_t &pos, const Section &sec, const TVec &vec)
+{
+    static const char zeros[sectionAlign] = { 0 };
+    const size_t pad = sec.offset - pos;
+    if (pad && 1 != fwrite(zeros, pad, 1, file))
+        return false;
+
+    const size_t size = vec.size() * sizeof(typename TVec::value_type);
+    if (size && 1 != fwrite(&vec[0], size, 1, file))
+        return false;
+
+    pos = sec.offset + size;
+    return true;
+}
+
+bool ImageWriter::flush(const char *fileName) const
+{
+    if (overflow_) {
+        // records refer to the other sections by 32-bit indices and offsets
+        CL_ERROR("failed to write '" << fileName
+                << "': the storage is too big to fit into an image");
+        return false;
+    }
+
+    Header hdr;
+    initHeader(hdr);
+
+    size_t off = sizeof hdr;
+    Section *sec = hdr.sections;
+    describeSection(sec[SEC_STRINGS],       off, strings_);
+    describeSection(sec[SEC_TYPES],         off, types_);
+    describeSection(sec[SEC_TYPE_ITEMS],    off, items_);
+    describeSection(sec[SEC_VARS],          off, vars_);
+    describeSection(sec[SEC_ACCESSORS],     off, accessors_);
+    describeSection(sec[SEC_OPERANDS],      off, operands_);
+    describeSection(sec[SEC_RECORDS],       off, records_);
+
+    FILE *file = fopen(fileName, "wb");
+    if (!file) {
+        CL_ERROR("failed to open '" << fileName << "' for writing: "
+                << strerror(errno));
+        return false;
+    }
+
+    size_t pos = sizeof hdr;
+    bool ok = (1 == fwrite(&hdr, sizeof hdr, 1, file))
+        && writeSection(file, pos, sec[SEC_STRINGS],    strings_)
+        && writeSection(file, pos, sec[SEC_TYPES],      types_)
+        && writeSection(file, pos, sec[SEC_TYPE_ITEMS], items_)
+        && writeSection(file, pos, sec[SEC_VARS],       vars_)
+        && writeSection(file, pos, sec[SEC_ACCESSORS],  accessors_)
+        && writeSection(file, pos, sec[SEC_OPERANDS],   operands_)
+        && writeSection(file, pos, sec[SEC_RECORDS],    records_);
+
+    if (fclose(file))
+        ok = false;
+
+    if (!ok)
+        CL_ERROR("failed to write '" << fileName << "'");
+
+    return ok;
+}
+
+} // namespace
+
+bool writeStorage(const Storage &stor, const char *fileName)
+{
+    ImageWriter writer;
+    writer.writeStorage(stor);
+    return writer.flush(fileName);
+}
+
+
+// /////////////////////////////////////////////////////////////////////////////
+// ImageFile - a single mapped image
+namespace {
+
+typedef std::map<int, int>                              TUidMap;
+
+/// classes of types that have the same structure, keyed by their description
+typedef std::map<std::string, int>                      TClassMap;
+
+/// return the class of the given description, classes are numbered from 1
+int classOf(TClassMap &classes, const std::string &key)
+{
+    const int cls = classes.size() + 1;
+    return classes.insert(TClassMap::value_type(key, cls)).first->second;
+}
+
+/// uids of a storage linked from several images
+struct UidSpace {
+    typedef std::map<std::string, int>                  TKeyMap;
+
+    int                                 last;
+    TUidMap                             typeByClass;
+    TKeyMap                             varByName;
+    TKeyMap                             fncByName;
+
+    UidSpace():
+        last(0)
+    {
+    }
+
+    int fresh() {
+        return ++last;
+    }
+
+    template <class TDb>
+    int lookup(TDb &db, const typename TDb::key_type &key) {
+        typename TDb::const_iterator it = db.find(key);
+        if (db.end() != it)
+            return it->second;
+
+        const int uid = this->fresh();
+        db[key] = uid;
+        return uid;
+    }
+};
+
+class ImageFile {
+    public:
+        ImageFile(const std::string &fileName, bool link);
+        ~ImageFile();
+
+        const std::string& fileName() const { return fileName_;  }
+        const std::string& error()    const { return error_;     }
+        bool ok()                     const { return error_.empty(); }
+
+        // steps of loading, prepare() and rewriteUids() may run in parallel
+        void prepare();
+        void splitTypeClasses(TClassMap &);
+        void assignUids(UidSpace &);
+        void rewriteUids();
+        void materialize(Storage &);
+
+    private:
+        /// @b not allowed to be copied
+        ImageFile(const ImageFile &);
+
+        /// @b not allowed to be copied
+        ImageFile& operator=(const ImageFile &);
+
+        void fail(const std::string &msg);
+        bool mapFile();
+        bool readHeader();
+        void fixPointers();
+        void digTypeKeys();
+
+        template <class T> void section(T *&dst, size_t &cnt, ESection);
+        template <class T> void fix(T *&ptr, T *tab, size_t cnt);
+        void fixStr(const char *&str);
+        void fixLoc(struct cl_loc &loc);
+        void fixOperand(struct cl_operand &op);
+        const struct cl_type* typeAt(size_t ref);
+        std::string keyOf(const struct cl_type *clt);
+
+        int remap(TUidMap &uids, int uid);
+        TWord next();
+        const char* nextStr();
+        void readLoc(struct cl_loc &loc);
+        Insn* readInsn(const std::vector<Block *> &bbs);
+        void readVar();
+        void readFnc();
+        void readBlocks(Fnc *fnc, size_t cntBlocks);
+        void readNames(NameDb &);
+        void storeNames(NameDb &dst, const NameDb &src, TUidMap &uids);
+
+    private:
+        const std::string               fileName_;
+        const bool                      link_;
+        std::string                     error_;
+        char                            *base_;
+        size_t                          size_;
+
+        const char                      *strings_;
+        size_t                          cntStrings_;
+        struct cl_type                  *types_;
+        size_t                          cntTypes_;
+        struct cl_type_item             *items_;
+        size_t                          cntItems_;
+        struct cl_var                   *vars_;
+        size_t                          cntVars_;
+        struct cl_accessor              *accessors_;
+        size_t                          cntAccessors_;
+        struct cl_operand               *operands_;
+        size_t                          cntOperands_;
+        const TWord                     *rec_;
+        const TWord                     *recEnd_;
+
+        NameDb                          varNames_;
+        NameDb                          fncNames_;
+
+        // used only while linking
+        std::vector<std::string>        typeKeys_;
+        std::vector<int>                typeClasses_;
+        std::vector<int>                typeUids_;
+        std::set<int>                   fncUidsUsed_;
+        TUidMap                         varUids_;
+        TUidMap                         fncUids_;
+        UidSpace                        *space_;
+        Storage                         *stor_;
+};
+
+ImageFile::ImageFile(const std::string &fileName, bool link):
+    fileName_(fileName),
+    link_(link),
+    base_(0),
+    size_(0),
+    space_(0),
+    stor_(0)
+{
+}
+
+ImageFile::~ImageFile()
+{
+    if (base_)
+        munmap(base_, size_);
+}
+
+void ImageFile::fail(const std::string &msg)
+{
+    if (error_.empty())
+        error_ = msg;
+}
+
+bool ImageFile::mapFile()
+{
+    const char *fileName = fileName_.c_str();
+    const int fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        this->fail("failed to open '" + fileName_ + "': " + strerror(errno));
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st)) {
+        this->fail("fstat() failed on '" + fileName_ + "'");
+        close(fd);
+        return false;
+    }
+
+    size_ = st.st_size;
+    if (size_ < sizeof(Header)) {
+        this->fail("'" + fileName_ + "' is not a CodeStorage image");
+        close(fd);
+        return false;
+    }
+
+    // a private writable mapping lets us fix the pointers up in place
+    void *addr = mmap(0, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == addr) {
+        this->fail("failed to mmap '" + fileName_ + "': " + strerror(errno));
+        return false;
+    }
+
+    base_ = static_cast<char *>(addr);
+    return true;
+}
+
+template <class T>
+void ImageFile::section(T *&dst, size_t &cnt, ESection id)
+{
+    const Section &sec = reinterpret_cast<const Header *>(base_)->sections[id];
+    cnt = sec.count;
+    dst = reinterpret_cast<T *>(base_ + sec.offset);
+    if (sec.offset % sectionAlign
+            || sec.offset > size_
+            || sec.count > (size_ - sec.offset) / sizeof(T))
+        this->fail("CodeStorage image '" + fileName_ + "' is corrupted");
+}
+
+bool ImageFile::readHeader()
+{
+    Header expected;
+    initHeader(expected);
+
+    const Header *hdr = reinterpret_cast<const Header *>(base_);
+    if (memcmp(hdr->magic, expected.magic, sizeof hdr->magic)) {
+        this->fail("'" + fileName_ + "' is not a CodeStorage image");
+        return false;
+    }
+
+    if (memcmp(hdr, &expected, offsetof(Header, sections))) {
+        this->fail("CodeStorage image '" + fileName_
+                + "' was written by an incompatible build");
+        return false;
+    }
+
+    this->section(strings_,     cntStrings_,    SEC_STRINGS);
+    this->section(types_,       cntTypes_,      SEC_TYPES);
+    this->section(items_,       cntItems_,      SEC_TYPE_ITEMS);
+    this->section(vars_,        cntVars_,       SEC_VARS);
+    this->section(accessors_,   cntAccessors_,  SEC_ACCESSORS);
+    this->section(operands_,    cntOperands_,   SEC_OPERANDS);
+
+    const TWord *words;
+    size_t cntWords;
+    this->section(words,        cntWords,       SEC_RECORDS);
+    rec_ = words;
+    recEnd_ = words + cntWords;
+
+    // all strings need to be terminated within the section
+    if (cntStrings_ && strings_[cntStrings_ - 1])
+        this->fail("CodeStorage image '" + fileName_ + "' is corrupted");
+
+    return this->ok();
+}
+
+template <class T>
+void ImageFile::fix(T *&ptr, T *tab, size_t cnt)
+{
+    const uintptr_t ref = reinterpret_cast<uintptr_t>(ptr);
+    if (!ref)
+        return;
+
+    if (cnt < ref) {
+        this->fail("CodeStorage image '" + fileName_ + "' is corrupted");
+        ptr = 0;
+        return;
+    }
+
+    ptr = tab + ref - 1;
+}
+
+void ImageFile::fixStr(const char *&str)
+{
+    this->fix(str, strings_, cntStrings_);
+}
+
+void ImageFile::fixLoc(struct cl_loc &loc)
+{
+    this->fixStr(loc.file);
+}
+
+void ImageFile::fixOperand(struct cl_operand &op)
+{
+    this->fix(op.type, types_, cntTypes_);
+    this->fix(op.accessor, accessors_, cntAccessors_);
+
+    const enum cl_operand_e code = op.code;
+    switch (code) {
+        case CL_OPERAND_VOID:
+            break;
+
+        case CL_OPERAND_VAR:
+            this->fix(op.data.var, vars_, cntVars_);
+            break;
+
+        case CL_OPERAND_CST: {
+            struct cl_cst &cst = op.data.cst;
+            if (CL_TYPE_FNC == cst.code) {
+                this->fixStr(cst.data.cst_fnc.name);
+                this->fixLoc(cst.data.cst_fnc.loc);
+            }
+            else if (CL_TYPE_STRING == cst.code)
+                this->fixStr(cst.data.cst_string.value);
+            break;
+        }
+    }
+}
+
+const struct cl_type* ImageFile::typeAt(size_t ref)
+{
+    const struct cl_type *clt = asRef<const struct cl_type>(ref);
+    const struct cl_type *tab = types_;
+    this->fix(clt, tab, cntTypes_);
+    return clt;
+}
+
+void ImageFile::fixPointers()
+{
+    for (size_t i = 0; i < cntTypes_; ++i) {
+        struct cl_type &clt = types_[i];
+        this->fixLoc(clt.loc);
+        this->fixStr(clt.name);
+        this->fix(clt.items, items_, cntItems_);
+        if (clt.item_cnt < 0 || (clt.item_cnt && (!clt.items
+                        || cntItems_ < static_cast<size_t>(clt.items - items_)
+                                       + clt.item_cnt)))
+            this->fail("CodeStorage image '" + fileName_ + "' is corrupted");
+    }
+
+    const struct cl_type *constTypes = types_;
+    for (size_t i = 0; i < cntItems_; ++i) {
+        struct cl_type_item &item = items_[i];
+        this->fix(item.type, constTypes, cntTypes_);
+        this->fixStr(item.name);
+    }
+
+    for (size_t i = 0; i < cntVars_; ++i) {
+        struct cl_var &clv = vars_[i];
+        this->fixStr(clv.name);
+        this->fixLoc(clv.loc);
+    }
+
+    for (size_t i = 0; i < cntAccessors_; ++i) {
+        struct cl_accessor &ac = accessors_[i];
+        this->fix(ac.type, types_, cntTypes_);
+        this->fix(ac.next, accessors_, cntAccessors_);
+        if (CL_ACCESSOR_DEREF_ARRAY == ac.code)
+            this->fix(ac.data.array.index, operands_, cntOperands_);
+    }
+
+    for (size_t i = 0; i < cntOperands_; ++i)
+        this->fixOperand(operands_[i]);
+}
+
+/**
+ * key of a type that does not depend on uids, the types of items are left
+ * out here, splitTypeClasses() takes them into account
+ */
+std::string ImageFile::keyOf(const struct cl_type *clt)
+{
+    std::ostringstream str;
+    str << clt->code << ':' << clt->size << ':' << clt->array_size
+        << ':' << clt->is_unsigned << clt->is_const
+        << ':' << ((clt->name) ? clt->name : "") << '{';
+
+    for (int i = 0; i < clt->item_cnt; ++i) {
+        const struct cl_type_item &item = clt->items[i];
+        str << ((item.name) ? item.name : "") << '@' << item.offset << ';';
+    }
+
+    str << '}';
+    return str.str();
+}
+
+void ImageFile::digTypeKeys()
+{
+    typeKeys_.reserve(cntTypes_);
+    for (size_t i = 0; i < cntTypes_; ++i)
+        typeKeys_.push_back(this->keyOf(types_ + i));
+
+    for (size_t i = 0; i < cntOperands_; ++i) {
+        const struct cl_operand &op = operands_[i];
+        if (CL_OPERAND_CST == op.code && CL_TYPE_FNC == op.data.cst.code)
+            fncUidsUsed_.insert(op.data.cst.data.cst_fnc.uid);
+    }
+}
+
+void ImageFile::prepare()
+{
+    if (!this->mapFile() || !this->readHeader())
+        return;
+
+    this->fixPointers();
+    if (!this->ok())
+        return;
+
+    this->readNames(varNames_);
+    this->readNames(fncNames_);
+
+    if (link_)
+        this->digTypeKeys();
+}
+
+/**
+ * the first call puts types with equal keys into the same class, each next
+ * call splits the classes by the classes of the types of items
+ * @param classes classes created by this round, shared by all the images
+ */
+void ImageFile::splitTypeClasses(TClassMap &classes)
+{
+    std::vector<int> next;
+    next.reserve(cntTypes_);
+    for (size_t i = 0; i < cntTypes_; ++i) {
+        if (typeClasses_.empty()) {
+            next.push_back(classOf(classes, typeKeys_[i]));
+            continue;
+        }
+
+        const struct cl_type &clt = types_[i];
+        std::ostringstream str;
+        str << typeClasses_[i] << '(';
+        for (int j = 0; j < clt.item_cnt; ++j) {
+            const struct cl_type *sub = clt.items[j].type;
+            str << ((sub) ? typeClasses_[sub - types_] : 0) << ',';
+        }
+
+        str << ')';
+        next.push_back(classOf(classes, str.str()));
+    }
+
+    typeClasses_.swap(next);
+}
+
+void ImageFile::assignUids(UidSpace &space)
+{
+    space_ = &space;
+
+    typeUids_.reserve(cntTypes_);
+    BOOST_FOREACH(const int cls, typeClasses_)
+        typeUids_.push_back(space.lookup(space.typeByClass, cls));
+
+    // global symbols are linked by name
+    typedef NameDb::TNameMap::const_reference TNameRef;
+    BOOST_FOREACH(TNameRef item, varNames_.glNames)
+        varUids_[item.second] = space.lookup(space.varByName, item.first);
+
+    BOOST_FOREACH(TNameRef item, fncNames_.glNames)
+        fncUids_[item.second] = space.lookup(space.fncByName, item.first);
+
+    // the other symbols are private to the translation unit
+    for (size_t i = 0; i < cntVars_; ++i)
+        this->remap(varUids_, vars_[i].uid);
+
+    BOOST_FOREACH(const int uid, fncUidsUsed_)
+        this->remap(fncUids_, uid);
+}
+
+void ImageFile::rewriteUids()
+{
+    for (size_t i = 0; i < cntTypes_; ++i)
+        types_[i].uid = typeUids_[i];
+
+    // all uids are already mapped, so remap() does not touch UidSpace here
+    for (size_t i = 0; i < cntVars_; ++i)
+        vars_[i].uid = varUids_[vars_[i].uid];
+
+    for (size_t i = 0; i < cntOperands_; ++i) {
+        struct cl_operand &op = operands_[i];
+        if (CL_OPERAND_CST != op.code || CL_TYPE_FNC != op.data.cst.code)
+            continue;
+
+        int &uid = op.data.cst.data.cst_fnc.uid;
+        uid = fncUids_[uid];
+    }
+}
+
+int ImageFile::remap(TUidMap &uids, int uid)
+{
+    if (!space_)
+        // loading a single image, uids are kept as they are
+        return uid;
+
+    TUidMap::const_iterator it = uids.find(uid);
+    if (uids.end() != it)
+        return it->second;
+
+    // e.g. an argument of a fnc that is not used in its body
+    const int fresh = space_->fresh();
+    uids[uid] = fresh;
+    return fresh;
+}
+
+TWord ImageFile::next()
+{
+    if (rec_ == recEnd_) {
+        this->fail("CodeStorage image '" + fileName_ + "' is truncated");
+        return 0;
+    }
+
+    return *rec_++;
+}
+
+const char* ImageFile::nextStr()
+{
+    const char *str = asRef<const char>(this->next());
+    this->fixStr(str);
+    return str;
+}
+
+void ImageFile::readLoc(struct cl_loc &loc)
+{
+    loc.file    = this->nextStr();
+    loc.line    = this->next();
+    loc.column  = this->next();
+    loc.sysp    = this->next();
+}
+
+Insn* ImageFile::readInsn(const std::vector<Block *> &bbs)
+{
+    Insn *insn = new Insn;
+    insn->stor      = stor_;
+    insn->bb        = 0;
+    insn->code      = static_cast<enum cl_insn_e>(this->next());
+    insn->subCode   = this->next();
+    this->readLoc(insn->loc);
+
+    const size_t cntOps = this->next();
+    const size_t first = this->next();
+    if (cntOperands_ < first || cntOperands_ - first < cntOps)
+        this->fail("CodeStorage image '" + fileName_ + "' is corrupted");
+    else
+        insn->operands.assign(operands_ + first, operands_ + first + cntOps);
+
+    const size_t cntTargets = this->next();
+    for (size_t i = 0; this->ok() && i < cntTargets; ++i) {
+        const size_t ref = this->next();
+        if (bbs.size() < ref) {
+            this->fail("CodeStorage image '" + fileName_ + "' is corrupted");
+            break;
+        }
+
+        insn->targets.push_back((ref) ? bbs[ref - 1] : 0);
+    }
+
+    insn->killPerTarget.resize(insn->targets.size());
+    return insn;
+}
+
+void ImageFile::readVar()
+{
+    Var var;
+    var.code = static_cast<EVar>(this->next());
+    var.uid = this->remap(varUids_, this->next());
+    var.type = this->typeAt(this->next());
+    this->readLoc(var.loc);
+
+    const char *name = this->nextStr();
+    if (name)
+        var.name = name;
+
+    var.initialized     = this->next();
+    var.isExtern        = this->next();
+    var.mayBePointed    = this->next();
+
+    // initializer instructions are not associated with any basic block
+    const std::vector<Block *> noBlocks;
+    const size_t cntInitials = this->next();
+    for (size_t i = 0; this->ok() && i < cntInitials; ++i)
+        var.initials.push_back(this->readInsn(noBlocks));
+
+    Var &dst = stor_->vars[var.uid];
+    if (VAR_VOID != dst.code) {
+        // a global variable already seen in another translation unit
+        const bool mayBePointed = dst.mayBePointed || var.mayBePointed;
+        if (dst.isExtern && !var.isExtern)
+            // prefer the definition over declarations
+            std::swap(dst, var);
+
+        dst.mayBePointed = mayBePointed;
+    }
+    else
+        std::swap(dst, var);
+
+    BOOST_FOREACH(const Insn *insn, var.initials)
+        delete insn;
+}
+
+void destroyBlocks(const ControlFlow &cfg)
+{
+    BOOST_FOREACH(const Block *bb, cfg) {
+        BOOST_FOREACH(const Insn *insn, *bb)
+            delete insn;
+
+        delete bb;
+    }
+}
+
+void ImageFile::readBlocks(Fnc *fnc, size_t cntBlocks)
+{
+    // create the blocks in the original order, the first one is the entry
+    std::vector<Block *> bbs;
+    for (size_t i = 0; this->ok() && i < cntBlocks; ++i) {
+        const char *name = this->nextStr();
+        if (!name) {
+            this->fail("CodeStorage image '" + fileName_ + "' is corrupted");
+            return;
+        }
+
+        bbs.push_back(fnc->cfg[name]);
+    }
+
+    BOOST_FOREACH(Block *bb, bbs) {
+        const size_t cntInbound = this->next();
+        for (size_t i = 0; this->ok() && i < cntInbound; ++i) {
+            const size_t idx = this->next();
+            if (bbs.size() <= idx) {
+                this->fail("CodeStorage image '" + fileName_
+                        + "' is corrupted");
+                return;
+            }
+
+            bb->appendPredecessor(bbs[idx]);
+        }
+
+        const size_t cntInsns = this->next();
+        for (size_t i = 0; this->ok() && i < cntInsns; ++i)
+            bb->append(this->readInsn(bbs));
+    }
+}
+
+void ImageFile::readFnc()
+{
+    const int uid = this->remap(fncUids_, this->next());
+    const size_t defRef = this->next();
+    if (!defRef || cntOperands_ < defRef) {
+        this->fail("CodeStorage image '" + fileName_ + "' is corrupted");
+        return;
+    }
+
+    TVarSet vars;
+    const size_t cntVars = this->next();
+    for (size_t i = 0; this->ok() && i < cntVars; ++i)
+        vars.insert(this->remap(varUids_, this->next()));
+
+    TArgByPos args;
+    const size_t cntArgs = this->next();
+    for (size_t i = 0; this->ok() && i < cntArgs; ++i)
+        args.push_back(this->remap(varUids_, this->next()));
+
+    Fnc *fnc = stor_->fncs[uid];
+    fnc->stor = stor_;
+
+    const size_t cntBlocks = this->next();
+    if (cntBlocks && fnc->cfg.size()) {
+        // a global fnc already defined in another translation unit
+        CL_WARN("CodeStorage image '" << fileName_ << "' defines "
+                << nameOf(*fnc) << "() once again, the definition is ignored");
+
+        Fnc scratch;
+        this->readBlocks(&scratch, cntBlocks);
+        destroyBlocks(scratch.cfg);
+        return;
+    }
+
+    // prefer the definition over declarations
+    if (cntBlocks || CL_OPERAND_VOID == fnc->def.code)
+        fnc->def = operands_[defRef - 1];
+
+    if (cntBlocks || fnc->args.empty())
+        fnc->args = args;
+
+    fnc->vars.insert(vars.begin(), vars.end());
+    this->readBlocks(fnc, cntBlocks);
+}
+
+void ImageFile::readNames(NameDb &db)
+{
+    const size_t cntGl = this->next();
+    for (size_t i = 0; this->ok() && i < cntGl; ++i) {
+        const char *name = this->nextStr();
+        const int uid = this->next();
+        if (name)
+            db.glNames[name] = uid;
+    }
+
+    const size_t cntFiles = this->next();
+    for (size_t i = 0; this->ok() && i < cntFiles; ++i) {
+        const char *file = this->nextStr();
+        const size_t cntNames = this->next();
+        if (!file) {
+            this->fail("CodeStorage image '" + fileName_ + "' is corrupted");
+            return;
+        }
+
+        NameDb::TNameMap &names = db.lcNames[file];
+        for (size_t j = 0; this->ok() && j < cntNames; ++j) {
+            const char *name = this->nextStr();
+            const int uid = this->next();
+            if (name)
+                names[name] = uid;
+        }
+    }
+}
+
+void ImageFile::storeNames(NameDb &dst, const NameDb &src, TUidMap &uids)
+{
+    typedef NameDb::TNameMap::const_reference TNameRef;
+    typedef NameDb::TFileMap::const_reference TFileRef;
+
+    BOOST_FOREACH(TNameRef item, src.glNames)
+        dst.glNames[item.first] = this->remap(uids, item.second);
+
+    BOOST_FOREACH(TFileRef file, src.lcNames) {
+        NameDb::TNameMap &names = dst.lcNames[file.first];
+        BOOST_FOREACH(TNameRef item, file.second)
+            names[item.first] = this->remap(uids, item.second);
+    }
+}
+
+void ImageFile::materialize(Storage &stor)
+{
+    stor_ = &stor;
+    this->storeNames(stor.varNames, varNames_, varUids_);
+    this->storeNames(stor.fncNames, fncNames_, fncUids_);
+
+    // types of the same uid are already unified, TypeDb keeps the first one
+    const size_t cntDbTypes = this->next();
+    for (size_t i = 0; this->ok() && i < cntDbTypes; ++i)
+        stor.types.insert(this->typeAt(this->next()));
+
+    const size_t cntDbVars = this->next();
+    for (size_t i = 0; this->ok() && i < cntDbVars; ++i)
+        this->readVar();
+
+    const size_t cntFncs = this->next();
+    for (size_t i = 0; this->ok() && i < cntFncs; ++i)
+        this->readFnc();
+
+    if (rec_ != recEnd_)
+        this->fail("CodeStorage image '" + fileName_ + "' is corrupted");
+}
+
+typedef std::vector<ImageFile *>                        TFileList;
+typedef void (ImageFile::*TStep)();
+
+void stepWorker(const TFileList *files, TStep step, std::atomic<size_t> *idx)
+{
+    size_t i;
+    while ((i = (*idx)++) < files->size())
+        ((*files)[i]->*step)();
+}
+
+/// run the given step on all images using at most @b jobs threads
+void runStep(const TFileList &files, TStep step, unsigned jobs)
+{
+    if (jobs < 2 || files.size() < 2) {
+        BOOST_FOREACH(ImageFile *file, files)
+            (file->*step)();
+        return;
+    }
+
+    if (files.size() < jobs)
+        jobs = files.size();
+
+    std::atomic<size_t> idx(0);
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < jobs; ++i)
+        threads.push_back(std::thread(stepWorker, &files, step, &idx));
+
+    BOOST_FOREACH(std::thread &t, threads)
+        t.join();
+}
+
+} // namespace
+
+
+// /////////////////////////////////////////////////////////////////////////////
+// StorageImage implementation
+struct StorageImage::Private {
+    Storage                         *stor;
+    TFileList                       files;
+
+    Private():
+        stor(0)
+    {
+    }
+
+    bool open(const std::vector<std::string> &fileNames, unsigned jobs,
+              bool link);
+    bool checkFiles() const;
+    void release();
+};
+
+bool StorageImage::Private::checkFiles() const
+{
+    bool ok = true;
+    BOOST_FOREACH(const ImageFile *file, files) {
+        if (file->ok())
+            continue;
+
+        CL_ERROR(file->error());
+        ok = false;
+    }
+
+    return ok;
+}
+
+bool StorageImage::Private::open(const std::vector<std::string> &fileNames,
+                                 unsigned jobs, bool link)
+{
+    CL_BREAK_IF(stor || !files.empty());
+    BOOST_FOREACH(const std::string &fileName, fileNames)
+        files.push_back(new ImageFile(fileName, link));
+
+    // map the images and fix the pointers up in parallel
+    runStep(files, &ImageFile::prepare, jobs);
+    if (!this->checkFiles())
+        return false;
+
+    UidSpace space;
+    if (link) {
+        // types of the same structure get the same uid, the classes of such
+        // types are split until they are stable, which is needed to tell
+        // apart e.g. pointers to 'struct node' of different layouts
+        size_t cntClasses = 0;
+        for (;;) {
+            TClassMap classes;
+            BOOST_FOREACH(ImageFile *file, files)
+                file->splitTypeClasses(classes);
+
+            if (cntClasses == classes.size())
+                break;
+
+            cntClasses = classes.size();
+        }
+
+        // unify uids of types and global symbols across the images
+        BOOST_FOREACH(ImageFile *file, files)
+            file->assignUids(space);
+
+        runStep(files, &ImageFile::rewriteUids, jobs);
+    }
+
+    // the containers are shared, so this needs to run sequentially
+    stor = new Storage;
+    BOOST_FOREACH(ImageFile *file, files)
+        file->materialize(*stor);
+
+    if (!this->checkFiles())
+        return false;
+
+    CL_DEBUG("CodeStorage loaded from " << files.size() << " image(s): "
+            << stor->types.size() << " types, "
+            << stor->vars.size() << " vars, "
+            << stor->fncs.size() << " fncs");
+
+    return true;
+}
+
+/// unlike releaseStorage(), keep the operands alone, they live in the images
+void StorageImage::Private::release()
+{
+    if (stor) {
+        BOOST_FOREACH(const Var &cVar, stor->vars) {
+            Var &var = stor->vars[cVar.uid];
+            BOOST_FOREACH(const Insn *insn, var.initials)
+                delete insn;
+
+            var.initials.clear();
+        }
+
+        BOOST_FOREACH(const Fnc *fnc, stor->fncs) {
+            destroyBlocks(fnc->cfg);
+            delete fnc->cgNode;
+            delete fnc;
+        }
+
+        delete stor;
+        stor = 0;
+    }
+
+    BOOST_FOREACH(ImageFile *file, files)
+        delete file;
+
+    files.clear();
+}
+
+StorageImage::StorageImage():
+    d(new Private)
+{
+}
+
+StorageImage::~StorageImage()
+{
+    d->release();
+    delete d;
+}
+
+bool StorageImage::load(const char *fileName)
+{
+    const std::vector<std::string> fileNames(1, fileName);
+    return d->open(fileNames, /* jobs */ 1, /* link */ false);
+}
+
+bool StorageImage::link(const std::vector<std::string> &fileNames,
+                        unsigned jobs)
+{
+    return d->open(fileNames, jobs, /* link */ true);
+}
+
+Storage& StorageImage::stor()
+{
+    CL_BREAK_IF(!d->stor);
+    return *d->stor;
+}
+
+} // namespace CodeStorage
+
+
+// /////////////////////////////////////////////////////////////////////////////
+// ClStorageDump
+class ClStorageDump: public ClStorageBuilder {
+    public:
+        ClStorageDump(const char *fileName):
+            fileName_(fileName)
+        {
+        }
+
+    protected:
+        virtual void run(CodeStorage::Storage &stor) {
+            CL_DEBUG("writing CodeStorage image to '" << fileName_ << "'...");
+            CodeStorage::writeStorage(stor, fileName_.c_str());
+        }
+
+    private:
+        std::string fileName_;
+};
+
+ICodeListener* createClStorageDump(const char *fileName)
+{
+    if (!fileName || !*fileName) {
+        CL_ERROR("dump_storage: no output file given");
+        return 0;
+    }
+
+    return new ClStorageDump(fileName);
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_STORAGE_IO_H
+#define H_GUARD_STORAGE_IO_H
+
+/**
+ * @file storage_io.hh
+ * binary image of CodeStorage::Storage, written once and loaded by mmap(2)
+ */
+
+#include <string>
+#include <vector>
+
+class ICodeListener;
+
+namespace CodeStorage {
+
+struct Storage;
+
+/**
+ * write types, variables, functions and their control flow of the given
+ * storage as a binary image to @b fileName
+ * @note data computed by the "easy" pipeline (call graph, loop-closing edges,
+ * points-to graphs, kill lists) are not written, they are cheap to recompute
+ */
+bool writeStorage(const Storage &stor, const char *fileName);
+
+/**
+ * Storage materialised from images written by writeStorage().  The images are
+ * mapped into memory and all cl_type, cl_var, cl_accessor objects and strings
+ * are used in place, only the CodeStorage containers are allocated.
+ */
+class StorageImage {
+    public:
+        StorageImage();
+        ~StorageImage();
+
+        /// map the given image, return false if it cannot be used
+        bool load(const char *fileName);
+
+        /**
+         * map images of several translation units and link them into a single
+         * storage of the whole program.  Types are unified by their structure,
+         * global variables and functions by their names.  The images are
+         * mapped and their uids rewritten in up to @b jobs threads.
+         */
+        bool link(const std::vector<std::string> &fileNames, unsigned jobs);
+
+        /// the storage materialised by load() or link(), valid while alive
+        Storage& stor();
+
+    private:
+        /// @b not allowed to be copied
+        StorageImage(const StorageImage &);
+
+        /// @b not allowed to be copied
+        StorageImage& operator=(const StorageImage &);
+
+    private:
+        struct Private;
+        Private *d;
+};
+
+} // namespace CodeStorage
+
+/**
+ * constructor of the @b "dump_storage" code listener, which writes the built
+ * storage to the file given as @b fileName
+ */
+ICodeListener* createClStorageDump(const char *fileName);
+
+#endif /* H_GUARD_STORAGE_IO_H */
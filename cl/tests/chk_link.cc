@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cl/easy.hh>
+#include <cl/storage.hh>
+
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include <boost/foreach.hpp>
+
+// required by the gcc plug-in API
+extern "C" {
+    __attribute__ ((__visibility__ ("default"))) int plugin_is_GPL_compatible;
+}
+
+// print items of each struct/union that a pointer type of the storage points
+// to, types of the same name but of different layout need to be kept apart
+// when CodeStorage images of several translation units are linked together
+void clEasyRun(const CodeStorage::Storage &stor, const char *) {
+    std::set<std::string> lines;
+    BOOST_FOREACH(const struct cl_type *clt, stor.types) {
+        if (CL_TYPE_PTR != clt->code)
+            continue;
+
+        const struct cl_type *target = clt->items[0].type;
+        if (CL_TYPE_STRUCT != target->code && CL_TYPE_UNION != target->code)
+            continue;
+
+        std::ostringstream str;
+        str << "pointer to " << ((target->name) ? target->name : "<anon>")
+            << " {";
+
+        for (int i = 0; i < target->item_cnt; ++i) {
+            const char *name = target->items[i].name;
+            str << " " << ((name) ? name : "<anon>");
+        }
+
+        str << " }";
+        lines.insert(str.str());
+    }
+
+    BOOST_FOREACH(const std::string &line, lines)
+        std::cout << line << std::endl;
+}
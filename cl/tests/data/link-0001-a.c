@@ -0,0 +1,10 @@
+struct node {
+    struct node *next;
+    int data;
+    int key;
+};
+
+int data_a(struct node *n)
+{
+    return n->data;
+}
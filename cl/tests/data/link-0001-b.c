@@ -0,0 +1,14 @@
+/**
+ * The same name and size of the struct as in link-0001-a.c, but a different
+ * layout.
+ */
+struct node {
+    int data;
+    int key;
+    struct node *next;
+};
+
+int data_b(struct node *n)
+{
+    return n->next->data;
+}
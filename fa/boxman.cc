@@ -168,6 +168,8 @@ void BoxAntichain::asVector(std::vector<const Box*>& boxes) const
 
 const std::pair<const Data, NodeLabel*>& BoxMan::insertData(const Data& data)
 {
+	OptLockGuard<std::recursive_mutex> lock(mutex_, concurrent_);
+
 	std::pair<TDataStore::iterator, bool> p = dataStore_.insert(
 		std::make_pair(data, static_cast<NodeLabel*>(nullptr)));
 
@@ -197,6 +199,8 @@ label_type BoxMan::lookupLabel(
 	size_t                        arity,
 	const DataArray&              x)
 {
+	OptLockGuard<std::recursive_mutex> lock(mutex_, concurrent_);
+
 	std::pair<TVarDataStore::iterator, bool> p = vDataStore_.insert(
 		std::make_pair(std::make_pair(arity, x), static_cast<NodeLabel*>(nullptr)));
 	if (p.second)
@@ -248,6 +252,8 @@ label_type BoxMan::lookupLabel(
 	const std::vector<const AbstractBox*>&     x,
 	const std::vector<SelData>*                nodeInfo)
 {
+	OptLockGuard<std::recursive_mutex> lock(mutex_, concurrent_);
+
 	std::pair<TNodeStore::iterator, bool> p = nodeStore_.insert(
 		std::make_pair(x, static_cast<NodeLabel*>(nullptr)));
 
@@ -282,6 +288,8 @@ label_type BoxMan::lookupLabel(
 
 const SelBox* BoxMan::getSelector(const SelData& sel)
 {
+	OptLockGuard<std::recursive_mutex> lock(mutex_, concurrent_);
+
 	std::pair<const SelData, const SelBox*>& p = *selIndex_.insert(
 		std::make_pair(sel, static_cast<const SelBox*>(nullptr))
 	).first;
@@ -297,6 +305,8 @@ const SelBox* BoxMan::getSelector(const SelData& sel)
 
 const TypeBox* BoxMan::getTypeInfo(const std::string& name)
 {
+	OptLockGuard<std::recursive_mutex> lock(mutex_, concurrent_);
+
 	TTypeIndex::const_iterator i = typeIndex_.find(name);
 	if (i == typeIndex_.end())
 		throw std::runtime_error("BoxMan::getTypeInfo(): type for "
@@ -309,6 +319,8 @@ const TypeBox* BoxMan::createTypeInfo(
 	const std::string&            name,
 	const std::vector<size_t>&    selectors)
 {
+	OptLockGuard<std::recursive_mutex> lock(mutex_, concurrent_);
+
 	std::pair<const std::string, const TypeBox*>& p = *typeIndex_.insert(
 		std::make_pair(name, static_cast<const TypeBox*>(nullptr))).first;
 	if (p.second && (selectors != p.second->getSelectors()))
@@ -411,8 +423,10 @@ Box* BoxMan::createType2Box(
 }
 
 
-const Box* BoxMan::getBox(const Box& box)
+const Box* BoxMan::insertBox(const Box& box)
 {
+	OptLockGuard<std::recursive_mutex> lock(mutex_, concurrent_);
+
 	// insert the box into the manager
 	const Box* cpBox = boxes_.get(box);
 	assert(nullptr != cpBox);
@@ -427,11 +441,35 @@ const Box* BoxMan::getBox(const Box& box)
 
 		FA_DEBUG_AT(1, "learning " << *static_cast<const AbstractBox*>(cpBox)
 			<< ':' << std::endl << *cpBox);
+	}
+
+	return cpBox;
+}
+
+
+const Box* BoxMan::getBox(const Box& box)
+{
+	OptLockGuard<std::recursive_mutex> lock(mutex_, concurrent_);
 
 #if FA_RESTART_AFTER_BOX_DISCOVERY
+	if (concurrent_)
+	{	// the box is inserted by the restart, so other threads executing the
+		// same round cannot see it
+		const Box* cpBox = boxes_.lookup(box);
+		if (nullptr == cpBox)
+			throw RestartRequest("a new box encountered",
+				std::shared_ptr<const Box>(new Box(box)));
+
+		return cpBox;
+	}
+#endif
+
+	const Box* cpBox = this->insertBox(box);
+
+#if FA_RESTART_AFTER_BOX_DISCOVERY
+	if (boxes_.modified())
 		throw RestartRequest("a new box encountered");
 #endif
-	}
 
 	return cpBox;
 }
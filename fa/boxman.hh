@@ -21,12 +21,16 @@
 #define BOX_MANAGER_H
 
 // Standard library headers
+#include <istream>
+#include <mutex>
+#include <ostream>
 #include <vector>
 #include <string>
 #include <unordered_map>
 
 // Forester headers
 #include "box.hh"
+#include "utils.hh"
 
 class BoxAntichain
 {
@@ -291,6 +295,12 @@ private:  // data members
 
 	TTypeDescDict typeDescDict_;
 
+	/// guards all stores in the concurrent mode (see BoxMan::setConcurrent())
+	mutable std::recursive_mutex mutex_;
+
+	/// may the manager be used by several threads at once?
+	bool concurrent_;
+
 private:  // methods
 
 	const std::pair<const Data, NodeLabel*>& insertData(const Data& data);
@@ -319,6 +329,8 @@ public:
 		const TypeBox* tb,
 		const std::vector<SelData>& sels)
 	{
+		OptLockGuard<std::recursive_mutex> lock(mutex_, concurrent_);
+
 		auto itBoolPair = typeDescDict_.insert(std::make_pair(tb, sels));
 		if (!itBoolPair.second)
 		{	// in case a new element was not inserted
@@ -332,6 +344,14 @@ public:
 		return &itBoolPair.first->second;
 	}
 
+	const std::vector<SelData>* findTypeDesc(const TypeBox* tb) const
+	{
+		OptLockGuard<std::recursive_mutex> lock(mutex_, concurrent_);
+
+		auto iter = typeDescDict_.find(tb);
+		return (iter == typeDescDict_.end())?(nullptr):(&iter->second);
+	}
+
 	struct EvaluateBoxF
 	{
 		NodeLabel& label;
@@ -364,6 +384,8 @@ public:
 
 	const Data& getData(size_t index) const
 	{
+		OptLockGuard<std::recursive_mutex> lock(mutex_, concurrent_);
+
 		// Assertions
 		assert(index < dataIndex_.size());
 
@@ -439,7 +461,8 @@ public:
 	 *
 	 * This method searches the database of boxes for the @p box and returns
 	 * a unique pointer to it. In the case a new box is inserted, it is
-	 * initialized.
+	 * initialized. In the concurrent mode, a new box is not inserted, but
+	 * handed over to the restart request instead.
 	 *
 	 * @param[in]  box  The box to be found (or inserted) in the database
 	 *
@@ -450,9 +473,77 @@ public:
 
 	const Box* lookupBox(const Box& box) const
 	{
+		OptLockGuard<std::recursive_mutex> lock(mutex_, concurrent_);
+
 		return boxes_.lookup(box);
 	}
 
+
+	/**
+	 * @brief  The number of boxes in the database
+	 *
+	 * Unlike BoxMan::boxDatabase(), this method may be called while other
+	 * threads learn new boxes.
+	 *
+	 * @returns  The number of boxes in the database
+	 */
+	size_t boxCount() const
+	{
+		OptLockGuard<std::recursive_mutex> lock(mutex_, concurrent_);
+
+		return boxes_.size();
+	}
+
+
+	/**
+	 * @brief  Inserts a box into the database (never requests a restart)
+	 *
+	 * This method searches the database of boxes for the @p box and returns
+	 * a unique pointer to it. In the case a new box is inserted, it is
+	 * initialized and BoxDatabase::modified() is set.
+	 *
+	 * @param[in]  box  The box to be found (or inserted) in the database
+	 *
+	 * @returns  Unique pointer to the box
+	 */
+	const Box* insertBox(const Box& box);
+
+
+	/**
+	 * @brief  Writes the database of boxes in the Timbuk format
+	 *
+	 * This method writes all boxes of the database (and boxes they refer to)
+	 * to @p os, so that they can be loaded by BoxMan::loadBoxes() in another
+	 * run on the same program. Boxes containing data that cannot be written
+	 * (e.g. native pointers) are omitted.
+	 *
+	 * @param[out]  os  The output stream
+	 *
+	 * @returns  The number of boxes written
+	 */
+	size_t saveBoxes(std::ostream& os) const;
+
+
+	/**
+	 * @brief  Loads boxes written by BoxMan::saveBoxes()
+	 *
+	 * This method inserts boxes from @p is into the database without requesting
+	 * a restart. Types have to be created before. Boxes referring to types or
+	 * boxes that are not known (or have a different layout) are skipped.
+	 *
+	 * @param[in]  is       The input stream
+	 * @param[in]  name     Name of the input (for error messages)
+	 * @param[in]  backend  The backend for tree automata of the boxes
+	 *
+	 * @returns  The number of boxes loaded
+	 *
+	 * @throws  std::runtime_error  if @p is is not in the Timbuk format
+	 */
+	size_t loadBoxes(
+		std::istream&                                is,
+		const std::string&                           name,
+		TreeAut::Backend&                            backend);
+
 	BoxMan() :
 		dataStore_{},
 		dataIndex_{},
@@ -462,7 +553,9 @@ public:
 		selIndex_{},
 		typeIndex_{},
 		boxes_{},
-		typeDescDict_{}
+		typeDescDict_{},
+		mutex_{},
+		concurrent_(false)
 	{ }
 
 	~BoxMan()
@@ -472,6 +565,21 @@ public:
 
 	void clear();
 
+	/**
+	 * @brief  Allows the manager to be used by several threads at once
+	 *
+	 * In the concurrent mode, all lookups and insertions are serialised by
+	 * a lock and BoxMan::getBox() leaves the insertion of new boxes to the
+	 * handler of the restart request. BoxMan::boxDatabase() must not be used
+	 * while other threads may use the manager.
+	 *
+	 * @param[in]  enabled  Is the manager to be used by several threads?
+	 */
+	void setConcurrent(bool enabled)
+	{
+		concurrent_ = enabled;
+	}
+
 	const BoxDatabase& boxDatabase() const
 	{
 		return boxes_;
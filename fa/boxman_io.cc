@@ -0,0 +1,998 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of forester.
+ *
+ * forester is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * forester is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with forester.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file boxman_io.cc
+ * Persistent database of boxes in the Timbuk format
+ *
+ * Every box is written as an automaton with its output component, optionally
+ * followed by an automaton with its input component.  Labels, states bound to
+ * data and the names of the automata (which carry the signatures of the box)
+ * are written as Timbuk identifiers in angle brackets, e.g.
+ *
+ *   Automaton <b0 out ...signature, input map and selectors of the box...>
+ *   States q0 q1 <r ref 1 0>
+ *   Final States q0
+ *   Transitions
+ *   <d undef>->q1
+ *   <n 3 t =node 2 0 4 s 0 4 0 =data s 4 4 0 =next>(q1,<r ref 1 0>)->q0
+ */
+
+// Standard library headers
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+// Forester headers
+#include "boxman.hh"
+#include "streams.hh"
+#include "timbuk.hh"
+
+namespace
+{	// anonymous namespace
+
+typedef ConnectionGraph::CutpointSignature CutpointSignature;
+
+// integers are written as signed so that static_cast<size_t>(-1) reads as -1
+void writeNum(std::ostream& os, size_t num)
+{
+	os << ' ' << static_cast<long long>(num);
+}
+
+bool readNum(std::istream& is, size_t& num)
+{
+	long long tmp;
+	if (!(is >> tmp))
+		return false;
+
+	num = static_cast<size_t>(tmp);
+	return true;
+}
+
+// strings are prefixed by '=' (so that an empty string is a token), characters
+// that would break a token or a Timbuk identifier are written as %XX
+void writeStr(std::ostream& os, const std::string& str)
+{
+	os << " =";
+	for (const char c : str)
+	{
+		if (isgraph(c) && '%' != c && '<' != c && '>' != c)
+		{
+			os << c;
+			continue;
+		}
+
+		static const char hex[] = "0123456789abcdef";
+		const unsigned char uc = static_cast<unsigned char>(c);
+		os << '%' << hex[uc >> 4] << hex[uc & 0xf];
+	}
+}
+
+bool readStr(std::istream& is, std::string& str)
+{
+	std::string tok;
+	if (!(is >> tok) || tok.empty() || '=' != tok[0])
+		return false;
+
+	str.clear();
+	for (size_t i = 1; i < tok.size(); ++i)
+	{
+		if ('%' != tok[i])
+		{
+			str += tok[i];
+			continue;
+		}
+
+		if (tok.size() < i + 3)
+			return false;
+
+		str += static_cast<char>(std::stoi(tok.substr(i + 1, 2), nullptr, 16));
+		i += 2;
+	}
+
+	return true;
+}
+
+bool writeData(std::ostream& os, const Data& data)
+{
+	switch (data.type)
+	{
+		case data_type_e::t_undef:
+			os << " undef";
+			return true;
+
+		case data_type_e::t_unknw:
+			os << " unknw";
+			return true;
+
+		case data_type_e::t_void_ptr:
+			os << " void_ptr";
+			writeNum(os, data.d_void_ptr_size);
+			return true;
+
+		case data_type_e::t_ref:
+			os << " ref";
+			writeNum(os, data.d_ref.root);
+			os << ' ' << data.d_ref.displ;
+			return true;
+
+		case data_type_e::t_int:
+			os << " int " << data.d_int;
+			return true;
+
+		case data_type_e::t_bool:
+			os << " bool " << data.d_bool;
+			return true;
+
+		default:
+			// native pointers are not valid in another run, structures do not
+			// appear in boxes
+			return false;
+	}
+}
+
+bool readData(std::istream& is, Data& data)
+{
+	std::string kind;
+	if (!(is >> kind))
+		return false;
+
+	if ("undef" == kind)
+	{
+		data = Data::createUndef();
+		return true;
+	}
+
+	if ("unknw" == kind)
+	{
+		data = Data::createUnknw();
+		return true;
+	}
+
+	if ("void_ptr" == kind)
+	{
+		size_t size;
+		if (!readNum(is, size))
+			return false;
+
+		data = Data::createVoidPtr(size);
+		return true;
+	}
+
+	if ("ref" == kind)
+	{
+		size_t root;
+		int displ;
+		if (!readNum(is, root) || !(is >> displ))
+			return false;
+
+		data = Data::createRef(root, displ);
+		return true;
+	}
+
+	if ("int" == kind)
+	{
+		int x;
+		if (!(is >> x))
+			return false;
+
+		data = Data::createInt(x);
+		return true;
+	}
+
+	if ("bool" == kind)
+	{
+		bool x;
+		if (!(is >> x))
+			return false;
+
+		data = Data::createBool(x);
+		return true;
+	}
+
+	return false;
+}
+
+void writeSelData(std::ostream& os, const SelData& sel)
+{
+	writeNum(os, sel.offset);
+	os << ' ' << sel.size << ' ' << sel.displ;
+	writeStr(os, sel.name);
+}
+
+bool readSelData(std::istream& is, SelData& sel)
+{
+	return readNum(is, sel.offset) && (is >> sel.size) && (is >> sel.displ)
+		&& readStr(is, sel.name);
+}
+
+template <class T>
+void writeList(std::ostream& os, const T& cont)
+{
+	writeNum(os, cont.size());
+	for (const size_t x : cont)
+		writeNum(os, x);
+}
+
+bool readSet(std::istream& is, std::set<size_t>& dst)
+{
+	size_t cnt;
+	if (!readNum(is, cnt))
+		return false;
+
+	for (size_t i = 0; i < cnt; ++i)
+	{
+		size_t x;
+		if (!readNum(is, x))
+			return false;
+
+		dst.insert(x);
+	}
+
+	return true;
+}
+
+void writeSignature(std::ostream& os, const CutpointSignature& signature)
+{
+	writeNum(os, signature.size());
+	for (const ConnectionGraph::CutpointInfo& cutpoint : signature)
+	{
+		writeNum(os, cutpoint.root);
+		writeNum(os, cutpoint.refCount);
+		writeNum(os, cutpoint.selCount);
+		writeNum(os, cutpoint.refInherited);
+		writeList(os, cutpoint.fwdSelectors);
+		writeNum(os, cutpoint.bwdSelector);
+		writeList(os, cutpoint.defines);
+	}
+}
+
+bool readSignature(std::istream& is, CutpointSignature& signature)
+{
+	size_t cnt;
+	if (!readNum(is, cnt))
+		return false;
+
+	for (size_t i = 0; i < cnt; ++i)
+	{
+		ConnectionGraph::CutpointInfo cutpoint;
+		cutpoint.fwdSelectors.clear();
+
+		size_t refInherited;
+		if (!readNum(is, cutpoint.root)
+			|| !readNum(is, cutpoint.refCount)
+			|| !readNum(is, cutpoint.selCount)
+			|| !readNum(is, refInherited)
+			|| !readSet(is, cutpoint.fwdSelectors)
+			|| !readNum(is, cutpoint.bwdSelector)
+			|| !readSet(is, cutpoint.defines)
+			|| cutpoint.fwdSelectors.empty())
+		{
+			return false;
+		}
+
+		cutpoint.refInherited = refInherited;
+		signature.push_back(cutpoint);
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief  Writes boxes of a box manager in the Timbuk format
+ *
+ * Boxes are written in such an order that every box is preceded by the boxes
+ * it refers to, so that they can be resolved while being read.
+ */
+class BoxDbWriter
+{
+private:  // data members
+
+	const BoxMan& boxMan_;
+
+	/// identifiers of boxes written so far
+	std::unordered_map<const Box*, size_t> ids_;
+
+	/// boxes that cannot be written
+	std::unordered_set<const Box*> failed_;
+
+	/// labels used by the written boxes with their arity
+	std::map<std::string, size_t> labels_;
+
+	/// the automata of the written boxes
+	std::ostringstream body_;
+
+private:  // methods
+
+	BoxDbWriter(const BoxDbWriter&);
+	BoxDbWriter& operator=(const BoxDbWriter&);
+
+	bool writeState(std::ostream& os, size_t state) const
+	{
+		if (!_MSB_TEST(state))
+		{
+			os << 'q' << state;
+			return true;
+		}
+
+		// a state bound to data, the identifier of data is valid in this run only
+		os << "<r";
+		if (!writeData(os, boxMan_.getData(_MSB_GET(state))))
+			return false;
+
+		os << '>';
+		return true;
+	}
+
+	bool writeLabel(std::ostream& os, const label_type& label) const
+	{
+		switch (label->GetType())
+		{
+			case NodeLabel::node_type::n_data:
+				os << "<d";
+				if (!writeData(os, label->getData()))
+					return false;
+
+				break;
+
+			case NodeLabel::node_type::n_node:
+				os << "<n";
+				writeNum(os, label->getNode().size());
+				for (const AbstractBox* aBox : label->getNode())
+				{
+					switch (aBox->getType())
+					{
+						case box_type_e::bTypeInfo:
+						{
+							const TypeBox* typeBox = static_cast<const TypeBox*>(aBox);
+							os << " t";
+							writeStr(os, typeBox->getName());
+							writeList(os, typeBox->getSelectors());
+							break;
+						}
+
+						case box_type_e::bSel:
+							os << " s";
+							writeSelData(os, static_cast<const SelBox*>(aBox)->getData());
+							break;
+
+						case box_type_e::bBox:
+						{
+							auto iter = ids_.find(static_cast<const Box*>(aBox));
+							if (ids_.end() == iter)
+								return false;
+
+							os << " b";
+							writeNum(os, iter->second);
+							break;
+						}
+
+						default:
+							return false;
+					}
+				}
+
+				if (label->node.sels)
+				{	// the type descriptor of the node
+					os << " i";
+					writeNum(os, label->node.sels->size());
+					for (const SelData& sel : *label->node.sels)
+						writeSelData(os, sel);
+				}
+
+				break;
+
+			default:
+				return false;
+		}
+
+		os << '>';
+		return true;
+	}
+
+	bool writeAut(
+		std::ostream&                  os,
+		const std::string&             name,
+		const TreeAut&                 ta)
+	{
+		std::map<std::string, size_t> labels;
+		std::set<size_t> states(ta.getFinalStates());
+		std::ostringstream trans;
+
+		for (const TreeAut::Transition& t : ta)
+		{
+			std::ostringstream label;
+			if (!this->writeLabel(label, t.label()))
+				return false;
+
+			labels.insert(std::make_pair(label.str(), t.lhs().size()));
+
+			trans << label.str();
+			if (!t.lhs().empty())
+			{
+				for (size_t i = 0; i < t.lhs().size(); ++i)
+				{
+					trans << ((i)?(','):('('));
+					this->writeState(trans, t.lhs()[i]);
+					states.insert(t.lhs()[i]);
+				}
+
+				trans << ')';
+			}
+
+			trans << "->";
+			this->writeState(trans, t.rhs());
+			states.insert(t.rhs());
+			trans << std::endl;
+		}
+
+		os << "Automaton " << name << std::endl << "States";
+		for (const size_t state : states)
+		{
+			os << ' ';
+			if (!this->writeState(os, state))
+				return false;
+		}
+
+		os << std::endl << "Final States";
+		for (const size_t state : ta.getFinalStates())
+		{
+			os << ' ';
+			this->writeState(os, state);
+		}
+
+		os << std::endl << "Transitions" << std::endl << trans.str();
+
+		labels_.insert(labels.begin(), labels.end());
+		return true;
+	}
+
+	// collects boxes the labels of @p ta refer to
+	static void gatherBoxes(std::vector<const Box*>& dst, const TreeAut* ta)
+	{
+		if (!ta)
+			return;
+
+		for (const TreeAut::Transition& t : *ta)
+		{
+			if (!t.label()->isNode())
+				continue;
+
+			for (const AbstractBox* aBox : t.label()->getNode())
+			{
+				if (box_type_e::bBox == aBox->getType())
+					dst.push_back(static_cast<const Box*>(aBox));
+			}
+		}
+	}
+
+public:   // methods
+
+	BoxDbWriter(const BoxMan& boxMan) :
+		boxMan_(boxMan),
+		ids_{},
+		failed_{},
+		labels_{},
+		body_{}
+	{ }
+
+	/**
+	 * @brief  Writes the box together with the boxes it refers to
+	 *
+	 * @returns  @p false if the box cannot be written
+	 */
+	bool writeBox(const Box* box)
+	{
+		if (ids_.count(box))
+			return true;
+
+		if (failed_.count(box))
+			return false;
+
+		// boxes refer to boxes learnt earlier, so this cannot loop forever
+		failed_.insert(box);
+
+		std::vector<const Box*> deps;
+		gatherBoxes(deps, box->getOutput());
+		gatherBoxes(deps, box->getInput());
+		for (const Box* dep : deps)
+		{
+			if (dep == box || !this->writeBox(dep))
+				return false;
+		}
+
+		const size_t id = ids_.size();
+
+		std::ostringstream name;
+		name << "<b" << id << " out";
+		writeSignature(name, box->getOutputSignature());
+		writeList(name, box->getInputMap());
+		writeNum(name, box->getSelectors().size());
+		for (const std::pair<size_t, size_t>& sel : box->getSelectors())
+		{
+			writeNum(name, sel.first);
+			writeNum(name, sel.second);
+		}
+		writeNum(name, !!box->getInput());
+		name << '>';
+
+		std::ostringstream auts;
+		if (!this->writeAut(auts, name.str(), *box->getOutput()))
+			return false;
+
+		if (box->getInput())
+		{
+			std::ostringstream inName;
+			inName << "<b" << id << " in";
+			writeNum(inName, box->getInputIndex());
+			writeSignature(inName, box->getInputSignature());
+			inName << '>';
+
+			if (!this->writeAut(auts, inName.str(), *box->getInput()))
+				return false;
+		}
+
+		failed_.erase(box);
+		ids_.insert(std::make_pair(box, id));
+		body_ << auts.str();
+		return true;
+	}
+
+	size_t count() const
+	{
+		return ids_.size();
+	}
+
+	void write(std::ostream& os) const
+	{
+		TimbukWriter writer(os);
+
+		os << "# forester box database" << std::endl;
+		writer.startAlphabet();
+		for (const auto& label : labels_)
+			writer.writeLabel(label.first, label.second);
+
+		writer.endl();
+		os << body_.str();
+	}
+};
+
+
+/**
+ * @brief  Reads boxes written by BoxDbWriter into a box manager
+ *
+ * Labels are resolved only when used by a transition as they may refer to
+ * boxes that are read later than the alphabet.  A box with an unresolvable
+ * label is skipped.
+ */
+class BoxDbReader : public TimbukReader
+{
+private:  // data members
+
+	BoxMan& boxMan_;
+	TreeAut::Backend& backend_;
+	std::string name_;
+
+	/// resolved labels (indexed by the index of the label in the alphabet)
+	std::vector<label_type> labelCache_;
+
+	/// loaded boxes (indexed by their identifiers in the database)
+	std::unordered_map<size_t, const Box*> boxes_;
+
+	/// the automaton being read, states of the reader mapped to its states
+	std::shared_ptr<TreeAut> ta_;
+	std::vector<size_t> stateMap_;
+
+	/// the box being read
+	size_t id_;
+	bool broken_;
+	bool expectInput_;
+	std::shared_ptr<TreeAut> output_;
+	CutpointSignature outputSignature_;
+	std::vector<size_t> inputMap_;
+	std::vector<std::pair<size_t, size_t>> selectors_;
+	size_t inputIndex_;
+	CutpointSignature inputSignature_;
+
+	size_t loaded_;
+	size_t skipped_;
+
+private:  // methods
+
+	BoxDbReader(const BoxDbReader&);
+	BoxDbReader& operator=(const BoxDbReader&);
+
+	bool resolveNode(std::istream& is, label_type& label)
+	{
+		size_t cnt;
+		if (!readNum(is, cnt))
+			return false;
+
+		std::vector<const AbstractBox*> node;
+		const TypeBox* typeBox = nullptr;
+		for (size_t i = 0; i < cnt; ++i)
+		{
+			std::string kind;
+			if (!(is >> kind))
+				return false;
+
+			if ("t" == kind)
+			{
+				std::string name;
+				std::set<size_t> sels;
+				if (!readStr(is, name) || !readSet(is, sels))
+					return false;
+
+				try
+				{
+					typeBox = boxMan_.getTypeInfo(name);
+				}
+				catch (const std::runtime_error&)
+				{	// the type is not in this program
+					return false;
+				}
+
+				const std::vector<size_t>& layout = typeBox->getSelectors();
+				if (sels != std::set<size_t>(layout.begin(), layout.end()))
+					// the type has been changed
+					return false;
+
+				node.push_back(typeBox);
+			}
+			else if ("s" == kind)
+			{
+				SelData sel(0, 0, 0, "");
+				if (!readSelData(is, sel))
+					return false;
+
+				node.push_back(boxMan_.getSelector(sel));
+			}
+			else if ("b" == kind)
+			{
+				size_t id;
+				if (!readNum(is, id))
+					return false;
+
+				auto iter = boxes_.find(id);
+				if (boxes_.end() == iter)
+					// the box has been skipped
+					return false;
+
+				node.push_back(iter->second);
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		const std::vector<SelData>* nodeInfo = nullptr;
+		std::string kind;
+		if ((is >> kind) && "i" == kind)
+		{
+			size_t selCnt;
+			if (!typeBox || !readNum(is, selCnt))
+				return false;
+
+			std::vector<SelData> sels;
+			for (size_t i = 0; i < selCnt; ++i)
+			{
+				sels.push_back(SelData(0, 0, 0, ""));
+				if (!readSelData(is, sels.back()))
+					return false;
+			}
+
+			const std::vector<SelData>* known = boxMan_.findTypeDesc(typeBox);
+			if (known && *known != sels)
+				return false;
+
+			nodeInfo = boxMan_.LookupTypeDesc(typeBox, sels);
+		}
+
+		label = boxMan_.lookupLabel(node, nodeInfo);
+		return true;
+	}
+
+	bool resolveLabel(size_t index, label_type& label)
+	{
+		if (labelCache_.size() <= index)
+			labelCache_.resize(index + 1);
+
+		if (labelCache_[index]._obj)
+		{
+			label = labelCache_[index];
+			return true;
+		}
+
+		std::istringstream is(this->getLabelName(index));
+		std::string kind;
+		if (!(is >> kind))
+			return false;
+
+		if ("d" == kind)
+		{
+			Data data;
+			if (!readData(is, data))
+				return false;
+
+			label = boxMan_.lookupLabel(data);
+		}
+		else if (!("n" == kind && this->resolveNode(is, label)))
+		{
+			return false;
+		}
+
+		labelCache_[index] = label;
+		return true;
+	}
+
+	void finishBox()
+	{
+		if (broken_)
+		{
+			++skipped_;
+			return;
+		}
+
+		std::shared_ptr<TreeAut> input;
+		if (expectInput_)
+			input = ta_;
+
+		Box box(
+			"",
+			output_,
+			outputSignature_,
+			inputMap_,
+			input,
+			inputIndex_,
+			inputSignature_,
+			selectors_
+		);
+
+		boxes_.insert(std::make_pair(id_, boxMan_.insertBox(box)));
+		++loaded_;
+	}
+
+	void fail(const std::string& msg)
+	{
+		Error::general(name_, 0, msg);
+	}
+
+protected:
+
+	virtual void newLabel(const std::string&, size_t, size_t)
+	{ }
+
+	virtual void beginModel(const std::string& name)
+	{
+		std::istringstream is(name);
+		std::string id, kind;
+		if (!(is >> id >> kind) || id.size() < 2 || 'b' != id[0])
+			this->fail("invalid box name: " + name);
+
+		size_t num = std::stoul(id.substr(1));
+
+		if ("in" == kind)
+		{
+			if (!expectInput_ || num != id_ || ta_ != output_)
+				this->fail("unexpected input component: " + name);
+
+			inputSignature_.clear();
+			if (!readNum(is, inputIndex_) || !readSignature(is, inputSignature_))
+				this->fail("invalid input component: " + name);
+		}
+		else if ("out" == kind)
+		{
+			if (expectInput_ && ta_ == output_)
+				this->fail("missing input component of box " + id);
+
+			id_ = num;
+			broken_ = false;
+			outputSignature_.clear();
+			inputMap_.clear();
+			selectors_.clear();
+			inputIndex_ = 0;
+			inputSignature_.clear();
+
+			size_t selCnt, hasInput;
+			if (!readSignature(is, outputSignature_)
+				|| !readNum(is, selCnt))
+			{
+				this->fail("invalid output component: " + name);
+			}
+
+			for (size_t i = 0; i < selCnt; ++i)
+			{
+				size_t sel;
+				if (!readNum(is, sel))
+					this->fail("invalid output component: " + name);
+
+				inputMap_.push_back(sel);
+			}
+
+			if (!readNum(is, selCnt))
+				this->fail("invalid output component: " + name);
+
+			for (size_t i = 0; i < selCnt; ++i)
+			{
+				std::pair<size_t, size_t> sel;
+				if (!readNum(is, sel.first) || !readNum(is, sel.second))
+					this->fail("invalid output component: " + name);
+
+				selectors_.push_back(sel);
+			}
+
+			if (!readNum(is, hasInput))
+				this->fail("invalid output component: " + name);
+
+			expectInput_ = hasInput;
+		}
+		else
+		{
+			this->fail("invalid box name: " + name);
+		}
+
+		ta_ = std::shared_ptr<TreeAut>(new TreeAut(backend_));
+		if ("out" == kind)
+			output_ = ta_;
+
+		stateMap_.clear();
+	}
+
+	virtual void newState(const std::string& name, size_t id)
+	{
+		if (stateMap_.size() <= id)
+			stateMap_.resize(id + 1);
+
+		std::istringstream is(name);
+		std::string kind;
+		Data data;
+		if ((is >> kind) && "r" == kind)
+		{	// a state bound to data
+			if (!readData(is, data))
+				this->fail("invalid state: " + name);
+
+			stateMap_[id] = _MSB_ADD(boxMan_.getDataId(data));
+			return;
+		}
+
+		stateMap_[id] = ta_->newState();
+	}
+
+	virtual void newFinalState(size_t id)
+	{
+		ta_->addFinalState(stateMap_.at(id));
+	}
+
+	virtual void endDeclaration()
+	{ }
+
+	virtual void newTransition(
+		const std::vector<size_t>&     lhs,
+		size_t                         label,
+		size_t                         rhs)
+	{
+		if (broken_)
+			return;
+
+		label_type resolved;
+		if (!this->resolveLabel(label, resolved))
+		{
+			broken_ = true;
+			return;
+		}
+
+		std::vector<size_t> mapped;
+		for (const size_t state : lhs)
+			mapped.push_back(stateMap_.at(state));
+
+		ta_->addTransition(mapped, resolved, stateMap_.at(rhs));
+	}
+
+	virtual void endModel()
+	{
+		if (expectInput_ && ta_ == output_)
+			// wait for the input component
+			return;
+
+		this->finishBox();
+	}
+
+public:   // methods
+
+	BoxDbReader(
+		BoxMan&                        boxMan,
+		TreeAut::Backend&              backend,
+		std::istream&                  input,
+		const std::string&             name) :
+		TimbukReader(input, name),
+		boxMan_(boxMan),
+		backend_(backend),
+		name_(name),
+		labelCache_{},
+		boxes_{},
+		ta_{},
+		stateMap_{},
+		id_(0),
+		broken_(false),
+		expectInput_(false),
+		output_{},
+		outputSignature_{},
+		inputMap_{},
+		selectors_{},
+		inputIndex_(0),
+		inputSignature_{},
+		loaded_(0),
+		skipped_(0)
+	{ }
+
+	size_t read()
+	{
+		this->readAll();
+		if (expectInput_ && ta_ == output_)
+			this->fail("missing input component of the last box");
+
+		if (skipped_)
+			FA_NOTE("skipped " << skipped_ << " box(es) not matching the program");
+
+		return loaded_;
+	}
+};
+
+} // namespace
+
+
+size_t BoxMan::saveBoxes(std::ostream& os) const
+{
+	std::vector<const Box*> boxes;
+	boxes_.asVector(boxes);
+
+	// keep the order in which the boxes have been learnt
+	std::sort(boxes.begin(), boxes.end(),
+		[](const Box* a, const Box* b) -> bool {
+			return a->getName().size() < b->getName().size()
+				|| (a->getName().size() == b->getName().size()
+					&& a->getName() < b->getName());
+		});
+
+	BoxDbWriter writer(*this);
+	for (const Box* box : boxes)
+	{
+		if (!writer.writeBox(box))
+			FA_DEBUG_AT(1, "unable to save " << *static_cast<const AbstractBox*>(box));
+	}
+
+	writer.write(os);
+	return writer.count();
+}
+
+
+size_t BoxMan::loadBoxes(
+	std::istream&                                is,
+	const std::string&                           name,
+	TreeAut::Backend&                            backend)
+{
+	BoxDbReader reader(*this, backend, is, name);
+	return reader.read();
+}
@@ -25,11 +25,25 @@
 #include <list>
 #include <set>
 #include <algorithm>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 
 // Boost headers
 #include <boost/functional/hash.hpp>
 
+// Forester headers
+#include "utils.hh"
+
+/**
+ * @brief  Reference-counted store of unique objects
+ *
+ * The store is split into shards. There is a single shard in the sequential
+ * mode. In the concurrent mode (see Cache::setConcurrent()), objects are
+ * distributed among several shards according to their hash, and every shard is
+ * guarded by its own mutex, so that threads working with different objects
+ * rarely compete for a lock.
+ */
 template <class T>
 class Cache
 {
@@ -43,19 +57,117 @@ public:   // data types
 		virtual ~Listener() {}
 	};
 
+private:  // data types
+
+	/// the number of shards in the concurrent mode
+	static const size_t CONCURRENT_SHARD_COUNT = 64;
+
+	struct Shard
+	{
+		store_type store;
+		std::mutex mutex;
+
+		Shard() :
+			store{},
+			mutex{}
+		{ }
+	};
+
 private:  // data members
 
-	store_type store;
+	std::unique_ptr<Shard[]> shards;
+
+	size_t shardCount;
+
+	bool concurrent;
 
 	std::vector<Listener*> listeners;
 
+private:  // methods
+
+	Cache(const Cache&);
+	Cache& operator=(const Cache&);
+
+	size_t shardIndexOf(const T& x) const
+	{
+		if (1 == this->shardCount)
+			return 0;
+
+		return boost::hash<T>()(x) % this->shardCount;
+	}
+
+	Shard& shardOf(const T& x) const
+	{
+		return this->shards[this->shardIndexOf(x)];
+	}
+
+	size_t releaseInShard(Shard& shard, value_type* x)
+	{
+		if (x->second > 1)
+			return --x->second;
+
+		for (Listener* lsnr : this->listeners)
+			lsnr->drop(x);
+
+		shard.store.erase(x->first);
+		return 0;
+	}
+
+	/**
+	 * @brief  Calls @p f on objects of a range grouped by their shards
+	 *
+	 * The lock of every shard is held while @p f is called on the objects of
+	 * the shard.
+	 */
+	template <class InputIterator, class F>
+	void forEachByShard(InputIterator begin, InputIterator end, F f)
+	{
+		std::vector<std::pair<size_t, value_type*>> v;
+		for (; begin != end; ++begin)
+			v.push_back(std::make_pair(this->shardIndexOf((*begin)->first), *begin));
+
+		std::sort(v.begin(), v.end(),
+			[](const std::pair<size_t, value_type*>& a,
+				const std::pair<size_t, value_type*>& b) { return a.first < b.first; });
+
+		for (auto i = v.begin(); i != v.end(); )
+		{
+			Shard& shard = this->shards[i->first];
+			std::lock_guard<std::mutex> lock(shard.mutex);
+
+			const size_t index = i->first;
+			for (; (i != v.end()) && (i->first == index); ++i)
+				f(shard, i->second);
+		}
+	}
+
 public:
 
 	Cache() :
-		store{},
+		shards(new Shard[1]),
+		shardCount(1),
+		concurrent(false),
 		listeners{}
 	{ }
 
+	/**
+	 * @brief  Switches between the sequential and the concurrent mode
+	 *
+	 * In the concurrent mode, the methods of the cache may be called from
+	 * several threads at once. The cache needs to be empty.
+	 *
+	 * @param[in]  enabled  Is the concurrent mode to be used?
+	 */
+	void setConcurrent(bool enabled)
+	{
+		// Assertions
+		assert(this->empty());
+
+		this->shardCount = (enabled)? CONCURRENT_SHARD_COUNT : 1;
+		this->shards.reset(new Shard[this->shardCount]);
+		this->concurrent = enabled;
+	}
+
 	void addListener(Listener* x)
 	{
 		this->listeners.push_back(x);
@@ -63,45 +175,115 @@ public:
 
 	value_type* find(const T& x)
 	{
-		typename store_type::iterator i = this->store.find(x);
-		return (i == this->store.end())?(nullptr):(&*i);
+		Shard& shard = this->shardOf(x);
+		OptLockGuard<std::mutex> lock(shard.mutex, this->concurrent);
+
+		typename store_type::iterator i = shard.store.find(x);
+		return (i == shard.store.end())?(nullptr):(&*i);
 	}
 
 	value_type* lookup(const T& x)
 	{
-		return this->addRef(&*this->store.insert(std::make_pair(x, 0)).first);
+		Shard& shard = this->shardOf(x);
+		OptLockGuard<std::mutex> lock(shard.mutex, this->concurrent);
+
+		value_type* y = &*shard.store.insert(std::make_pair(x, 0)).first;
+		return ++y->second, y;
 	}
 
 	value_type* addRef(value_type* x)
 	{
+		if (!this->concurrent)
+			return ++x->second, x;
+
+		std::lock_guard<std::mutex> lock(this->shardOf(x->first).mutex);
 		return ++x->second, x;
 	}
 
 	size_t release(value_type* x)
 	{
-		if (x->second > 1)
-			return --x->second;
+		Shard& shard = this->shardOf(x->first);
+		OptLockGuard<std::mutex> lock(shard.mutex, this->concurrent);
 
-		for (Listener* lsnr : this->listeners)
-			lsnr->drop(x);
+		return this->releaseInShard(shard, x);
+	}
 
-		this->store.erase(x->first);
-		return 0;
+	/**
+	 * @brief  Adds a reference to each object of a range
+	 *
+	 * In the concurrent mode, the lock of every shard is taken only once.
+	 *
+	 * @param[in]  begin  The beginning of the range of pointers to objects
+	 * @param[in]  end    The end of the range
+	 */
+	template <class InputIterator>
+	void addRef(InputIterator begin, InputIterator end)
+	{
+		if (!this->concurrent)
+		{
+			for (; begin != end; ++begin)
+				++(*begin)->second;
+
+			return;
+		}
+
+		this->forEachByShard(begin, end, [](Shard&, value_type* x) {
+			++x->second;
+		});
+	}
+
+	/**
+	 * @brief  Releases a reference to each object of a range
+	 *
+	 * In the concurrent mode, the lock of every shard is taken only once.
+	 *
+	 * @param[in]  begin  The beginning of the range of pointers to objects
+	 * @param[in]  end    The end of the range
+	 */
+	template <class InputIterator>
+	void release(InputIterator begin, InputIterator end)
+	{
+		if (!this->concurrent)
+		{
+			for (; begin != end; ++begin)
+				this->releaseInShard(this->shards[0], *begin);
+
+			return;
+		}
+
+		this->forEachByShard(begin, end, [this](Shard& shard, value_type* x) {
+			this->releaseInShard(shard, x);
+		});
 	}
 
 	void clear()
 	{
-		for (Listener* lsnr : this->listeners)
+		for (size_t i = 0; i < this->shardCount; ++i)
 		{
-			for (typename store_type::iterator j = this->store.begin(); j != this->store.end(); ++j)
-				lsnr->drop(&*j);
+			Shard& shard = this->shards[i];
+			OptLockGuard<std::mutex> lock(shard.mutex, this->concurrent);
+
+			for (Listener* lsnr : this->listeners)
+			{
+				for (typename store_type::iterator j = shard.store.begin(); j != shard.store.end(); ++j)
+					lsnr->drop(&*j);
+			}
+			shard.store.clear();
 		}
-		this->store.clear();
 	}
 
 	bool empty() const
 	{
-		return this->store.empty();
+		for (size_t i = 0; i < this->shardCount; ++i)
+		{
+			Shard& shard = this->shards[i];
+			OptLockGuard<std::mutex> lock(shard.mutex, this->concurrent);
+
+			if (!shard.store.empty())
+				return false;
+		}
+
+		return true;
 	}
 };
 
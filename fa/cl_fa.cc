@@ -50,31 +50,6 @@ extern "C" {
     __attribute__ ((__visibility__ ("default"))) int plugin_is_GPL_compatible;
 }
 
-#if 0
-struct BoxDb {
-
-	std::unordered_map<std::string, std::string> store;
-
-	BoxDb(const std::string& root, const std::string& fileName) {
-		std::ifstream input((root + "/" + fileName).c_str());
-		if (!input.good())
-			throw std::runtime_error("Unable to open " + root + "/" + fileName);
-		std::string buf;
-		while (std::getline(input, buf)) {
-			if (buf.empty())
-				continue;
-			if (buf[0] == '#')
-				continue;
-			std::vector<std::string> data;
-			boost::split(data, buf, boost::is_from_range(':', ':'));
-			if (data.size() == 2)
-				this->store[data[0]] = root + "/" + data[1];
-		}
-	}
-
-};
-#endif
-
 void clEasyRun(const CodeStorage::Storage& stor, const char* configString)
 {
 	ssd::ColorConsole::enableForTerm(STDERR_FILENO);
@@ -126,12 +101,11 @@ void clEasyRun(const CodeStorage::Storage& stor, const char* configString)
 		FA_LOG("loading types ...");
 		se->loadTypes(stor);
 
-/*
-		if (!conf.dbRoot.empty()){
-			BoxDb db(conf.dbRoot, "index");
-			se.loadBoxes(db.store);
+		if (!conf.boxDb.empty())
+		{
+			FA_LOG("loading boxes ...");
+			se->loadBoxes(conf.boxDb);
 		}
-*/
 
 		FA_LOG("compiling to microcode ...");
 		se->compile(stor, *main);
@@ -155,6 +129,12 @@ void clEasyRun(const CodeStorage::Storage& stor, const char* configString)
 		{
 			FA_LOG("starting symbolic execution ...");
 			se->run();
+
+			if (!conf.boxDb.empty())
+			{
+				FA_LOG("saving boxes ...");
+				se->saveBoxes(conf.boxDb);
+			}
 		}
 	}
 	catch (const NotImplementedException& e)
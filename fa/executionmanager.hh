@@ -21,7 +21,16 @@
 #define EXECUTION_MANAGER_H
 
 // Standard library headers
-#include <list>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 // Forester headers
 #include "types.hh"
@@ -29,53 +38,143 @@
 #include "abstractinstruction.hh"
 #include "fixpointinstruction.hh"
 #include "symstate.hh"
+#include "utils.hh"
 
 
 /**
  * @brief  Class that carries out symbolic execution of the code
  *
- * This class performs symbolic execution of the code.
+ * This class performs symbolic execution of the code. The states may be
+ * explored by several threads in rounds (see ExecutionManager::run()), each of
+ * the threads having its own memory managers.
  */
 class ExecutionManager
 {
 private:  // data types
 
-	typedef std::list<SymState*> QueueType;
+	typedef std::deque<SymState*> QueueType;
+
+	/**
+	 * @brief  The effects of the execution of a state in a round
+	 *
+	 * In the parallel mode, the effects of the execution of a state that other
+	 * threads could observe are recorded here. They take place at the end of
+	 * the round, in the order of the states in the round.
+	 */
+	struct Slot
+	{
+		/// the executed state
+		SymState* state;
+
+		/// the successors of the state, they are executed in the next round
+		std::vector<SymState*> successors;
+
+		/// the states whose paths have finished
+		std::vector<SymState*> finished;
+
+		/// the operations deferred by ExecutionManager::defer()
+		std::vector<std::function<void()>> deferred;
+
+		/// the exception thrown by the execution of the state (if any)
+		std::exception_ptr error;
+
+		Slot() :
+			state(nullptr),
+			successors{},
+			finished{},
+			deferred{},
+			error{}
+		{ }
+	};
+
+	/**
+	 * @brief  Data of a thread exploring symbolic states
+	 */
+	struct Worker
+	{
+		/// the queue with the states to be processed (of the first worker only)
+		QueueType queue;
+
+		/// the slot of the state being executed in the parallel mode
+		Slot* slot;
+
+		/// memory manager for registers
+		Recycler<DataArray> registerRecycler;
+
+		/// memory manager for states
+		Recycler<SymState> stateRecycler;
+
+		Worker() :
+			queue{},
+			slot(nullptr),
+			registerRecycler{},
+			stateRecycler{}
+		{ }
+	};
 
 private:  // data members
 
 	/// the root of the execution graph
 	SymState* root_;
 
-	/// the queue with the states to be processed
-	QueueType queue_;
-
 	/// counter of evaluated states
-	size_t statesExecuted_;
+	std::atomic<size_t> statesExecuted_;
 
 	/// counter of evaluated paths
-	size_t pathsEvaluated_;
+	std::atomic<size_t> pathsEvaluated_;
+
+	/// the workers (the first one belongs to the thread calling run())
+	std::vector<std::unique_ptr<Worker>> workers_;
+
+	/// are states explored by several threads right now?
+	bool parallel_;
+
+	/// guards the execution graph in the parallel mode
+	std::mutex treeMutex_;
+
+	/// the states of the current round (in the canonical order)
+	std::vector<Slot> round_;
+
+	/// index of the next slot of the round to be taken by a worker
+	std::atomic<size_t> nextSlot_;
+
+	/// the lowest index of a slot whose execution has thrown an exception
+	std::atomic<size_t> firstError_;
 
-	/// memory manager for registers
-	Recycler<DataArray> registerRecycler_;
-	/// memory manager for states
-	Recycler<SymState> stateRecycler_;
+	/// the serial number of the current round
+	size_t generation_;
+
+	/// the number of helper threads that have not finished the round yet
+	size_t busyWorkers_;
+
+	/// set when the helper threads are to terminate
+	bool done_;
+
+	/// guards ExecutionManager::generation_, busyWorkers_ and done_
+	std::mutex roundMutex_;
+
+	/// helper threads wait here for the next round
+	std::condition_variable roundStarted_;
+
+	/// the first worker waits here for the helper threads to finish the round
+	std::condition_variable roundFinished_;
 
 	class RecycleRegisterF
 	{
 	private:  // data members
 
-		Recycler<DataArray>& recycler_;
+		ExecutionManager& execMan_;
 
 	public:   // methods
 
-		RecycleRegisterF(Recycler<DataArray>& recycler) :
-			recycler_(recycler)
+		RecycleRegisterF(ExecutionManager& execMan) :
+			execMan_(execMan)
 		{ }
 
 		void operator()(DataArray* x)
 		{
-			recycler_.recycle(x);
+			// the registers go to the pool of the thread that releases them
+			execMan_.worker().registerRecycler.recycle(x);
 		}
 	};
 
@@ -84,35 +183,219 @@ private:  // methods
 	ExecutionManager(const ExecutionManager&);
 	ExecutionManager& operator=(const ExecutionManager&);
 
+	/**
+	 * @brief  Index of the worker run by the current thread
+	 */
+	static size_t& workerIndex()
+	{
+		static thread_local size_t index = 0;
+		return index;
+	}
+
+	Worker& worker()
+	{
+		// Assertions
+		assert(workerIndex() < workers_.size());
+
+		return *workers_[workerIndex()];
+	}
+
+	/**
+	 * @brief  Executes the states of the current round
+	 *
+	 * The slots are taken one by one by all workers, the effects of the
+	 * execution of a state are recorded in its slot. The slots following a slot
+	 * whose execution has thrown an exception are skipped, which is safe as
+	 * only the first exception of the round is rethrown.
+	 *
+	 * @param[in]  notify  Function called for every state before it is executed
+	 */
+	template <class F>
+	void executeRound(F& notify)
+	{
+		Worker& self = this->worker();
+
+		size_t index;
+		while ((index = nextSlot_++) < round_.size())
+		{
+			if (firstError_ < index)
+				continue;
+
+			Slot& slot = round_[index];
+			self.slot = &slot;
+
+			try
+			{
+				notify(*slot.state);
+				this->execute(*slot.state);
+			}
+			catch (...)
+			{
+				slot.error = std::current_exception();
+
+				size_t first = firstError_;
+				while (index < first && !firstError_.compare_exchange_weak(first, index))
+					;
+			}
+		}
+
+		self.slot = nullptr;
+	}
+
+	/**
+	 * @brief  The loop of a helper thread exploring states in parallel
+	 *
+	 * @param[in]  index   Index of the worker
+	 * @param[in]  notify  Function called for every state before it is executed
+	 */
+	template <class F>
+	void workerLoop(size_t index, F& notify)
+	{
+		workerIndex() = index;
+
+		size_t seen = 0;
+		for (;;)
+		{
+			{	// wait for the next round
+				std::unique_lock<std::mutex> lock(roundMutex_);
+				roundStarted_.wait(lock, [this, seen]() {
+					return done_ || seen != generation_;
+				});
+
+				if (done_)
+					return;
+
+				seen = generation_;
+			}
+
+			this->executeRound(notify);
+
+			std::lock_guard<std::mutex> lock(roundMutex_);
+			if (0 == --busyWorkers_)
+				roundFinished_.notify_one();
+		}
+	}
+
+	/**
+	 * @brief  Executes the states of the queue as one round
+	 *
+	 * The effects recorded in the slots take place in the order of the states
+	 * in the round, so neither the successors in the queue nor the fixpoints
+	 * depend on the order in which the threads have executed the states.
+	 *
+	 * @param[in]  helpers  The number of helper threads
+	 * @param[in]  notify   Function called for every state before it is executed
+	 */
+	template <class F>
+	void runRound(size_t helpers, F& notify)
+	{
+		QueueType& queue = this->worker().queue;
+
+		round_.clear();
+		round_.resize(queue.size());
+		for (size_t i = 0; i < round_.size(); ++i)
+			round_[i].state = queue[i];
+
+		queue.clear();
+
+		nextSlot_ = 0;
+		firstError_ = std::numeric_limits<size_t>::max();
+		parallel_ = true;
+
+		if (1 < round_.size() && helpers)
+		{	// wake up the helper threads
+			{
+				std::lock_guard<std::mutex> lock(roundMutex_);
+				++generation_;
+				busyWorkers_ = helpers;
+			}
+
+			roundStarted_.notify_all();
+			this->executeRound(notify);
+
+			std::unique_lock<std::mutex> lock(roundMutex_);
+			roundFinished_.wait(lock, [this]() { return 0 == busyWorkers_; });
+		}
+		else
+		{	// not worth waking up the helper threads
+			this->executeRound(notify);
+		}
+
+		parallel_ = false;
+
+		for (const Slot& slot : round_)
+		{	// the first exception in the order of the round wins
+			if (slot.error)
+				std::rethrow_exception(slot.error);
+		}
+
+		for (Slot& slot : round_)
+		{
+			queue.insert(queue.end(), slot.successors.begin(), slot.successors.end());
+
+			for (const std::function<void()>& f : slot.deferred)
+				f();
+
+			for (SymState* state : slot.finished)
+				this->destroyBranch(state);
+		}
+
+		round_.clear();
+	}
+
 public:
 
 	ExecutionManager() :
 		root_(nullptr),
-		queue_{},
 		statesExecuted_{},
 		pathsEvaluated_{},
-		registerRecycler_{},
-		stateRecycler_{}
-	{ }
+		workers_{},
+		parallel_(false),
+		treeMutex_{},
+		round_{},
+		nextSlot_{},
+		firstError_{},
+		generation_(0),
+		busyWorkers_(0),
+		done_(false),
+		roundMutex_{},
+		roundStarted_{},
+		roundFinished_{}
+	{
+		workers_.push_back(std::unique_ptr<Worker>(new Worker()));
+	}
 
 	~ExecutionManager()
 	{
 		this->clear();
+
+		// recycled states still refer to registers, which go to the pool of the
+		// first worker when the states are deleted
+		for (auto& w : workers_)
+			w->stateRecycler.clear();
 	}
 
 	size_t statesEvaluated() const { return statesExecuted_; }
 
 	size_t pathsEvaluated() const { return pathsEvaluated_; }
 
+	/**
+	 * @brief  Are states explored by several threads right now?
+	 */
+	bool isParallel() const { return parallel_; }
+
 	void clear()
 	{
 		if (nullptr != root_)
 		{
-			root_->recycle(stateRecycler_);
+			root_->recycle(this->worker().stateRecycler);
 			root_ = nullptr;
 		}
 
-		queue_.clear();
+		for (auto& w : workers_)
+			w->queue.clear();
+
+		round_.clear();
 
 		statesExecuted_ = 0;
 		pathsEvaluated_ = 0;
@@ -120,7 +403,7 @@ public:
 
 	SymState* createState()
 	{
-		SymState* state = stateRecycler_.alloc();
+		SymState* state = this->worker().stateRecycler.alloc();
 		assert(nullptr != state);
 		return state;
 	}
@@ -131,6 +414,7 @@ public:
 		AbstractInstruction*               instr)
 	{
 		SymState* state = createState();
+		OptLockGuard<std::mutex> lock(treeMutex_, parallel_);
 		state->initChildFrom(&oldState, instr);
 
 		return state;
@@ -142,6 +426,7 @@ public:
 	{
 		SymState* state = createState();
 		const std::shared_ptr<DataArray> regs = allocRegisters(oldState.GetRegs());
+		OptLockGuard<std::mutex> lock(treeMutex_, parallel_);
 		state->initChildFrom(&oldState, instr, regs);
 
 		return state;
@@ -185,10 +470,12 @@ public:
 	{
 		SymState* state = createState();
 
-		state->init(parent, instr, fae, registers);
-		queue_.push_back(state);
+		{
+			OptLockGuard<std::mutex> lock(treeMutex_, parallel_);
+			state->init(parent, instr, fae, registers);
+		}
 
-		return state;
+		return this->enqueue(state);
 	}
 
 	SymState* enqueue(
@@ -197,44 +484,66 @@ public:
 		// Assertions
 		assert(nullptr != state);
 
-		queue_.push_back(state);
+		if (parallel_)
+			this->worker().slot->successors.push_back(state);
+		else
+			this->worker().queue.push_back(state);
+
 		return state;
 	}
 
+	/**
+	 * @brief  Performs an operation whose effects other threads must not see
+	 *
+	 * In the parallel mode, @p f is called at the end of the round, in the order
+	 * of the states in the round. Otherwise, it is called right away.
+	 *
+	 * @param[in]  f  The operation
+	 */
+	void defer(const std::function<void()>& f)
+	{
+		if (parallel_)
+			this->worker().slot->deferred.push_back(f);
+		else
+			f();
+	}
+
 	SymState* dequeueBFS()
 	{
-		if (queue_.empty())
+		QueueType& queue = this->worker().queue;
+		if (queue.empty())
 			return nullptr;
 
-		SymState* state = queue_.front();
+		SymState* state = queue.front();
 		assert(nullptr != state);
 
-		queue_.pop_front();
+		queue.pop_front();
 
 		return state;
 	}
 
 	SymState* dequeueDFS()
 	{
-		if (queue_.empty())
+		QueueType& queue = this->worker().queue;
+		if (queue.empty())
 			return nullptr;
 
-		SymState* state = queue_.back();
+		SymState* state = queue.back();
 		assert(nullptr != state);
 
-		queue_.pop_back();
+		queue.pop_back();
 
 		return state;
 	}
 
 	std::shared_ptr<DataArray> allocRegisters(const DataArray& model)
 	{
-		DataArray* v = registerRecycler_.alloc();
+		DataArray* v = this->worker().registerRecycler.alloc();
 		assert(nullptr != v);
 
 		*v = model;
 
-		return std::shared_ptr<DataArray>(v, RecycleRegisterF(registerRecycler_));
+		return std::shared_ptr<DataArray>(v, RecycleRegisterF(*this));
 	}
 
 	void init(const DataArray& registers, const std::shared_ptr<const FAE>& fae,
@@ -254,10 +563,90 @@ public:
 		state.GetInstr()->execute(*this, state);
 	}
 
+	/**
+	 * @brief  Executes the enqueued states and all their successors
+	 *
+	 * With @p jobs greater than one, the states are explored in rounds by @p jobs
+	 * threads (including the calling one). A round executes all states of the
+	 * queue, its successors form the queue of the next round. The effects of
+	 * the execution of the states that other threads could observe (new
+	 * successors, finished paths and extensions of fixpoints) take place at the
+	 * end of the round, in the order of the states in the queue. So the result
+	 * of the exploration does not depend on the timing of the threads. The
+	 * first exception in this order is rethrown in the calling thread. The
+	 * remaining states are left in the execution graph until
+	 * ExecutionManager::clear().
+	 *
+	 * @param[in]  jobs    The number of threads
+	 * @param[in]  notify  Function called for every state before it is executed
+	 */
+	template <class F>
+	void run(size_t jobs, F notify)
+	{
+		if (jobs <= 1)
+		{	// the sequential mode
+			SymState* state;
+			while (nullptr != (state = this->dequeueDFS()))
+			{
+				notify(*state);
+				this->execute(*state);
+			}
+
+			return;
+		}
+
+		// Assertions
+		assert(0 == workerIndex());
+
+		while (workers_.size() < jobs)
+			workers_.push_back(std::unique_ptr<Worker>(new Worker()));
+
+		done_ = false;
+
+		std::exception_ptr error;
+		std::vector<std::thread> threads;
+		try
+		{
+			for (size_t i = 1; i < jobs; ++i)
+			{
+				threads.push_back(std::thread([this, i, &notify]() {
+					this->workerLoop(i, notify);
+				}));
+			}
+
+			while (!this->worker().queue.empty())
+				this->runRound(threads.size(), notify);
+		}
+		catch (...)
+		{	// the execution has failed or a thread could not be started
+			error = std::current_exception();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(roundMutex_);
+			done_ = true;
+		}
+
+		roundStarted_.notify_all();
+		for (std::thread& t : threads)
+			t.join();
+
+		parallel_ = false;
+
+		if (error)
+			std::rethrow_exception(error);
+	}
+
 	void pathFinished(SymState* state)
 	{
 		++pathsEvaluated_;
 
+		if (parallel_)
+		{	// other threads may still execute the ancestors of the state
+			this->worker().slot->finished.push_back(state);
+			return;
+		}
+
 		this->destroyBranch(state);
 	}
 
@@ -274,7 +663,8 @@ public:
 		// Assertions
 		assert(nullptr != state);
 
-		state->recycle(stateRecycler_);
+		OptLockGuard<std::mutex> lock(treeMutex_, parallel_);
+		state->recycle(this->worker().stateRecycler);
 	}
 
 
@@ -283,6 +673,9 @@ public:
 		// Assertions
 		assert(nullptr != state);
 
+		OptLockGuard<std::mutex> lock(treeMutex_, parallel_);
+		Recycler<SymState>& recycler = this->worker().stateRecycler;
+
 		while (state->GetParent())
 		{
 			// Assertions
@@ -297,7 +690,7 @@ public:
 
 			if (state->GetParent()->GetChildren().size() > 1)
 			{
-				state->recycle(stateRecycler_);
+				state->recycle(recycler);
 				return;
 			}
 
@@ -307,7 +700,7 @@ public:
 		// Assertions
 		assert(state == root_);
 
-		root_->recycle(stateRecycler_);
+		root_->recycle(recycler);
 		root_ = nullptr;
 	}
 };
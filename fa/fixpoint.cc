@@ -289,7 +289,8 @@ void reorder(
 bool testInclusion(
 	FAE&                           fae,
 	TreeAut&                       fwdConf,
-	UFAE&                          fwdConfWrapper)
+	UFAE&                          fwdConfWrapper,
+	bool                           extend = true)
 {
 	TreeAut ta(*fwdConf.backend);
 
@@ -302,12 +303,11 @@ bool testInclusion(
 	if (TreeAut::subseteq(ta, fwdConf))
 		return true;
 
-	fwdConfWrapper.join(ta, index);
-
-	ta.clear();
+	if (!extend)
+		return false;
 
-	fwdConf.minimized(ta);
-	fwdConf = ta;
+	fwdConfWrapper.join(ta, index);
+	fwdConfWrapper.minimize();
 
 	return false;
 }
@@ -392,6 +392,72 @@ void learn2(
 } // namespace
 
 
+bool FixpointBase::testAndExtend(FAE& fae)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	return testInclusion(fae, fwdConf_, fwdConfWrapper_);
+}
+
+
+bool FixpointBase::isIncluded(FAE& fae)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	return testInclusion(fae, fwdConf_, fwdConfWrapper_, /* extend */ false);
+}
+
+
+void FixpointBase::extendOrFinish(
+	ExecutionManager&                      execMan,
+	SymState&                              state,
+	const std::shared_ptr<FAE>&            fae)
+{
+	if (this->testAndExtend(*fae))
+	{
+		FA_DEBUG_AT(3, "hit");
+
+		execMan.pathFinished(&state);
+	} else
+	{
+		FA_DEBUG_AT_MSG(1, &this->insn()->loc, "extending fixpoint\n" << *fae);
+
+		SymState* tmpState = execMan.createChildState(state, next_);
+		tmpState->SetFAE(fae);
+
+		execMan.enqueue(tmpState);
+	}
+}
+
+
+void FixpointBase::finish(
+	ExecutionManager&                      execMan,
+	SymState&                              state,
+	const std::shared_ptr<FAE>&            fae)
+{
+	if (!execMan.isParallel())
+	{
+		this->extendOrFinish(execMan, state, fae);
+		return;
+	}
+
+	// the fixpoint does not change during a round, so the inclusion in it is
+	// decided regardless of the timing of the threads
+	if (this->isIncluded(*fae))
+	{
+		FA_DEBUG_AT(3, "hit");
+
+		execMan.pathFinished(&state);
+		return;
+	}
+
+	// the fixpoint may have been extended by the preceding states of the round
+	execMan.defer([this, &execMan, &state, fae]() {
+		this->extendOrFinish(execMan, state, fae);
+	});
+}
+
+
 SymState* FixpointBase::reverseAndIsect(
 	ExecutionManager&                      execMan,
 	const SymState&                        fwdPred,
@@ -423,15 +489,21 @@ void FI_abs::abstract(
 
 		ContainerGuard<std::vector<FAE*>> g(tmp);
 
-		FAE::loadCompatibleFAs(
-			/* the result */ tmp,
-			fwdConf_,
-			taBackend_,
-			boxMan_,
-			fae,
-			0,
-			CompareVariablesF()
-		);
+		{	// other threads may extend the fixpoint meanwhile
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			FAE::loadCompatibleFAs(
+				/* the result */ tmp,
+				fwdConfWrapper_.getTDCache(),
+				fwdConfWrapper_.getRootTransitions(
+					fae.getRootCount(), fae.GetVariables()),
+				taBackend_,
+				boxMan_,
+				fae,
+				0,
+				CompareVariablesF()
+			);
+		}
 
 		for (size_t i = 0; i < tmp.size(); ++i)
 		{
@@ -485,7 +557,7 @@ void FI_abs::execute(ExecutionManager& execMan, SymState& state)
 	// reorder components into the canonical form (no merging!)
 	reorder(&state, *fae);
 
-	if (!boxMan_.boxDatabase().empty())
+	if (boxMan_.boxCount())
 	{	// in the case there are some boxes, try to fold immediately before
 		// normalization
 		for (size_t i = 0; i < FIXED_REG_COUNT; ++i)
@@ -507,7 +579,7 @@ void FI_abs::execute(ExecutionManager& execMan, SymState& state)
 #if FA_ALLOW_FOLDING
 	learn1(*fae, boxMan_);
 
-	if (boxMan_.boxDatabase().size())
+	if (boxMan_.boxCount())
 	{
 		FAE old(*fae->backend, boxMan_);
 
@@ -532,20 +604,7 @@ void FI_abs::execute(ExecutionManager& execMan, SymState& state)
 	}
 #endif
 	// test inclusion
-	if (testInclusion(*fae, fwdConf_, fwdConfWrapper_))
-	{
-		FA_DEBUG_AT(3, "hit");
-
-		execMan.pathFinished(&state);
-	} else
-	{
-		FA_DEBUG_AT_MSG(1, &this->insn()->loc, "extending fixpoint\n" << *fae);
-
-		SymState* tmpState = execMan.createChildState(state, next_);
-		tmpState->SetFAE(fae);
-
-		execMan.enqueue(tmpState);
-	}
+	this->finish(execMan, state, fae);
 }
 
 // FI_fix
@@ -559,7 +618,7 @@ void FI_fix::execute(ExecutionManager& execMan, SymState& state)
 #if FA_ALLOW_FOLDING
 	reorder(&state, *fae);
 
-	if (!boxMan_.boxDatabase().size())
+	if (!boxMan_.boxCount())
 	{
 		for (size_t i = 0; i < FIXED_REG_COUNT; ++i)
 		{
@@ -573,7 +632,7 @@ void FI_fix::execute(ExecutionManager& execMan, SymState& state)
 
 	normalize(*fae, &state, forbidden, true);
 #if FA_ALLOW_FOLDING
-	if (boxMan_.boxDatabase().size())
+	if (boxMan_.boxCount())
 	{
 		forbidden.clear();
 
@@ -598,18 +657,5 @@ void FI_fix::execute(ExecutionManager& execMan, SymState& state)
 	}
 #endif
 	// test inclusion
-	if (testInclusion(*fae, fwdConf_, fwdConfWrapper_))
-	{
-		FA_DEBUG_AT(3, "hit");
-
-		execMan.pathFinished(&state);
-	} else
-	{
-		FA_DEBUG_AT_MSG(1, &this->insn()->loc, "extending fixpoint\n" << *fae);
-
-		SymState* tmpState = execMan.createChildState(state, next_);
-		tmpState->SetFAE(fae);
-
-		execMan.enqueue(tmpState);
-	}
+	this->finish(execMan, state, fae);
 }
@@ -23,6 +23,7 @@
 // Standard library headers
 #include <vector>
 #include <memory>
+#include <mutex>
 
 // Forester headers
 #include "boxman.hh"
@@ -48,15 +49,85 @@ protected:
 
 	BoxMan& boxMan_;
 
+	/// guards the fixpoint against threads executing the instruction at once
+	std::mutex mutex_;
+
+protected:
+
+	/**
+	 * @brief  Tests inclusion of a forest automaton in the fixpoint
+	 *
+	 * In the case @p fae is not included in the fixpoint, the fixpoint is
+	 * extended with it. The test and the extension are atomic with respect to
+	 * other threads.
+	 *
+	 * @param[in,out]  fae  The tested forest automaton (without unreachable
+	 *                      parts on return)
+	 *
+	 * @returns  @p true if @p fae was included in the fixpoint, @p false
+	 *           otherwise
+	 */
+	bool testAndExtend(FAE& fae);
+
+	/**
+	 * @brief  Tests inclusion of a forest automaton in the fixpoint
+	 *
+	 * Unlike FixpointBase::testAndExtend(), the fixpoint is never extended.
+	 *
+	 * @param[in,out]  fae  The tested forest automaton (without unreachable
+	 *                      parts on return)
+	 *
+	 * @returns  @p true if @p fae was included in the fixpoint, @p false
+	 *           otherwise
+	 */
+	bool isIncluded(FAE& fae);
+
+	/**
+	 * @brief  Finishes the path of a state or continues with the next instruction
+	 *
+	 * If @p fae is included in the fixpoint, the path of @p state is finished.
+	 * Otherwise, the fixpoint is extended with @p fae and a child state with
+	 * @p fae is enqueued.
+	 *
+	 * @param[in]  execMan  The execution manager
+	 * @param[in]  state    The executed state
+	 * @param[in]  fae      The forest automaton obtained from @p state
+	 */
+	void extendOrFinish(
+		ExecutionManager&                      execMan,
+		SymState&                              state,
+		const std::shared_ptr<FAE>&            fae);
+
+	/**
+	 * @brief  Completes the execution of the instruction on a state
+	 *
+	 * Calls FixpointBase::extendOrFinish(). When states are explored in
+	 * parallel, the fixpoint is extended at the end of the round, in the order
+	 * of the states in the round (see ExecutionManager::defer()), while states
+	 * already included in the fixpoint are finished right away.
+	 *
+	 * @param[in]  execMan  The execution manager
+	 * @param[in]  state    The executed state
+	 * @param[in]  fae      The forest automaton obtained from @p state
+	 */
+	void finish(
+		ExecutionManager&                      execMan,
+		SymState&                              state,
+		const std::shared_ptr<FAE>&            fae);
+
 public:
 
 	virtual void extendFixpoint(const std::shared_ptr<const FAE>& fae)
 	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
 		fixpoint_.push_back(fae);
 	}
 
 	virtual void clear()
 	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
 		fixpoint_.clear();
 		fwdConf_.clear();
 		fwdConfWrapper_.clear();
@@ -95,7 +166,8 @@ public:
 		fwdConfWrapper_(fwdConf_, boxMan),
 		fixpoint_{},
 		taBackend_(taBackend),
-		boxMan_(boxMan)
+		boxMan_(boxMan),
+		mutex_{}
 	{ }
 
 	virtual ~FixpointBase()
@@ -128,36 +128,37 @@ public:
 	/**
 	 * @brief  Loads compatible FA from a wrapping TA
 	 *
-	 * This method takes a wrapping TA @p src and breaks it into FA. Then it
-	 * takes those FA which are compatible with @p fae and returns them in @p
-	 * dst.
+	 * This method takes a wrapping TA given by its top-down index @p cache and
+	 * breaks it into FA. Then it takes those FA which are compatible with @p fae
+	 * and returns them in @p dst. Only the root transitions in @p
+	 * rootTransitions are considered, so that the cost does not depend on the
+	 * number of FA of a different shape stored in the wrapping TA.
 	 *
-	 * @param[out]  dst          The result vector where the FA will be filled
-	 * @param[in]   src          The wrapping TA which contains the FA
-	 * @param[in]   backend      The TA backend
-	 * @param[in]   boxMan       The used box manager
-	 * @param[in]   fae          The FA with which the loaded FA are supposed to
-	 *                           be compatible
-	 * @param[in]   stateOffset  The offset for renaming states
-	 * @param[in]   funcCompat   The functor that checks additional compatibility
-	 *                           restraints
+	 * @param[out]  dst              The result vector where the FA will be
+	 *                               filled
+	 * @param[in]   cache            The top-down index of the wrapping TA
+	 * @param[in]   rootTransitions  Root transitions of the wrapping TA which
+	 *                               are candidates for compatibility with @p fae
+	 * @param[in]   backend          The TA backend
+	 * @param[in]   boxMan           The used box manager
+	 * @param[in]   fae              The FA with which the loaded FA are supposed
+	 *                               to be compatible
+	 * @param[in]   stateOffset      The offset for renaming states
+	 * @param[in]   funcCompat       The functor that checks additional
+	 *                               compatibility restraints
 	 */
 	template <class F>
 	static void loadCompatibleFAs(
-		std::vector<FAE*>&              dst,
-		const TreeAut&                  src,
-		TreeAut::Backend&               backend,
-		BoxMan&                         boxMan,
-		const FAE&                      fae,
-		size_t                          stateOffset,
-		F                               funcCompat)
+		std::vector<FAE*>&                     dst,
+		const TreeAut::td_cache_type&          cache,
+		const std::vector<const Transition*>&  rootTransitions,
+		TreeAut::Backend&                      backend,
+		BoxMan&                                boxMan,
+		const FAE&                             fae,
+		size_t                                 stateOffset,
+		F                                      funcCompat)
 	{
-		// build TD cache and insert empty set of root transitions (if not present)
-		TreeAut::td_cache_type cache = src.buildTDCache();
-		std::vector<const Transition*>& v = cache.insert(
-			std::make_pair(0, std::vector<const Transition*>())).first->second;
-
-		for (const Transition* trans : v)
+		for (const Transition* trans : rootTransitions)
 		{ // iterate over all "synthetic" transitions and constuct new FAE for each
 			assert(nullptr != trans);
 
@@ -179,7 +180,7 @@ public:
 
 				const size_t& rootState = trans->lhs()[j];
 
-				for (TreeAut::td_iterator k = src.tdStart(cache, {rootState});
+				for (TreeAut::td_iterator k(cache, {rootState});
 					k.isValid();
 					k.next())
 				{ // copy reachable transitions
@@ -253,6 +253,11 @@ struct label_type
 	label_type(const label_type& label) : _obj(label._obj) {}
 	label_type(const NodeLabel* obj) : _obj(obj) {}
 
+	label_type& operator=(const label_type& rhs) {
+		this->_obj = rhs._obj;
+		return *this;
+	}
+
 	const NodeLabel& operator*() const {
 		assert(this->_obj);
 		return *this->_obj;
@@ -531,9 +531,20 @@ void FI_iadd::execute(ExecutionManager& execMan, SymState& state)
 // FI_check
 void FI_check::execute(ExecutionManager& execMan, SymState& state)
 {
-	state.GetFAE()->updateConnectionGraph();
+	if (execMan.isParallel())
+	{	// the FAE may be shared with states executed by other threads, so its
+		// connection graph cannot be updated in place
+		FAE fae(*(state.GetFAE()));
+		fae.updateConnectionGraph();
 
-	Normalization(const_cast<FAE&>(*(state.GetFAE())), &state).check();
+		Normalization(fae, &state).check();
+	}
+	else
+	{
+		state.GetFAE()->updateConnectionGraph();
+
+		Normalization(const_cast<FAE&>(*(state.GetFAE())), &state).check();
+	}
 
 	SymState* tmpState = execMan.createChildState(state, next_);
 	execMan.enqueue(tmpState);
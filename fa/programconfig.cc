@@ -84,5 +84,30 @@ void ProgramConfig::processArg(const std::string& arg)
 		return;
 	}
 
+	if (std::string("box-db") == key)
+	{
+		if (data.size() != 2)
+		{
+			throw std::invalid_argument("use \"box-db:<file>\"");
+		}
+
+		this->boxDb = data[1];
+		FA_LOG("Config::processArg: \"box-db\" is \"" + this->boxDb + "\"");
+		return;
+	}
+
+	if (std::string("jobs") == key)
+	{
+		if ((data.size() != 2) || data[1].empty()
+			|| (data[1].find_first_not_of("0123456789") != std::string::npos)
+			|| (0 == (this->jobs = std::stoul(data[1]))))
+		{
+			throw std::invalid_argument("use \"jobs:<N>\" with N > 0");
+		}
+
+		FA_LOG("Config::processArg: \"jobs\" is " << this->jobs);
+		return;
+	}
+
 	FA_WARN("unhandled argument: \"" << arg << "\"");
 }
@@ -31,6 +31,8 @@ struct ProgramConfig
 public:   // data members
 
 	std::string dbRoot;             ///< box database root directory
+	std::string boxDb;              ///< file with the persistent box database
+	unsigned    jobs;               ///< number of threads exploring states
 	bool        printUcode;         ///< printing microcode?
 	bool        printOrigCode;      ///< printing the original code?
 	bool        onlyCompile;        ///< only compiling?
@@ -45,6 +47,8 @@ public:   // methods
 
 	ProgramConfig(const std::string& confStr = "") :
 		dbRoot(""),
+		boxDb(""),
+		jobs(1),
 		printUcode(false),
 		printOrigCode(false),
 		onlyCompile(false),
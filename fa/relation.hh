@@ -20,61 +20,214 @@
 #ifndef RELATION_H
 #define RELATION_H
 
+#include <cassert>
+#include <cstdint>
+#include <iostream>
 #include <vector>
 #include <algorithm>
 
+/**
+ * @brief  A dense square bit matrix
+ *
+ * Every row is stored as a sequence of machine words, rows are padded to
+ * a multiple of the cache line size and start at a cache line boundary.
+ * Operations on whole rows thus work on one word (64 pairs) at a time and
+ * their loops are simple enough to be vectorized by the compiler.
+ */
 class Relation {
 
-	std::vector<std::vector<bool> > _data;
+public:
+
+	typedef uint64_t word_type;
+
+private:
+
+	static const size_t wordBits = 8 * sizeof(word_type);
+	static const size_t lineWords = 64 / sizeof(word_type);
+
+	std::vector<word_type> _data;
+	size_t _size;
+	size_t _stride;
 	size_t _index;
 
+private:  // methods
+
+	Relation(const Relation&);
+	Relation& operator=(const Relation&);
+
+	static size_t strideOf(size_t size) {
+		const size_t words = (size + wordBits - 1) / wordBits;
+		return (words + lineWords - 1) / lineWords * lineWords;
+	}
+
+	word_type* base() {
+		const uintptr_t addr = reinterpret_cast<uintptr_t>(this->_data.data());
+		const uintptr_t mask = lineWords * sizeof(word_type) - 1;
+		return reinterpret_cast<word_type*>((addr + mask) & ~mask);
+	}
+
+	const word_type* base() const {
+		return const_cast<Relation*>(this)->base();
+	}
+
+	void alloc(size_t size, bool value) {
+		this->_size = size;
+		this->_stride = Relation::strideOf(size);
+		this->_data.assign(size * this->_stride + lineWords,
+			(value)?(~word_type(0)):(word_type(0)));
+	}
+
 public:
 
 	Relation(size_t initialSize = 16)
-		: _data(initialSize, std::vector<bool>(initialSize, true)), _index(0) {}
+		: _data(), _size(), _stride(), _index(0) {
+		this->alloc(initialSize, true);
+	}
 
 	void reset() {
-		for (std::vector<std::vector<bool> >::iterator i = this->_data.begin(); i != this->_data.end(); ++i)
-			std::fill(i->begin(), i->end(), true);
+		std::fill(this->_data.begin(), this->_data.end(), ~word_type(0));
 		this->_index = 0;
 	}
 
+	// resize the matrix to @p size x @p size, all pairs set to @p value
+	void reset(size_t size, bool value) {
+		this->alloc(size, value);
+		this->_index = size;
+	}
+
 	size_t newEntry() {
-		if (this->_index == this->_data.size()) {
-			for (std::vector<std::vector<bool> >::iterator i = this->_data.begin(); i != this->_data.end(); ++i)
-				i->resize(2*this->_data.size(), true);
-	  	    this->_data.resize(2*this->_data.size(), std::vector<bool>(2*this->_data.size(), true));
-	  	}
+		if (this->_index == this->_size) {
+			// rows are copied to a new buffer at once, new pairs are related
+			const size_t oldSize = this->_size;
+			const size_t oldStride = this->_stride;
+			std::vector<word_type> old;
+			old.swap(this->_data);
+			const uintptr_t addr = reinterpret_cast<uintptr_t>(old.data());
+			const uintptr_t mask = lineWords * sizeof(word_type) - 1;
+			const word_type* src = reinterpret_cast<const word_type*>((addr + mask) & ~mask);
+
+			this->alloc(2*oldSize, true);
+			const size_t full = oldSize / wordBits;
+			const size_t rest = oldSize % wordBits;
+			for (size_t i = 0; i < oldSize; ++i) {
+				const word_type* s = src + i*oldStride;
+				word_type* d = this->row(i);
+				std::copy(s, s + full, d);
+				if (rest)
+					d[full] = s[full] | (~word_type(0) << rest);
+			}
+		}
 		return this->_index++;
 	}
 
-	std::vector<std::vector<bool> >& data() {
-		return this->_data;
+	size_t size() const {
+		return this->_index;
+	}
+
+	size_t words() const {
+		return this->_stride;
+	}
+
+	bool get(size_t i, size_t j) const {
+		assert(i < this->_size && j < this->_size);
+		return (this->row(i)[j / wordBits] >> (j % wordBits)) & 1;
 	}
-	
-	const std::vector<std::vector<bool> >& data() const {
-		return this->_data;
+
+	void set(size_t i, size_t j, bool value) {
+		assert(i < this->_size && j < this->_size);
+		const word_type bit = word_type(1) << (j % wordBits);
+		if (value)
+			this->row(i)[j / wordBits] |= bit;
+		else
+			this->row(i)[j / wordBits] &= ~bit;
+	}
+
+	word_type* row(size_t i) {
+		return this->base() + i*this->_stride;
+	}
+
+	const word_type* row(size_t i) const {
+		return this->base() + i*this->_stride;
+	}
+
+	void copyRow(size_t dst, size_t src) {
+		const word_type* s = this->row(src);
+		std::copy(s, s + this->_stride, this->row(dst));
+	}
+
+	// row[i] &= mask
+	void andRow(size_t i, const word_type* mask) {
+		word_type* __restrict__ d = this->row(i);
+		for (size_t k = 0; k < this->_stride; ++k)
+			d[k] &= mask[k];
+	}
+
+	// row[i] |= mask
+	void orRow(size_t i, const word_type* mask) {
+		word_type* __restrict__ d = this->row(i);
+		for (size_t k = 0; k < this->_stride; ++k)
+			d[k] |= mask[k];
+	}
+
+	// row[i] &= ~mask
+	void andNotRow(size_t i, const word_type* mask) {
+		word_type* __restrict__ d = this->row(i);
+		for (size_t k = 0; k < this->_stride; ++k)
+			d[k] &= ~mask[k];
+	}
+
+	// true if (a & b) != 0
+	bool intersects(const word_type* a, const word_type* b) const {
+		for (size_t k = 0; k < this->_stride; ++k) {
+			if (a[k] & b[k])
+				return true;
+		}
+		return false;
+	}
+
+	// true if (a & ~b) == 0
+	bool subseteq(const word_type* a, const word_type* b) const {
+		for (size_t k = 0; k < this->_stride; ++k) {
+			if (a[k] & ~b[k])
+				return false;
+		}
+		return true;
+	}
+
+	// a row-sized mask with all bits cleared
+	void zeroMask(std::vector<word_type>& mask) const {
+		mask.assign(this->_stride, 0);
+	}
+
+	static void maskSet(std::vector<word_type>& mask, size_t j) {
+		mask[j / wordBits] |= word_type(1) << (j % wordBits);
 	}
 
 	void load(const std::vector<std::vector<bool> >& src) {
-		this->_data = src;
-		this->_index = this->_data.size();
+		this->alloc(std::max(src.size(), size_t(1)), false);
+		for (size_t i = 0; i < src.size(); ++i) {
+			for (size_t j = 0; j < src[i].size(); ++j) {
+				if (src[i][j])
+					this->set(i, j, true);
+			}
+		}
+		this->_index = src.size();
 	}
-	
+
 	void store(std::vector<std::vector<bool> >& dst, size_t size) const {
 		dst.resize(size);
 		for (size_t i = 0; i < size; ++i) {
 			dst[i].resize(size);
 			for (size_t j = 0; j < size; ++j) {
-				dst[i][j] = this->_data[i][j];
+				dst[i][j] = this->get(i, j);
 			}
 		}
-	}	
+	}
 
 	void dump() const {
 		for (size_t i = 0; i < this->_index; ++i) {
-			for (size_t j = 0; j < this->_index; ++j) 
-				std::cout << (this->_data[i][j]?1:0);
+			for (size_t j = 0; j < this->_index; ++j)
+				std::cout << (this->get(i, j)?1:0);
 			std::cout << std::endl;
 		}
 	}
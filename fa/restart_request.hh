@@ -20,9 +20,12 @@
 #ifndef RESTART_REQUEST_H
 #define RESTART_REQUEST_H
 
+#include <memory>
 #include <string>
 #include <stdexcept>
 
+class Box;
+
 /**
  * @file restart_request.hh
  * RestartRequest class declaration (and definition)
@@ -39,6 +42,9 @@ class RestartRequest : public std::exception {
 	/// Error message
 	std::string msg;
 
+	/// A new box to be learnt before the restart (if any)
+	std::shared_ptr<const Box> box_;
+
 public:
 
 	/**
@@ -49,7 +55,27 @@ public:
 	 * @param[in]  reason  The reason for restart
 	 */
 	RestartRequest(const std::string& reason = "") :
-		msg("a restart is requested" + ((reason == "")?("."):(" (" + reason + ")."))) {}
+		msg("a restart is requested" + ((reason == "")?("."):(" (" + reason + ")."))),
+		box_{} {}
+
+	/**
+	 * @brief  Constructor
+	 *
+	 * Constructs a request to restart with the given box learnt.
+	 *
+	 * @param[in]  reason  The reason for restart
+	 * @param[in]  box     The box to be inserted into the database of boxes
+	 */
+	RestartRequest(const std::string& reason, const std::shared_ptr<const Box>& box) :
+		msg("a restart is requested (" + reason + ")."),
+		box_(box) {}
+
+	/**
+	 * @brief  Retrieves the box to be learnt before the restart
+	 *
+	 * @returns  The box, or @p nullptr if the box database is up to date
+	 */
+	const std::shared_ptr<const Box>& box() const { return box_; }
 
 	/**
 	 * @brief  Destructor
@@ -339,6 +339,15 @@ private:  // methods
 
 protected:
 
+	// the block @p dst split off from the block @p src inherits its relation
+	void inheritRelation(size_t dst, size_t src) {
+		this->_relation.copyRow(dst, src);
+		for (std::vector<OLRTBlock*>::iterator j = this->_partition.begin(); j != this->_partition.end(); ++j) {
+			if ((*j)->index() != dst)
+				this->_relation.set((*j)->index(), dst, this->_relation.get((*j)->index(), src));
+		}
+	}
+
 	void fastSplit(const std::vector<size_t>& remove) {
 		std::vector<OLRTBlock*> splitList;
 		for (std::vector<size_t>::const_iterator i = remove.begin(); i != remove.end(); ++i) {
@@ -357,11 +366,7 @@ protected:
 		for (std::vector<OLRTBlock*>::reverse_iterator i = splitList.rbegin(); i != splitList.rend(); ++i) {
 			OLRTBlock* bint = (*i)->intersection();
 			(*i)->intersection(nullptr);
-//			for (std::vector<OLRTBlock*>::iterator j = this->_partition.begin(); j != this->_partition.end(); ++j) {
-			for (std::vector<OLRTBlock*>::reverse_iterator j = this->_partition.rbegin(); j != this->_partition.rend(); ++j) {
-				this->_relation.data()[(*j)->index()][bint->index()] = this->_relation.data()[(*j)->index()][(*i)->index()];
-				this->_relation.data()[bint->index()][(*j)->index()] = this->_relation.data()[(*i)->index()][(*j)->index()];
-			}
+			this->inheritRelation(bint->index(), (*i)->index());
 		}
 	}
 
@@ -389,11 +394,7 @@ protected:
 		for (std::vector<OLRTBlock*>::reverse_iterator i = splitList.rbegin(); i != splitList.rend(); ++i) {
 			OLRTBlock* bint = (*i)->intersection();
 			(*i)->intersection(nullptr);
-//			for (std::vector<OLRTBlock*>::iterator j = this->_partition.begin(); j != this->_partition.end(); ++j) {
-			for (std::vector<OLRTBlock*>::reverse_iterator j = this->_partition.rbegin(); j != this->_partition.rend(); ++j) {
-				this->_relation.data()[(*j)->index()][bint->index()] = this->_relation.data()[(*j)->index()][(*i)->index()];
-				this->_relation.data()[bint->index()][(*j)->index()] = this->_relation.data()[(*i)->index()][(*j)->index()];
-			}
+			this->inheritRelation(bint->index(), (*i)->index());
 			for (SmartSet::iterator j = bint->inset().begin(); j != bint->inset().end(); ++j) {
 				bint->counter().copyRow(*j, (*i)->counter());
 				if ((*i)->remove()[*j]) {
@@ -426,8 +427,8 @@ protected:
 					this->_tmp[block2->index()] = false;
 					for (std::vector<OLRTBlock*>::iterator k = removeList.begin(); k != removeList.end(); ++k) {
 						assert(block2->index() != (*k)->index());
-						if (this->_relation.data()[block2->index()][(*k)->index()]) {
-							this->_relation.data()[block2->index()][(*k)->index()] = false;
+						if (this->_relation.get(block2->index(), (*k)->index())) {
+							this->_relation.set(block2->index(), (*k)->index(), false);
 							for (SmartSet::iterator a = (*k)->inset().begin(); a != (*k)->inset().end(); ++a) {
 								if (block2->inset().contains(*a)) {
 									StateListElem* elem2 = (*k)->states();
@@ -497,28 +498,31 @@ public:
 			this->_delta1[a].buildVector(tmp2);
 			this->fastSplit(tmp2);
 		}
-		std::vector<std::vector<bool> > tmp[2];
-		tmp[0].resize(this->_lts->labels(), std::vector<bool>(this->_partition.size(), true));
-		tmp[1].resize(this->_lts->labels(), std::vector<bool>(this->_partition.size(), true));
+		// a block with an a-successor for all states is not simulated by
+		// a block without any a-successor
+		std::vector<bool> all(this->_relation.size());
+		std::vector<Relation::word_type> none;
 		for (size_t a = 0; a < this->_lts->labels(); ++a) {
+			this->_relation.zeroMask(none);
 			for (std::vector<OLRTBlock*>::iterator i = this->_partition.begin(); i != this->_partition.end(); ++i) {
+				bool allIn = true, noneIn = true;
 				StateListElem* elem = (*i)->states();
 				do {
-					tmp[(this->_delta1[a].contains(elem->state()))?(1):(0)][a][(*i)->index()] = false;
+					if (this->_delta1[a].contains(elem->state()))
+						noneIn = false;
+					else
+						allIn = false;
 					elem = elem->next();
 				} while (elem != (*i)->states());
+				all[(*i)->index()] = allIn;
+				if (noneIn)
+					Relation::maskSet(none, (*i)->index());
 			}
-		}
-		for (size_t a = 0; a < this->_lts->labels(); ++a) {
 			for (std::vector<OLRTBlock*>::iterator i = this->_partition.begin(); i != this->_partition.end(); ++i) {
-				if (tmp[0][a][(*i)->index()]) {
-					for (std::vector<OLRTBlock*>::iterator j = this->_partition.begin(); j != this->_partition.end(); ++j) {
-						if (tmp[1][a][(*j)->index()])
-							this->_relation.data()[(*i)->index()][(*j)->index()] = false;
-					}
-				}
-			}			
-		}		
+				if (all[(*i)->index()])
+					this->_relation.andNotRow((*i)->index(), none.data());
+			}
+		}
 		std::vector<std::vector<size_t> > post;
 //		for (std::vector<OLRTBlock*>::iterator i = this->_partition.begin(); i != this->_partition.end(); ++i) {
 		for (std::vector<OLRTBlock*>::reverse_iterator i = this->_partition.rbegin(); i != this->_partition.rend(); ++i) {
@@ -526,14 +530,14 @@ public:
 				this->_lts->buildPost(*j, post);
 				for (SmartSet::iterator k = this->_delta1[*j].begin(); k != this->_delta1[*j].end(); ++k) {
 					for (std::vector<size_t>::iterator l = post[*k].begin(); l != post[*k].end(); ++l) {
-						if (this->_relation.data()[(*i)->index()][this->_index[*l]->block()->index()])
+						if (this->_relation.get((*i)->index(), this->_index[*l]->block()->index()))
 							(*i)->counter().incr(*j, *k);
 					}
 				}
 				for (size_t k = 0; k < this->_lts->states(); ++k)
 					this->_tmp[k] = this->_delta1[*j].contains(k);
 				for (std::vector<OLRTBlock*>::iterator k = this->_partition.begin(); k != this->_partition.end(); ++k) {
-					if (this->_relation.data()[(*i)->index()][(*k)->index()]) {
+					if (this->_relation.get((*i)->index(), (*k)->index())) {
 						StateListElem* elem = (*k)->states();
 						do {
 							for (std::vector<size_t>::const_iterator l = this->_lts->dataPre()[*j][elem->state()].begin(); l != this->_lts->dataPre()[*j][elem->state()].end(); ++l)
@@ -599,7 +603,7 @@ public:
 		for (size_t i = 0; i < size; ++i) {
 			size_t ii = this->_index[i]->block()->index();
 			for (size_t j = 0; j < size; ++j)
-				rel[i][j] = this->_relation.data()[ii][this->_index[j]->block()->index()];
+				rel[i][j] = this->_relation.get(ii, this->_index[j]->block()->index());
 		}
 	}
 	
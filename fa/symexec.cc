@@ -36,6 +36,8 @@ void reportErrorNoLocation(const char* errMsg)
 
 
 // Standard library headers
+#include <cstdio>
+#include <fstream>
 #include <sstream>
 #include <vector>
 #include <list>
@@ -309,23 +311,19 @@ protected:
 			assembly_.code_.front()
 		);
 
-		SymState* state = nullptr;
-
 		try
 		{	// expecting problems...
-			while (nullptr != (state = execMan_.dequeueDFS()))
-			{	// process all states in the DFS order
-				assert(nullptr != state);
-
-				const CodeStorage::Insn* insn = state->GetInstr()->insn();
+			// process all states in the DFS order (in rounds with several threads)
+			execMan_.run(conf_.jobs, [this](const SymState& state) {
+				const CodeStorage::Insn* insn = state.GetInstr()->insn();
 				if (nullptr != insn)
 				{	// in case current instruction IS an instruction
 					FA_DEBUG_AT(2, SSD_INLINE_COLOR(C_LIGHT_RED, insn->loc << *insn));
-					FA_DEBUG_AT(2, *state);
+					FA_DEBUG_AT(2, state);
 				}
 				else
 				{
-					FA_DEBUG_AT(3, *state);
+					FA_DEBUG_AT(3, state);
 				}
 
 				if (testAndClearUserRequestFlag())
@@ -334,10 +332,7 @@ protected:
 						<< " states and " << std::setw(7) << execMan_.pathsEvaluated()
 						<< " paths so far.");
 				}
-
-				// run the state
-				execMan_.execute(*state);
-			}
+			});
 
 			return true;
 		}
@@ -430,6 +425,11 @@ protected:
 		{	// in case a restart is requested, clear all fixpoint computation points
 			clearFixpoints();
 
+			if (e.box())
+			{	// the box discovered by a thread exploring states in parallel
+				boxMan_.insertBox(*e.box());
+			}
+
 			FA_DEBUG_AT(2, e.what());
 
 			return false;
@@ -453,7 +453,14 @@ public:   // methods
 		conf_(conf),
 		dbgFlag_{false},
 		userRequestFlag_{false}
-	{ }
+	{
+		if (conf_.jobs > 1)
+		{	// the states are going to be explored by several threads
+			taBackend_.setConcurrent(true);
+			fixpointBackend_.setConcurrent(true);
+			boxMan_.setConcurrent(true);
+		}
+	}
 
 	/**
 	 * @brief  Loads types from a storage
@@ -548,23 +555,59 @@ public:   // methods
 			<< *boxMan_.getTypeInfo(GLOBAL_VARS_BLOCK_STR));
 	}
 
-#if 0
-	void loadBoxes(const std::unordered_map<std::string, std::string>& db) {
-
-		FA_DEBUG_AT(2, "loading boxes ...");
-
-		for (auto p : db) {
+	/**
+	 * @brief  Loads boxes learnt by a previous run
+	 *
+	 * This method preloads the box manager with boxes saved by saveBoxes(), so
+	 * that the analysis does not need to restart to learn them again. A missing
+	 * or broken database is not an error.
+	 *
+	 * @param[in]  fileName  The file with the database
+	 */
+	void loadBoxes(const std::string& fileName)
+	{
+		std::ifstream input(fileName.c_str());
+		if (!input.good())
+		{
+			FA_LOG("no box database in " << fileName);
+			return;
+		}
 
-			this->boxes.push_back((const Box*)boxMan_.loadBox(p.first, db));
+		try
+		{
+			const size_t cnt = boxMan_.loadBoxes(input, fileName, taBackend_);
+			FA_LOG("loaded " << cnt << " box(es) from " << fileName);
+		}
+		catch (const std::exception& e)
+		{	// keep the boxes loaded before the error
+			FA_WARN("ignoring the rest of the box database: " << e.what());
+		}
+	}
 
-			FA_DEBUG(p.first << ':' << std::endl << *(const FA*)this->boxes.back());
+	/**
+	 * @brief  Saves boxes learnt by the analysis
+	 *
+	 * This method writes all boxes of the box manager to @p fileName (through
+	 * a temporary file, so that a concurrent run never reads a partial file).
+	 *
+	 * @param[in]  fileName  The file with the database
+	 */
+	void saveBoxes(const std::string& fileName) const
+	{
+		const std::string tmpName = fileName + ".tmp";
+		std::ofstream output(tmpName.c_str());
+		const size_t cnt = boxMan_.saveBoxes(output);
+		output.close();
 
+		if (!output.good() || std::rename(tmpName.c_str(), fileName.c_str()))
+		{
+			FA_WARN("unable to write the box database to " << fileName);
+			std::remove(tmpName.c_str());
+			return;
 		}
 
-		boxMan_.buildBoxHierarchy(this->hierarchy, this->basicBoxes);
-
+		FA_LOG("saved " << cnt << " box(es) to " << fileName);
 	}
-#endif
 
 	void compile(const CodeStorage::Storage& stor, const CodeStorage::Fnc& entry)
 	{
@@ -683,11 +726,21 @@ void SymExec::loadTypes(const CodeStorage::Storage& stor)
 	this->engine->loadTypes(stor);
 }
 
-#if 0
-void SymExec::loadBoxes(const std::unordered_map<std::string, std::string>& db) {
-	this->engine->loadBoxes(db);
+void SymExec::loadBoxes(const std::string& fileName)
+{
+	// Assertions
+	assert(engine != nullptr);
+
+	this->engine->loadBoxes(fileName);
+}
+
+void SymExec::saveBoxes(const std::string& fileName) const
+{
+	// Assertions
+	assert(engine != nullptr);
+
+	this->engine->saveBoxes(fileName);
 }
-#endif
 
 const Compiler::Assembly& SymExec::GetAssembly() const
 {
@@ -21,6 +21,7 @@
 #define SYM_EXEC_H
 
 // Standard library headers
+#include <string>
 #include <unordered_map>
 
 // Forester headers
@@ -77,7 +78,25 @@ public:   // methods
 	 */
 	void loadTypes(const CodeStorage::Storage& stor);
 
-//	void loadBoxes(const std::unordered_map<std::string, std::string>& db);
+	/**
+	 * @brief  Loads boxes learnt by a previous run
+	 *
+	 * Preloads the database of boxes from the given file, so that the analysis
+	 * does not need to restart to learn them again. Types need to be loaded by
+	 * the method @p loadTypes first.
+	 *
+	 * @param[in]  fileName  The file written by the method @p saveBoxes
+	 */
+	void loadBoxes(const std::string& fileName);
+
+	/**
+	 * @brief  Saves boxes learnt by the analysis
+	 *
+	 * Writes the database of boxes to the given file (in the Timbuk format).
+	 *
+	 * @param[in]  fileName  The file to be written
+	 */
+	void saveBoxes(const std::string& fileName) const;
 
 
 	/**
@@ -154,6 +154,9 @@ public:
 
 				case 4:
 
+					if (c == EOF)
+						Error::eofUnexpected(this->name, this->lineno);
+
 					if (c == '>')
 						return this->token = tt_id;
 
@@ -162,6 +165,11 @@ public:
 
 				case 5:
 
+					if (c == EOF) {
+						this->val = "EOF";
+						return this->token = tt_eof;
+					}
+
 					if (c == '\n') {
 						++this->lineno;
 						state = 0;
@@ -360,37 +360,27 @@ void TA<T>::combinedSimulation(
 	const std::vector<std::vector<bool>>&     up)
 {
 	size_t size = dwn.size();
-	std::vector<std::vector<bool> > dut(size, std::vector<bool>(size, false));
+	Relation d, u, dut;
+	d.load(dwn);
+	u.load(up);
+	// dut = dwn o up^-1, computed row by row on whole words
+	dut.reset(size, false);
 	for (size_t i = 0; i < size; ++i)
 	{
 		for (size_t j = 0; j < size; ++j)
 		{
-			for (size_t k = 0; k < size; ++k)
-			{
-				if (dwn[i][k] && up[j][k])
-				{
-					dut[i][j] = true;
-					break;
-				}
-			}
+			if (dut.intersects(d.row(i), u.row(j)))
+				dut.set(i, j, true);
 		}
 	}
-	dst = dut;
+	// (i, j) is kept iff dwn[j] is a subset of dut[i]
+	dst.assign(size, std::vector<bool>(size, false));
 	for (size_t i = 0; i < size; ++i)
 	{
 		for (size_t j = 0; j < size; ++j)
 		{
-			if (!dst[i][j])
-				continue;
-
-			for (size_t k = 0; k < size; ++k)
-			{
-				if (dwn[j][k] && !dut[i][k])
-				{
-					dst[i][j] = false;
-					break;
-				}
-			}
+			if (dut.get(i, j) && dut.subseteq(d.row(j), dut.row(i)))
+				dst[i][j] = true;
 		}
 	}
 }
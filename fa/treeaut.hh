@@ -24,7 +24,9 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <memory>
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <stdexcept>
 
@@ -257,6 +259,17 @@ public:   // data types
 			lhsCache{},
 			transCache{}
 		{ }
+
+		/**
+		 * @brief  Allows the backend to be shared by several threads
+		 *
+		 * @param[in]  enabled  Is the backend to be shared by several threads?
+		 */
+		void setConcurrent(bool enabled)
+		{
+			lhsCache.setConcurrent(enabled);
+			transCache.setConcurrent(enabled);
+		}
 	};
 
 	struct CmpF
@@ -269,7 +282,212 @@ public:   // data types
 		}
 	};
 
-	typedef std::set<TransIDPair*, CmpF> trans_set_type;
+	/**
+	 * @brief  Set of transitions stored in a sorted contiguous array
+	 *
+	 * The set holds pointers to transitions interned in the cache of the
+	 * backend, sorted according to CmpF. Copies of the set share the array until
+	 * one of them is modified (copy-on-write). The array owns one reference to
+	 * each of its transitions, the references are acquired and released in bulk
+	 * when the array is copied or destroyed.
+	 */
+	class TransSet
+	{
+	public:   // data types
+
+		typedef std::vector<TransIDPair*> array_type;
+		typedef typename array_type::const_iterator const_iterator;
+		typedef const_iterator iterator;
+		typedef TransIDPair* value_type;
+
+	private:  // data types
+
+		struct Array
+		{
+			trans_cache_type& cache;
+			array_type data;
+
+			explicit Array(trans_cache_type& cache) :
+				cache(cache),
+				data{}
+			{ }
+
+			Array(const Array& src) :
+				cache(src.cache),
+				data(src.data)
+			{
+				cache.addRef(data.begin(), data.end());
+			}
+
+			~Array()
+			{
+				cache.release(data.begin(), data.end());
+			}
+
+		private:
+
+			Array& operator=(const Array&);
+		};
+
+	private:  // data members
+
+		std::shared_ptr<Array> array_;
+
+	private:  // methods
+
+		const array_type& data() const
+		{
+			static const array_type emptyArray;
+
+			return (array_)? array_->data : emptyArray;
+		}
+
+		/**
+		 * @brief  Makes the array exclusively owned by this set
+		 *
+		 * @param[in]  cache  The cache the transitions are interned in
+		 *
+		 * @returns  The array that may be modified
+		 */
+		array_type& unshare(trans_cache_type& cache)
+		{
+			if (!array_)
+			{
+				array_ = std::make_shared<Array>(cache);
+			}
+			else if (array_.use_count() > 1)
+			{
+				array_ = std::make_shared<Array>(*array_);
+			}
+			else
+			{
+				// use_count() is a relaxed load, so make sure the writes of
+				// the owner that has just released the array (possibly in
+				// another thread) are visible before we modify it in place
+				std::atomic_thread_fence(std::memory_order_acquire);
+			}
+
+			// Assertions
+			assert(&array_->cache == &cache);
+
+			return array_->data;
+		}
+
+	public:   // methods
+
+		TransSet() :
+			array_{}
+		{ }
+
+		const_iterator begin() const { return this->data().begin(); }
+
+		const_iterator end() const { return this->data().end(); }
+
+		size_t size() const { return this->data().size(); }
+
+		bool empty() const { return this->data().empty(); }
+
+		const_iterator lower_bound(const TransIDPair* x) const
+		{
+			return std::lower_bound(this->begin(), this->end(), x, CmpF());
+		}
+
+		/**
+		 * @brief  Inserts a transition
+		 *
+		 * In the case @p x is inserted, the set takes over the reference to @p x
+		 * held by the caller.
+		 *
+		 * @param[in]  x      The transition interned in @p cache
+		 * @param[in]  cache  The cache of transitions
+		 *
+		 * @returns  @p true if @p x was inserted, @p false if it already was in
+		 *           the set
+		 */
+		bool insert(TransIDPair* x, trans_cache_type& cache)
+		{
+			const array_type& cur = this->data();
+			if (cur.empty() || CmpF()(cur.back(), x))
+			{	// the most common case when transitions are copied in order
+				this->unshare(cache).push_back(x);
+				return true;
+			}
+
+			const_iterator i = std::lower_bound(cur.begin(), cur.end(), x, CmpF());
+			if (*i == x)
+				return false;
+
+			const size_t pos = i - cur.begin();
+			array_type& arr = this->unshare(cache);
+			arr.insert(arr.begin() + pos, x);
+			return true;
+		}
+
+		/**
+		 * @brief  Inserts all transitions of another set
+		 *
+		 * Both sets need to use the same cache. An empty set simply starts sharing
+		 * the array of @p src.
+		 *
+		 * @param[in]  src    The set of transitions to be inserted
+		 * @param[in]  cache  The cache of transitions
+		 */
+		void insert(const TransSet& src, trans_cache_type& cache)
+		{
+			if (src.empty() || (array_ == src.array_))
+				return;
+
+			if (this->empty())
+			{
+				array_ = src.array_;
+				return;
+			}
+
+			array_type& arr = this->unshare(cache);
+			const array_type& other = src.data();
+
+			array_type result;
+			result.reserve(arr.size() + other.size());
+			std::vector<TransIDPair*> added;
+
+			auto i = arr.cbegin();
+			auto j = other.cbegin();
+			while ((i != arr.cend()) && (j != other.cend()))
+			{
+				if (CmpF()(*i, *j))
+				{
+					result.push_back(*i++);
+				}
+				else if (CmpF()(*j, *i))
+				{
+					added.push_back(*j);
+					result.push_back(*j++);
+				}
+				else
+				{
+					result.push_back(*i++);
+					++j;
+				}
+			}
+
+			result.insert(result.end(), i, arr.cend());
+			added.insert(added.end(), j, other.cend());
+			result.insert(result.end(), j, other.cend());
+
+			if (added.empty())
+				return;
+
+			cache.addRef(added.begin(), added.end());
+			arr.swap(result);
+		}
+
+		void clear()
+		{
+			array_.reset();
+		}
+	};
+
+	typedef TransSet trans_set_type;
 
 	/**
 	 * @brief  Iterator over transitions
@@ -409,11 +627,6 @@ public:
 		{	// copy final states (if desired)
 			finalStates_ = ta.finalStates_;
 		}
-
-		for (TransIDPair* trans : this->transitions)
-		{	// copy transitions
-			this->transCache().addRef(trans);
-		}
 	}
 
 	template <class F>
@@ -454,7 +667,7 @@ public:
 	TransIDPair* internalAdd(const Transition& t)
 	{
 		TransIDPair* x = this->transCache().lookup(t);
-		if (this->transitions.insert(x).second)
+		if (this->transitions.insert(x, this->transCache()))
 		{
 			if (t.lhs().size() > this->maxRank)
 				this->maxRank = t.lhs().size();
@@ -548,11 +761,6 @@ public:
 		this->transitions = rhs.transitions;
 		finalStates_ = rhs.finalStates_;
 
-		for (TransIDPair* trans : this->transitions)
-		{	// copy transitions
-			this->transCache().addRef(trans);
-		}
-
 		return *this;
 	}
 
@@ -560,10 +768,6 @@ public:
 	{
 		this->maxRank = 0;
 		nextState_ = 0;
-		for (TransIDPair* trans : this->transitions)
-		{
-			this->transCache().release(trans);
-		}
 		this->transitions.clear();
 		finalStates_.clear();
 	}
@@ -722,6 +926,29 @@ public:
 		return this->internalAdd(Transition(transition->first, index, this->lhsCache()));
 	}
 
+	/**
+	 * @brief  Adds all transitions of another tree automaton
+	 *
+	 * In the case both automata use the same backend, the sorted arrays of
+	 * transitions are merged (or simply shared if this automaton has no
+	 * transitions).
+	 *
+	 * @param[in]  src  The tree automaton whose transitions are to be added
+	 */
+	void addTransitions(const TA<T>& src)
+	{
+		if (src.backend != this->backend)
+		{
+			for (const TransIDPair* trans : src.transitions)
+				this->addTransition(trans);
+
+			return;
+		}
+
+		this->transitions.insert(src.transitions, this->transCache());
+		this->maxRank = std::max(this->maxRank, src.maxRank);
+	}
+
 	const TransIDPair* addTransition(const Transition& transition)
 	{
 		return this->internalAdd(Transition(transition, this->lhsCache()));
@@ -1507,8 +1734,7 @@ public:
 	 */
 	TA& copyTransitions(TA<T>& dst) const
 	{
-		for (const TransIDPair* trans : this->transitions)
-			dst.addTransition(trans);
+		dst.addTransitions(*this);
 		return dst;
 	}
 
@@ -1542,11 +1768,8 @@ public:
 		for (size_t state : b.finalStates_)
 			dst.addFinalState(state);
 
-		for (const TransIDPair* trans : a.transitions)
-			dst.addTransition(trans);
-
-		for (const TransIDPair* trans : b.transitions)
-			dst.addTransition(trans);
+		dst.addTransitions(a);
+		dst.addTransitions(b);
 
 		return dst;
 	}
@@ -1562,8 +1785,7 @@ public:
 				dst.addFinalState(state);
 		}
 
-		for (const TransIDPair* trans : src.transitions)
-			dst.addTransition(trans);
+		dst.addTransitions(src);
 
 		return dst;
 	}
@@ -23,6 +23,7 @@
 // Standard library headers
 #include <vector>
 #include <ostream>
+#include <unordered_map>
 
 // Forester headers
 #include "utils.hh"
@@ -40,6 +41,14 @@
  */
 class UFAE
 {
+public:   // data types
+
+	typedef TreeAut::Transition Transition;
+
+	/// root transitions of the automaton grouped by their labels
+	typedef std::unordered_map<label_type, std::vector<const Transition*>>
+		RootIndex;
+
 private:  // data members
 
 	/// The tree automaton
@@ -51,6 +60,53 @@ private:  // data members
 	/// Manager of boxes
 	BoxMan& boxMan_;
 
+	/// Cached top-down index of transitions of the tree automaton
+	TreeAut::td_cache_type tdCache_;
+
+	/// Cached transitions into the root state 0, grouped by their labels
+	RootIndex rootIndex_;
+
+	/// Are @p tdCache_ and @p rootIndex_ up to date?
+	bool indexed_;
+
+private:  // methods
+
+	/**
+	 * @brief  Adds a transition of the tree automaton into the indices
+	 */
+	void indexTransition(const Transition& trans)
+	{
+		tdCache_[trans.rhs()].push_back(&trans);
+		if (0 == trans.rhs())
+			rootIndex_[trans.label()].push_back(&trans);
+	}
+
+	/**
+	 * @brief  Builds the cached indices if they are not up to date
+	 */
+	void buildIndex()
+	{
+		if (indexed_)
+			return;
+
+		tdCache_.clear();
+		rootIndex_.clear();
+		for (const Transition& trans : backend_)
+			this->indexTransition(trans);
+
+		indexed_ = true;
+	}
+
+	/**
+	 * @brief  Drops the cached indices, they are rebuilt on the next lookup
+	 */
+	void invalidateIndex()
+	{
+		tdCache_.clear();
+		rootIndex_.clear();
+		indexed_ = false;
+	}
+
 public:   // methods
 
 	UFAE(
@@ -58,7 +114,10 @@ public:   // methods
 		BoxMan&                     boxMan) :
     backend_(backend),
 		stateOffset_(1),
-		boxMan_(boxMan)
+		boxMan_(boxMan),
+		tdCache_{},
+		rootIndex_{},
+		indexed_(false)
 	{
 		// let 0 be the only accepting state
 		backend_.addFinalState(0);
@@ -71,6 +130,42 @@ public:   // methods
 	{
 		backend_.addFinalState(0);
 		stateOffset_ = 1;
+		this->invalidateIndex();
+	}
+
+	/**
+	 * @brief  Retrieves the top-down index of the tree automaton
+	 *
+	 * The index is cached until the tree automaton changes, i.e. it is built
+	 * once per extension of the fixpoint at most.
+	 *
+	 * @returns  The index mapping states to transitions leading into them
+	 */
+	const TreeAut::td_cache_type& getTDCache()
+	{
+		this->buildIndex();
+		return tdCache_;
+	}
+
+	/**
+	 * @brief  Retrieves root transitions of forest automata of given shape
+	 *
+	 * @param[in]  rootCount  The number of components of the forest automata
+	 * @param[in]  vars       Global variables of the forest automata
+	 *
+	 * @returns  Transitions into the root state 0 over the label describing
+	 *           @p rootCount components and @p vars, in the order of the tree
+	 *           automaton
+	 */
+	const std::vector<const Transition*>& getRootTransitions(
+		size_t                      rootCount,
+		const DataArray&            vars)
+	{
+		static const std::vector<const Transition*> noTransitions;
+
+		this->buildIndex();
+		auto it = rootIndex_.find(boxMan_.lookupLabel(rootCount, vars));
+		return (rootIndex_.end() == it)? noTransitions : it->second;
 	}
 
 	/**
@@ -153,6 +248,18 @@ public:   // methods
 	{
 		TreeAut::disjointUnion(backend_, src, false);
 		stateOffset_ += index.size();
+		this->invalidateIndex();
+	}
+
+	/**
+	 * @brief  Replaces the tree automaton by its minimized version
+	 */
+	void minimize()
+	{
+		TreeAut ta(*backend_.backend);
+		backend_.minimized(ta);
+		backend_ = ta;
+		this->invalidateIndex();
 	}
 
 	void adjust(const Index<size_t>& index)
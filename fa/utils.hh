@@ -277,6 +277,54 @@ public:   // methods
 	}
 };
 
+/**
+ * @brief  Guard of a mutex that is locked only on request
+ *
+ * This class behaves similar to @p std::lock_guard, but it locks the mutex only
+ * in the case it is constructed with @p enabled set. It is used by data
+ * structures that are shared among threads only in the parallel mode, so that
+ * the sequential mode does not pay for locking.
+ */
+template <class T>
+class OptLockGuard
+{
+private:  // data members
+
+	/// The locked mutex (or @p nullptr if nothing is locked)
+	T* mutex_;
+
+private:  // methods
+
+	OptLockGuard(const OptLockGuard&);
+	OptLockGuard& operator=(const OptLockGuard&);
+
+public:   // methods
+
+	/**
+	 * @brief  Constructor
+	 *
+	 * @param[in]  mutex    The mutex to be locked
+	 * @param[in]  enabled  Is the mutex to be locked?
+	 */
+	OptLockGuard(T& mutex, bool enabled) :
+		mutex_(enabled? &mutex : nullptr)
+	{
+		if (mutex_)
+			mutex_->lock();
+	}
+
+	/**
+	 * @brief  Destructor
+	 *
+	 * Unlocks the mutex (if it has been locked).
+	 */
+	~OptLockGuard()
+	{
+		if (mutex_)
+			mutex_->unlock();
+	}
+};
+
 template <class T>
 struct ContWrapper {
 
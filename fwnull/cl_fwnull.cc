@@ -25,9 +25,9 @@
 #include <cl/storage.hh>
 
 #include <map>
-#include <queue>
-#include <set>
+#include <vector>
 
+#include <boost/dynamic_bitset.hpp>
 #include <boost/foreach.hpp>
 
 // required by the gcc plug-in API
@@ -61,38 +61,213 @@ typedef const CodeStorage::TTargetList                  TTargetList;
 typedef const CodeStorage::Block                       *TBlock;
 typedef const CodeStorage::Insn                        *TInsn;
 
-/// state of variable (scope of its validity is basic block)
-struct VarState {
-    EVarState           code;   ///< current state (valid per current block)
-    TLoc                loc;    ///< location where the state became valid
-    TVar                peer;   ///< used only for VS_NULL_IFF, VS_NOT_NULL_IFF
+/// one bit per variable of a function, addressed by its dense index
+typedef boost::dynamic_bitset<>                         TBits;
 
-    VarState():
-        code(VS_UNDEF),
-        loc(0),
-        peer(-1)
-    {
-    }
+/// count of bit-vectors needed to encode an EVarState value
+const unsigned cntCodeBits = 4;
+
+/// dense numbering (1..n) of the variables used by a function
+class VarIndex {
+    public:
+        /// index shared by all operands that are not variables
+        static const unsigned noVar = 0;
+
+        VarIndex(
+                const CodeStorage::ControlFlow &cfg,
+                const CodeStorage::WtoScheduler &sched);
+
+        /// count of indices, including VarIndex::noVar
+        unsigned size() const { return size_; }
+
+        /// dense indices of operands of the given block, in the order of insns
+        const unsigned* operandsOf(const unsigned idxBlock) const {
+            return idxs_.data() + offsets_[idxBlock];
+        }
+
+    private:
+        unsigned                size_;
+        std::vector<unsigned>   idxs_;      ///< dense index per each operand
+        std::vector<unsigned>   offsets_;   ///< first operand per each block
 };
 
-typedef std::map<TVar, VarState>                        TState;
+const unsigned VarIndex::noVar;
+
+VarIndex::VarIndex(
+        const CodeStorage::ControlFlow  &cfg,
+        const CodeStorage::WtoScheduler &sched):
+    size_(1),
+    offsets_(cfg.size())
+{
+    // the uid-based lookup is needed only until each operand is resolved
+    typedef std::map<TVar, unsigned>                    TMap;
+    TMap byUid;
+
+    BOOST_FOREACH(const TBlock bb, cfg) {
+        offsets_[sched.indexOf(bb)] = idxs_.size();
+        BOOST_FOREACH(const TInsn insn, *bb) {
+            BOOST_FOREACH(TOperand &op, insn->operands) {
+                if (CL_OPERAND_VAR != op.code) {
+                    idxs_.push_back(noVar);
+                    continue;
+                }
+
+                const TVar uid = varIdFromOperand(&op);
+                const std::pair<TMap::iterator, bool> ret =
+                    byUid.insert(TMap::value_type(uid, size_));
+                if (ret.second)
+                    ++size_;
+
+                idxs_.push_back(ret.first->second);
+            }
+        }
+    }
+}
+
+/**
+ * state of all variables of a function (scope of its validity is basic block)
+ *
+ * The EVarState value of each variable is encoded in binary, bit by bit, into
+ * cntCodeBits bit-vectors.  The set of variables in a given state is then
+ * obtained by a few word-wide operations, which is what mergeStates() uses.
+ */
+class State {
+    public:
+        State() { }
+
+        State(const unsigned cntVars):
+            locs_(cntVars, static_cast<TLoc>(0)),
+            peers_(cntVars, VarIndex::noVar)
+        {
+            for (unsigned bit = 0; bit < cntCodeBits; ++bit)
+                codes_[bit].resize(cntVars);
+        }
+
+        /// return state of the variable with the given dense index
+        EVarState code(const unsigned idx) const {
+            int code = 0;
+            for (unsigned bit = 0; bit < cntCodeBits; ++bit)
+                if (codes_[bit][idx])
+                    code |= (1 << bit);
+
+            return static_cast<EVarState>(code);
+        }
+
+        /// location where the state of the variable became valid
+        TLoc loc(const unsigned idx) const      { return locs_[idx]; }
+
+        /// used only for VS_NULL_IFF, VS_NOT_NULL_IFF
+        unsigned peer(const unsigned idx) const { return peers_[idx]; }
+
+        void setCode(const unsigned idx, const EVarState code) {
+            for (unsigned bit = 0; bit < cntCodeBits; ++bit)
+                codes_[bit][idx] = !!(code & (1 << bit));
+        }
+
+        void set(const unsigned idx, const EVarState code, const TLoc loc) {
+            this->setCode(idx, code);
+            locs_[idx] = loc;
+        }
+
+        void setPeer(const unsigned idx, const unsigned peer) {
+            peers_[idx] = peer;
+        }
+
+        /// copy state of the variable @b src to the variable @b dst
+        void copyVar(const unsigned dst, const State &from, const unsigned src)
+        {
+            this->set(dst, from.code(src), from.loc(src));
+            peers_[dst] = from.peers_[src];
+        }
+
+        /// return the set of variables in the given state
+        TBits varsIn(const EVarState code) const {
+            TBits vars(locs_.size());
+            vars.set();
+            for (unsigned bit = 0; bit < cntCodeBits; ++bit) {
+                if (code & (1 << bit))
+                    vars &= codes_[bit];
+                else
+                    vars -= codes_[bit];
+            }
+
+            return vars;
+        }
+
+        /// return the set of variables that are in the same state in both
+        TBits varsSameAs(const State &other) const {
+            TBits vars(locs_.size());
+            vars.set();
+            for (unsigned bit = 0; bit < cntCodeBits; ++bit)
+                vars -= (codes_[bit] ^ other.codes_[bit]);
+
+            return vars;
+        }
+
+        /// put all the given variables into the given state
+        void setCodeOf(const TBits &vars, const EVarState code) {
+            for (unsigned bit = 0; bit < cntCodeBits; ++bit) {
+                if (code & (1 << bit))
+                    codes_[bit] |= vars;
+                else
+                    codes_[bit] -= vars;
+            }
+        }
+
+        /// copy state of all the given variables from another state
+        void copyVars(const TBits &vars, const State &from) {
+            for (unsigned bit = 0; bit < cntCodeBits; ++bit) {
+                codes_[bit] -= vars;
+                codes_[bit] |= (from.codes_[bit] & vars);
+            }
+
+            for (TBits::size_type idx = vars.find_first();
+                    TBits::npos != idx; idx = vars.find_next(idx))
+            {
+                locs_[idx]  = from.locs_[idx];
+                peers_[idx] = from.peers_[idx];
+            }
+        }
+
+    private:
+        TBits                   codes_[cntCodeBits];
+        std::vector<TLoc>       locs_;
+        std::vector<unsigned>   peers_;
+};
 
 /// state of computation at function level
 struct Data {
-    typedef std::queue<TBlock>                          TSched;
-    typedef std::set<TBlock>                            TSchedLookup;
-    typedef std::map<TBlock, TState>                    TStateMap;
+    typedef CodeStorage::WtoScheduler                 TSched;
+    typedef std::vector<State>                          TStateMap;
 
     TSched          todo;       ///< block scheduled for processing
-    TSchedLookup    todoLookup; ///< block scheduled for processing
+    VarIndex        varIndex;   ///< dense numbering of variables of the fnc
     TStateMap       stateMap;   ///< holds states of all vars per each block
-    TState          localState; ///< holds intermediate state between insns
+    State           localState; ///< holds intermediate state between insns
     bool            silent;     ///< if true, do not print diagnostic messages
 
-    Data():
-        silent(true)
+    TOperand       *opBase;     ///< operands of the current instruction
+    const unsigned *opIdx;      ///< dense indices of the operands above
+
+    Data(const CodeStorage::ControlFlow &cfg):
+        todo(cfg),
+        varIndex(cfg, todo),
+        stateMap(cfg.size(), State(varIndex.size())),
+        silent(true),
+        opBase(0),
+        opIdx(0)
     {
     }
+
+    /// return the state of all variables at the entry of the given block
+    State& blockState(const TBlock bb) {
+        return stateMap[todo.indexOf(bb)];
+    }
+
+    /// return dense index of an operand of the current instruction
+    unsigned varOf(TOperand &op) const {
+        return opIdx[&op - opBase];
+    }
 };
 
 /**
@@ -105,14 +280,13 @@ void handleVarDeref(
         TOperand                   *op,
         const TLoc                  loc)
 {
-    const TVar uid = varIdFromOperand(op);
-    VarState &vs = data.localState[uid];
-    const EVarState code = vs.code;
+    State &state = data.localState;
+    const unsigned idx = data.varOf(*op);
+    const EVarState code = state.code(idx);
     switch (code) {
         case VS_UNDEF:
         case VS_UNKNOWN:
-            vs.code = VS_DEREF;
-            vs.loc  = loc;
+            state.set(idx, VS_DEREF, loc);
             // fall through!
 
         case VS_NOT_NULL:
@@ -130,16 +304,18 @@ void handleVarDeref(
     switch (code) {
         case VS_NULL:
             CL_ERROR_MSG(loc, "dereference of NULL value");
-            CL_NOTE_MSG(vs.loc, "the NULL value comes from here");
+            CL_NOTE_MSG(state.loc(idx), "the NULL value comes from here");
             return;
 
         case VS_NULL_DEDUCED:
             CL_ERROR_MSG(loc, "dereference of NULL value");
-            CL_NOTE_MSG(vs.loc, "the condition seems to be used incorrectly");
+            CL_NOTE_MSG(state.loc(idx),
+                    "the condition seems to be used incorrectly");
 
         case VS_MIGHT_BE_NULL:
             CL_WARN_MSG(loc, "dereference of a value that might be NULL");
-            CL_NOTE_MSG(vs.loc, "the same value was compared with NULL here");
+            CL_NOTE_MSG(state.loc(idx),
+                    "the same value was compared with NULL here");
             return;
 
         default:
@@ -180,45 +356,91 @@ inline bool anyNotNull(const EVarState code)
 }
 
 /**
- * merge values (used for Y nodes of CFG)
- * @param dst destination state (used in read-write mode)
- * @param src source state (used in read-only mode)
+ * merge values of two variables (used for assignments)
+ * @param state state valid per current instruction
+ * @param dst dense index of the destination variable (read-write mode)
+ * @param src dense index of the source variable (read-only mode)
  */
-bool mergeValues(VarState &dst, const VarState &src)
+bool mergeValues(State &state, const unsigned dst, const unsigned src)
 {
-    if (VS_UNDEF == src.code || VS_MIGHT_BE_NULL == dst.code)
+    const EVarState srcCode = state.code(src);
+    const EVarState dstCode = state.code(dst);
+    if (VS_UNDEF == srcCode || VS_MIGHT_BE_NULL == dstCode)
         // nothing to propagate actually
         return false;
 
-    if (src.code == dst.code)
+    if (srcCode == dstCode)
         // codes match already
         return false;
 
-    if (VS_NULL_IFF == src.code || VS_NOT_NULL_IFF == src.code
-            || VS_NULL_IFF == dst.code || VS_NOT_NULL_IFF == dst.code)
+    if (VS_NULL_IFF == srcCode || VS_NOT_NULL_IFF == srcCode
+            || VS_NULL_IFF == dstCode || VS_NOT_NULL_IFF == dstCode)
         // we use these only block-locally
         return false;
 
-    if (VS_UNDEF == dst.code) {
+    if (VS_UNDEF == dstCode) {
         // value not defined in the target block, let's start with the new one
-        dst = src;
+        state.copyVar(dst, state, src);
         return true;
     }
 
-    if ((VS_NULL_DEDUCED == src.code && anyNotNull(dst.code))
-            || (anyNotNull(src.code) && VS_NULL_DEDUCED == dst.code))
+    if ((VS_NULL_DEDUCED == srcCode && anyNotNull(dstCode))
+            || (anyNotNull(srcCode) && VS_NULL_DEDUCED == dstCode))
         // merge NULL and not-NULL alternatives together
     {
-        dst.code = VS_MIGHT_BE_NULL;
+        state.setCode(dst, VS_MIGHT_BE_NULL);
         return true;
     }
 
-    if (VS_UNKNOWN == dst.code)
+    if (VS_UNKNOWN == dstCode)
         // no news is good news
         return false;
 
     // let's over-approximate everything else
-    dst.code = VS_UNKNOWN;
+    state.setCode(dst, VS_UNKNOWN);
+    return true;
+}
+
+/**
+ * merge states of all variables (used for Y nodes of CFG), the same rules as
+ * in mergeValues() apply to each variable, only evaluated word by word
+ * @param dst destination state (used in read-write mode)
+ * @param src source state (used in read-only mode)
+ */
+bool mergeStates(State &dst, const State &src)
+{
+    // nothing to propagate, codes match already, or used only block-locally
+    TBits todo = ~(src.varsIn(VS_UNDEF)
+            | dst.varsIn(VS_MIGHT_BE_NULL)
+            | dst.varsSameAs(src)
+            | src.varsIn(VS_NULL_IFF) | src.varsIn(VS_NOT_NULL_IFF)
+            | dst.varsIn(VS_NULL_IFF) | dst.varsIn(VS_NOT_NULL_IFF));
+
+    // value not defined in the target block, let's start with the new one
+    const TBits undef = todo & dst.varsIn(VS_UNDEF);
+    todo -= undef;
+
+    // merge NULL and not-NULL alternatives together
+    const TBits srcNotNull =
+        src.varsIn(VS_NOT_NULL) | src.varsIn(VS_NOT_NULL_DEDUCED);
+    const TBits dstNotNull =
+        dst.varsIn(VS_NOT_NULL) | dst.varsIn(VS_NOT_NULL_DEDUCED);
+    const TBits mightBeNull = todo
+        & ((src.varsIn(VS_NULL_DEDUCED) & dstNotNull)
+                | (srcNotNull & dst.varsIn(VS_NULL_DEDUCED)));
+    todo -= mightBeNull;
+
+    // no news is good news
+    todo -= dst.varsIn(VS_UNKNOWN);
+
+    if (undef.none() && mightBeNull.none() && todo.none())
+        return false;
+
+    dst.copyVars(undef, src);
+    dst.setCodeOf(mightBeNull, VS_MIGHT_BE_NULL);
+
+    // let's over-approximate everything else
+    dst.setCodeOf(todo, VS_UNKNOWN);
     return true;
 }
 
@@ -237,13 +459,13 @@ void handleInsnUnop(Data &data, const TInsn insn)
         return;
 
     // resolve state of the variable
-    const TVar uid = varIdFromOperand(&dst);
-    VarState &vs = data.localState[uid];
+    State &state = data.localState;
+    const unsigned idx = data.varOf(dst);
 
     const enum cl_unop_e code = static_cast<enum cl_unop_e>(insn->subCode);
     if (CL_UNOP_ASSIGN != code) {
         // we abstract out everything but CL_UNOP_ASSIGN
-        vs.code = VS_UNKNOWN;
+        state.setCode(idx, VS_UNKNOWN);
         return;
     }
 
@@ -253,45 +475,42 @@ void handleInsnUnop(Data &data, const TInsn insn)
 
     if (seekRefAccessor(ac)) {
         // assignment of address of an object implies not-NULL value
-        vs.code = VS_NOT_NULL;
-        vs.loc  = &insn->loc;
+        state.set(idx, VS_NOT_NULL, &insn->loc);
         return;
     }
 
     if (ac || CL_TYPE_PTR != src.type->code) {
         // we abstract out everything but pointers
-        vs.code = VS_UNKNOWN;
+        state.setCode(idx, VS_UNKNOWN);
         return;
     }
 
     if (CL_OPERAND_CST == src.code) {
         if (CL_TYPE_INT != src.data.cst.code || intCstFromOperand(&src)) {
-            vs.code = VS_UNKNOWN;
+            state.setCode(idx, VS_UNKNOWN);
             return;
         }
 
         // looks like assignment of NULL to a variable
-        vs.code = VS_NULL;
-        vs.loc  = &insn->loc;
+        state.set(idx, VS_NULL, &insn->loc);
         return;
     }
 
     // single assignment ... let's just propagate the value
-    const TVar uidSrc = varIdFromOperand(&src);
-    mergeValues(vs, data.localState[uidSrc]);
+    mergeValues(state, idx, data.varOf(src));
 }
 
 /**
  * handle comparison of a pointer with NULL
  * @param data state of computation per current function
- * @param vsDst reference to state of destination variable
+ * @param idxDst dense index of the destination variable
  * @param src the operand that is not NULL
  * @param loc location info of the current instruction
  * @param neg if true, we deal with !=; == otherwise
  */
 bool handleInsnCmpNull(
         Data                       &data,
-        VarState                   &vsDst,
+        const unsigned              idxDst,
         TOperand                   *src,
         const TLoc                  loc,
         bool                        neg)
@@ -304,9 +523,9 @@ bool handleInsnCmpNull(
         // we're interested only in pointers comparison here
         return false;
 
-    const TVar uidSrc = varIdFromOperand(src);
-    const VarState &vsSrc = data.localState[uidSrc];
-    const EVarState code = vsSrc.code;
+    State &state = data.localState;
+    const unsigned idxSrc = data.varOf(*src);
+    const EVarState code = state.code(idxSrc);
     switch (code) {
         case VS_NULL:
         case VS_NULL_DEDUCED:
@@ -326,7 +545,8 @@ bool handleInsnCmpNull(
             if (data.silent)
                 break;
             CL_WARN_MSG(loc, "comparing pointer with NULL");
-            CL_NOTE_MSG(vsSrc.loc, "the pointer was already dereferenced here");
+            CL_NOTE_MSG(state.loc(idxSrc),
+                    "the pointer was already dereferenced here");
             break;
 
         default:
@@ -334,21 +554,13 @@ bool handleInsnCmpNull(
     }
 
     // now store the relation among the pointer and the result of the comparison
-    vsDst.code = (neg)
-        ? VS_NOT_NULL_IFF
-        : VS_NULL_IFF;
-
-    vsDst.peer = uidSrc;
-    vsDst.loc  = loc;
+    state.set(idxDst, (neg) ? VS_NOT_NULL_IFF : VS_NULL_IFF, loc);
+    state.setPeer(idxDst, idxSrc);
     return true;
 
 we_know:
     // we already know the result of the comparison at this point
-    vsDst.code = (neg)
-        ? VS_TRUE
-        : VS_FALSE;
-
-    vsDst.loc = loc;
+    state.set(idxDst, (neg) ? VS_TRUE : VS_FALSE, loc);
     return true;
 }
 
@@ -373,8 +585,7 @@ void handleInsnBinop(Data &data, const TInsn insn)
     // resolve operands
     TOperand &dst = opList[0];
     CL_BREAK_IF(dst.accessor);
-    const TVar uidDst = varIdFromOperand(&dst);
-    VarState &vs = data.localState[uidDst];
+    const unsigned idxDst = data.varOf(dst);
 
     TOperand &src1 = opList[1];
     TOperand &src2 = opList[2];
@@ -411,12 +622,12 @@ void handleInsnBinop(Data &data, const TInsn insn)
         src = &src1;
     }
 
-    if (handleInsnCmpNull(data, vs, src, &insn->loc, (CL_BINOP_NE == code)))
+    if (handleInsnCmpNull(data, idxDst, src, &insn->loc, (CL_BINOP_NE == code)))
         // properly handled pointer comparison with NULL
         return;
 
 who_knows:
-    vs.code = VS_UNKNOWN;
+    data.localState.setCode(idxDst, VS_UNKNOWN);
 }
 
 /**
@@ -435,18 +646,16 @@ void handleInsnCall(Data &data, const TInsn insn)
         return;
 
     // abstract out the return value
-    const TVar uid = varIdFromOperand(&dst);
-    VarState &vs = data.localState[uid];
-    vs.code = VS_UNKNOWN;
+    data.localState.setCode(data.varOf(dst), VS_UNKNOWN);
 }
 
 /**
  * abstract out any reasoning in case of direct reference of an operand
- * @param state state valid per current instruction
+ * @param data state of computation per current function
  * @param opList list of operands to check for direct references
  */
 void treatRefAsSideEffect(
-        TState                     &state,
+        Data                       &data,
         TOperandList               &opList)
 {
     // for each operand
@@ -461,8 +670,7 @@ void treatRefAsSideEffect(
             continue;
 
         // kill any up to now reasoning about the variable
-        const TVar uid = varIdFromOperand(&op);
-        state[uid].code = VS_UNKNOWN;
+        data.localState.setCode(data.varOf(op), VS_UNKNOWN);
     }
 }
 
@@ -473,7 +681,7 @@ void treatRefAsSideEffect(
  */
 void handleInsnNonterm(Data &data, const TInsn insn)
 {
-    treatRefAsSideEffect(data.localState, insn->operands);
+    treatRefAsSideEffect(data, insn->operands);
 
     const enum cl_insn_e code = insn->code;
     switch (code) {
@@ -507,36 +715,25 @@ void handleInsnNonterm(Data &data, const TInsn insn)
  */
 void updateState(
         Data                       &data,
-        const TState               &state,
+        const State                &state,
         const TBlock                block)
 {
-    // target state
-    TState &dstState = data.stateMap[block];
-
-    // for each variable
-    bool changed = false;
-    BOOST_FOREACH(TState::const_reference item, state) {
-        if (mergeValues(dstState[item.first], item.second))
-            changed = true;
-    }
-
-    if (changed && data.todoLookup.insert(block)./* not already in */second)
-        data.todo.push(block);
+    if (mergeStates(data.blockState(block), state))
+        data.todo.schedule(block);
 }
 
 /**
  * replace state of the branch-by variable by VS_NULL_DEDUCED or
  * VS_NOT_NULL_DEDUCED
  * @param state state valid per current instruction
- * @param uid CodeStorage uid of the branch-by variable
+ * @param idx dense index of the branch-by variable
  * @param val true in 'then' branch, false in 'else' branch
  */
-void replaceInBranch(TState &state, const TVar uid, bool val)
+void replaceInBranch(State &state, const unsigned idx, bool val)
 {
-    VarState &vs = state[uid];
     bool isNull;
 
-    const EVarState code = vs.code;
+    const EVarState code = state.code(idx);
     switch (code) {
         case VS_NULL_IFF:
             isNull = val;
@@ -556,37 +753,35 @@ void replaceInBranch(TState &state, const TVar uid, bool val)
     }
 
     // kill the pending condition predicate
-    vs.code = VS_UNDEF;
+    state.setCode(idx, VS_UNDEF);
 
     // update state of the pointer accordingly
-    VarState &vsPeer = state[vs.peer];
-    vsPeer.loc = vs.loc;
-    vsPeer.code = (isNull)
-        ? VS_NULL_DEDUCED
-        : VS_NOT_NULL_DEDUCED;
+    state.set(state.peer(idx), (isNull)
+            ? VS_NULL_DEDUCED
+            : VS_NOT_NULL_DEDUCED,
+            state.loc(idx));
 }
 
 /**
  * handle a condition for which we don't know the branch-by value
  * @param data state of computation per current function
  * @param state state valid per current instruction
- * @param cond branch-by variable given as operand
+ * @param idx dense index of the branch-by variable
  * @param targets then/else targets of the condition
  */
 void handleInsnCondNondet(
         Data                       &data,
-        const TState               &state,
-        TOperand                   &cond,
+        const State                &state,
+        const unsigned              idx,
         TTargetList                &targets)
 {
     // local copies of the state
-    TState stateThen(state);
-    TState stateElse(state);
+    State stateThen(state);
+    State stateElse(state);
 
     // reflect the value of branch-by variable (if possible)
-    const TVar uid = varIdFromOperand(&cond);
-    replaceInBranch(stateThen, uid, true);
-    replaceInBranch(stateElse, uid, false);
+    replaceInBranch(stateThen, idx, true);
+    replaceInBranch(stateElse, idx, false);
 
     // go to both targets and update the state there
     updateState(data, stateThen, targets[0]);
@@ -603,12 +798,11 @@ void handleInsnCond(
 {
     // resolve branch-by operand
     TOperand &cond = insn->operands[0];
-    TState &state = data.localState;
-    const TVar uid = varIdFromOperand(&cond);
-    const VarState &vs = state[uid];
+    State &state = data.localState;
+    const unsigned idx = data.varOf(cond);
 
     // now check if we know the value
-    const EVarState code = vs.code;
+    const EVarState code = state.code(idx);
     switch (code) {
         case VS_TRUE:
             updateState(data, state, insn->targets[0]);
@@ -619,7 +813,7 @@ void handleInsnCond(
             return;
 
         default:
-            handleInsnCondNondet(data, state, cond, insn->targets);
+            handleInsnCondNondet(data, state, idx, insn->targets);
             return;
     }
 }
@@ -656,9 +850,13 @@ void handleInsnTerm(
 
 void handleBlock(Data &data, const TBlock bb)
 {
+    const unsigned idxBlock = data.todo.indexOf(bb);
+    data.opIdx = data.varIndex.operandsOf(idxBlock);
+
     // go through the sequence of instructions of the current basic block
-    data.localState = data.stateMap[bb];
+    data.localState = data.stateMap[idxBlock];
     BOOST_FOREACH(const TInsn insn, *bb) {
+        data.opBase = insn->operands.data();
         if (cl_is_term_insn(insn->code))
             // terminal instruction
             handleInsnTerm(data, insn);
@@ -666,25 +864,21 @@ void handleBlock(Data &data, const TBlock bb)
         else
             // nonterminal instruction
             handleInsnNonterm(data, insn);
+
+        data.opIdx += insn->operands.size();
     }
 }
 
 void handleFnc(const CodeStorage::Fnc &fnc)
 {
-    Data data;
-    Data::TSched &todo = data.todo;
     const CodeStorage::ControlFlow &cfg = fnc.cfg;
+    Data data(cfg);
+    Data::TSched &todo = data.todo;
 
-    // block-level scheduler
+    // block-level scheduler, blocks are taken in weak topological order
     TBlock bb = cfg.entry();
-    todo.push(bb);
-    data.todoLookup.insert(bb);
-    while (!todo.empty()) {
-        bb = todo.front();
-        todo.pop();
-        if (1 != data.todoLookup.erase(bb))
-            CL_BREAK_IF("BlockScheduler malfunction");
-
+    todo.schedule(bb);
+    while (todo.next(bb)) {
         // process one basic block
         CL_BREAK_IF(!bb || !bb->size());
         const TInsn insn = bb->front();
@@ -692,6 +886,10 @@ void handleFnc(const CodeStorage::Fnc &fnc)
         handleBlock(data, bb);
     }
 
+    CL_DEBUG_MSG(locationOf(fnc), "fixed-point of " << nameOf(fnc)
+            << "() reached after " << todo.cntVisits() << " visits of "
+            << todo.cntBlocksVisited() << " blocks");
+
     // finally report all errors/warning over the already computed fixed-point
     data.silent = false;
     BOOST_FOREACH(const TBlock bb, cfg)
@@ -199,6 +199,20 @@ void cl_note(const char *msg);
  */
 void cl_die(const char *msg);
 
+/**
+ * count of error messages emitted by the current process so far
+ *
+ * @returns  Count of error messages passed to cl peer (repeats not counted)
+ */
+int cl_cnt_errors(void);
+
+/**
+ * count of warning messages emitted by the current process so far
+ *
+ * @returns  Count of warning messages passed to cl peer (repeats not counted)
+ */
+int cl_cnt_warnings(void);
+
 /**
  * current debugging level
  *
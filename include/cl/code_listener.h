@@ -968,6 +968,20 @@ void cl_chain_append(
         struct cl_code_listener         *chain,
         struct cl_code_listener         *listener);
 
+/**
+ * run the analyzer behind the "easy" code listener on a CodeStorage image
+ * previously written by the "dump_storage" code listener, without the need
+ * to replay the code listener callbacks
+ * @param file_names Path to the image to be loaded.  If a comma-separated list
+ * of images is given, the images are linked into a single storage of the whole
+ * program, so that calls across translation units can be followed.
+ * @param jobs Count of threads used to link the images.
+ * @param config_string The same as listener_args of the "easy" listener.
+ * @return Returns false if the images could not be loaded.
+ */
+bool cl_easy_run_on_storage(const char *file_names, int jobs,
+                            const char *config_string);
+
 #ifdef __cplusplus
 }
 #endif
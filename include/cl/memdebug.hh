@@ -20,6 +20,7 @@
 #ifndef H_GUARD_MEM_DEBUG_H
 #define H_GUARD_MEM_DEBUG_H
 
+#include <iosfwd>
 #include <string>
 #include <sys/types.h>
 
@@ -31,16 +32,60 @@
 /// provide the raw amount of currently allocated memory (as glibc reports it)
 bool rawMemUsage(ssize_t *pDst);
 
+/// provide the resident set size of the process (as the kernel reports it)
+bool rawRssUsage(ssize_t *pDst);
+
+/// return the memory freed by the program to the system, if glibc allows it
+bool trimMemUsage();
+
+// NOTE: DEBUG_MEM_USAGE only enables the debug messages of printMemUsage()
+
 /// initialize memory debugging, taking the current memory state as state zero
 bool initMemDrift();
 
 /// provide relative amount of currently allocated memory (subtracting drift)
 bool currentMemUsage(ssize_t *pDst);
 
-/// print the current amount of allocated memory
+/**
+ * print the current amount of allocated memory and record it as a sample of
+ * the time series written by writeMemUsageSeries()
+ * @note the given name is kept by the time series, use a string literal
+ */
 bool printMemUsage(const char *justCompletedFncName);
 
 /// print the peak over all calls of rawMemUsage(), but relative to the drift
 bool printPeakMemUsage();
 
+/**
+ * write the samples recorded by printMemUsage() as tab-separated values, one
+ * line per sample, with the values of all MemCounter instances as columns
+ */
+bool writeMemUsageSeries(std::ostream &str);
+
+/**
+ * count of live objects of a subsystem, sampled by printMemUsage().  Instances
+ * are expected to have static storage duration, they register themselves.
+ */
+class MemCounter {
+    public:
+        MemCounter(const char *name);
+
+        const char* name() const { return name_; }
+        ssize_t value() const { return value_; }
+
+        void inc(ssize_t cnt = 1) { value_ += cnt; }
+        void dec(ssize_t cnt = 1) { value_ -= cnt; }
+
+    private:
+        /// @b not allowed to be copied
+        MemCounter(const MemCounter &);
+
+        /// @b not allowed to be copied
+        MemCounter& operator=(const MemCounter &);
+
+    private:
+        const char     *name_;
+        ssize_t         value_;
+};
+
 #endif /* H_GUARD_MEM_DEBUG_H */
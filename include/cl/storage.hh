@@ -606,6 +606,45 @@ class ControlFlow {
         Private *d;
 };
 
+/**
+ * Priority work-list of basic blocks for data-flow analyses. Scheduled blocks
+ * are taken in the weak topological order of the ControlFlow graph (Bourdoncle),
+ * a reverse post-order where each loop occupies a contiguous interval headed by
+ * its entry.  The body of a loop (including its nested loops) is thus stabilised
+ * before the blocks after the loop are processed.  Each block is scheduled at
+ * most once at a time.
+ */
+class WtoScheduler {
+    public:
+        /// compute the weak topological order of blocks in the given CFG
+        WtoScheduler(const ControlFlow &cfg);
+        ~WtoScheduler();
+
+        /// schedule the given block, return false if already scheduled
+        bool schedule(const Block *bb);
+
+        /// take the scheduled block that comes first in the order
+        bool next(const Block *&dst);
+
+        bool empty() const;
+
+        /// position of the given block in the order
+        unsigned indexOf(const Block *bb) const;
+
+        /// count of blocks taken by next() so far
+        unsigned cntVisits() const;
+
+        /// count of distinct blocks taken by next() so far
+        unsigned cntBlocksVisited() const;
+
+    private:
+        WtoScheduler(const WtoScheduler &);
+        WtoScheduler& operator=(const WtoScheduler &);
+
+        struct Private;
+        Private *d;
+};
+
 typedef std::vector<int>        TArgByPos;
 typedef std::set<int>           TVarSet;
 
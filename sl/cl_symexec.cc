@@ -32,14 +32,24 @@
 #include "symexec.hh"
 #include "symproc.hh"
 #include "symstate.hh"
+#include "symsummary.hh"
 #include "symtrace.hh"
 #include "symutil.hh"
 #include "util.hh"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
 
 #include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
 
 // required by the gcc plug-in API
 extern "C" {
@@ -123,27 +133,206 @@ void execFnc(const CodeStorage::Fnc &fnc, bool lookForGlJunk = false)
     }
 }
 
-void execVirtualRoots(const CodeStorage::Storage &stor)
+/// analyze fnc once again with the trace graph if its error trace was lost
+void execRootFnc(const CodeStorage::Fnc &fnc, bool lookForGlJunk = false)
 {
-    namespace CG = CodeStorage::CallGraph;
+    if (2 != GlConf::data.noTrace) {
+        execFnc(fnc, lookForGlJunk);
+        return;
+    }
 
-    // go through all root nodes
-    const CG::Graph &cg = stor.callGraph;
-    BOOST_FOREACH(const CG::Node *node, cg.roots) {
-        const CodeStorage::Fnc &fnc = *node->fnc;
-        if (!isDefined(fnc))
-            continue;
+    const Trace::NullNode *trNull = Trace::NullNode::instance();
+    const int cntLost = trNull->cntLostTraces();
+    try {
+        execFnc(fnc, lookForGlJunk);
+    }
+    catch (const std::runtime_error &e) {
+        if (cntLost == trNull->cntLostTraces())
+            throw;
+
+        CL_DEBUG("execRootFnc() caught a run-time exception: " << e.what());
+    }
 
+    if (cntLost == trNull->cntLostTraces())
+        // no trace has been lost
+        return;
+
+    CL_NOTE_MSG(locationOf(fnc), "analyzing " << nameOf(fnc)
+            << "() once again with the trace graph enabled...");
+
+    // if the error recovery is disabled, this throws again after the trace
+    GlConf::data.noTrace = 0;
+    execFnc(fnc, lookForGlJunk);
+    GlConf::data.noTrace = 2;
+}
+
+// true if we are a worker process spawned by execVirtualRoots()
+static bool isWorker;
+
+// counts of messages emitted by the parent process before spawning the worker
+static int cntErrorsAtFork;
+static int cntWarningsAtFork;
+
+/// exit codes of worker processes (EXIT_FAILURE if they die on their own)
+enum EWorkerExitCode {
+    WEC_OK          = EXIT_SUCCESS,
+    WEC_ERRORS      = EXIT_FAILURE,
+    WEC_WARNINGS
+};
+
+typedef std::vector<const CodeStorage::Fnc *> TFncList;
+
+void execVirtualRootsSeq(const TFncList &roots, unsigned idx, unsigned step)
+{
+    for (; idx < roots.size(); idx += step) {
+        const CodeStorage::Fnc &fnc = *roots[idx];
         const struct cl_loc *lw = locationOf(fnc);
         CL_DEBUG_MSG(lw, nameOf(fnc)
                 << "() is defined, but not called from anywhere");
 
         // perform symbolic execution for a virtual root
-        execFnc(fnc);
+        execRootFnc(fnc);
         printMemUsage("execFnc");
     }
 }
 
+/// return index of the spawned worker in the child, -1 in the parent
+int spawnWorkers(unsigned *pCnt, std::vector<pid_t> &pids)
+{
+    // the children inherit the buffers of stdio streams
+    fflush(0);
+
+    for (unsigned idx = 0U; idx < *pCnt; ++idx) {
+        const pid_t pid = fork();
+        if (!pid)
+            return idx;
+
+        if (-1 == pid) {
+            CL_WARN("fork() failed, the remaining virtual roots are going"
+                    " to be analyzed by the current process");
+
+            *pCnt = idx;
+            break;
+        }
+
+        pids.push_back(pid);
+    }
+
+    return -1;
+}
+
+/// each worker process streams its own part of the trace graph
+void reopenTraceStream()
+{
+    std::string fileName = GlConf::data.traceStream;
+    if (fileName.empty())
+        return;
+
+    fileName += ".";
+    fileName += boost::lexical_cast<std::string>(getpid());
+    Trace::openTraceStream(fileName);
+}
+
+/// each worker process writes its own fnc summaries, merged by the parent
+std::string fncSummariesFileName(pid_t pid)
+{
+    std::string fileName = GlConf::data.fncSummaries;
+    if (!fileName.empty() && pid) {
+        fileName += ".";
+        fileName += boost::lexical_cast<std::string>(pid);
+    }
+
+    return fileName;
+}
+
+/// processes running at the same time share the memory budget evenly
+void shareMemBudget(unsigned cntProcs)
+{
+    int &memBudget = GlConf::data.memBudget;
+    if (!memBudget || cntProcs < 2U)
+        return;
+
+    memBudget = std::max(1, memBudget / static_cast<int>(cntProcs));
+    CL_DEBUG("memory budget per process: " << memBudget << " MiB");
+}
+
+void execVirtualRoots(const CodeStorage::Storage &stor)
+{
+    namespace CG = CodeStorage::CallGraph;
+
+    // gather all root nodes with a definition
+    TFncList roots;
+    const CG::Graph &cg = stor.callGraph;
+    BOOST_FOREACH(const CG::Node *node, cg.roots) {
+        const CodeStorage::Fnc *fnc = node->fnc;
+        if (isDefined(*fnc))
+            roots.push_back(fnc);
+    }
+
+    const unsigned cntJobs = GlConf::data.cntJobs;
+    if (cntJobs < 2U || roots.size() < 2U) {
+        execVirtualRootsSeq(roots, 0U, /* step */ 1U);
+        return;
+    }
+
+    // the virtual roots are independent of each other, so we can analyze them
+    // in separate processes without sharing any global state among them
+    const unsigned step = std::min<unsigned>(cntJobs, roots.size());
+    unsigned cntWorkers = step;
+
+    std::vector<pid_t> pids;
+    const int idxWorker = spawnWorkers(&cntWorkers, pids);
+
+    // the workers run concurrently, along with the parent if it analyzes the
+    // roots of the workers that have failed to spawn
+    shareMemBudget(cntWorkers + (cntWorkers < step));
+
+    if (-1 != idxWorker) {
+        ::isWorker = true;
+        ::cntErrorsAtFork   = cl_cnt_errors();
+        ::cntWarningsAtFork = cl_cnt_warnings();
+        reopenTraceStream();
+        execVirtualRootsSeq(roots, idxWorker, step);
+        return;
+    }
+
+    for (unsigned idx = cntWorkers; idx < step; ++idx)
+        execVirtualRootsSeq(roots, idx, step);
+
+    // wait for all workers to finish and propagate their results, as the
+    // messages they have emitted are not counted by our cl peer
+    BOOST_FOREACH(const pid_t pid, pids) {
+        int status;
+        if (pid != waitpid(pid, &status, 0)) {
+            CL_ERROR("waitpid() failed for a worker process");
+            continue;
+        }
+
+        if (!WIFEXITED(status)) {
+            CL_ERROR("a worker process analyzing virtual roots has crashed");
+            continue;
+        }
+
+        switch (WEXITSTATUS(status)) {
+            case WEC_OK:
+                break;
+
+            case WEC_WARNINGS:
+                CL_WARN("a worker process analyzing virtual roots"
+                        " has reported some warnings");
+                break;
+
+            default:
+                CL_ERROR("a worker process analyzing virtual roots"
+                        " has reported some errors");
+        }
+
+        const std::string fileName = fncSummariesFileName(pid);
+        if (!fileName.empty())
+            mergeFncSummaries(fileName);
+    }
+}
+
 void launchSymExec(const CodeStorage::Storage &stor)
 {
     using namespace CodeStorage;
@@ -168,10 +357,53 @@ void launchSymExec(const CodeStorage::Storage &stor)
     }
 
     // just execute the main() function
-    execFnc(*main, /* lookForGlJunk */ true);
+    execRootFnc(*main, /* lookForGlJunk */ true);
     printMemUsage("execFnc");
 }
 
+void writeMemUsageLog()
+{
+    std::string fileName = GlConf::data.memUsageLog;
+    if (fileName.empty())
+        return;
+
+    if (::isWorker) {
+        // each worker process writes its own time series
+        fileName += ".";
+        fileName += boost::lexical_cast<std::string>(getpid());
+    }
+
+    std::fstream out(fileName.c_str(), std::ios::out);
+    if (!writeMemUsageSeries(out))
+        CL_WARN("failed to write memory usage samples to " << fileName);
+}
+
+void checkTraceOptions()
+{
+    // both need to walk through the whole trace graph
+    const bool needFullTrace = GlConf::data.allowCyclicTraceGraph
+        || GlConf::data.fixedPoint;
+
+    if (GlConf::data.noTrace && needFullTrace) {
+        CL_WARN("option \"no_trace\" cannot be combined with cyclic"
+                " trace graphs and fixed-point dumps, ignored");
+        GlConf::data.noTrace = 0;
+    }
+
+    std::string &traceStream = GlConf::data.traceStream;
+    if (traceStream.empty())
+        return;
+
+    if (needFullTrace) {
+        CL_WARN("option \"trace_stream\" cannot be combined with cyclic"
+                " trace graphs and fixed-point dumps, ignored");
+        traceStream.clear();
+        return;
+    }
+
+    Trace::openTraceStream(traceStream);
+}
+
 // /////////////////////////////////////////////////////////////////////////////
 // see easy.hh for details
 void clEasyRun(const CodeStorage::Storage &stor, const char *configString)
@@ -181,6 +413,12 @@ void clEasyRun(const CodeStorage::Storage &stor, const char *configString)
     // read parameters of symbolic execution
     GlConf::loadConfigString(configString);
 
+    checkTraceOptions();
+
+    const std::string &fncSummaries = GlConf::data.fncSummaries;
+    if (!fncSummaries.empty())
+        loadFncSummaries(stor, fncSummaries, configString);
+
     // run symbolic execution
     try {
         launchSymExec(stor);
@@ -189,6 +427,13 @@ void clEasyRun(const CodeStorage::Storage &stor, const char *configString)
         CL_DEBUG("clEasyRun() caught a run-time exception: " << e.what());
     }
 
+    if (!fncSummaries.empty()) {
+        const pid_t pid = (::isWorker) ? getpid() : 0;
+        const std::string fileName = fncSummariesFileName(pid);
+        if (!saveFncSummaries(fileName))
+            CL_WARN("failed to write function summaries to " << fileName);
+    }
+
     FixedPoint::StateByInsn *const fixedPoint = GlConf::data.fixedPoint;
     if (fixedPoint) {
         // plot fixed-point
@@ -207,5 +452,21 @@ void clEasyRun(const CodeStorage::Storage &stor, const char *configString)
         printMemUsage("Trace::Globals::cleanup");
     }
 
+    Trace::closeTraceStream();
+
     printPeakMemUsage();
+    printEntPoolStats();
+    writeMemUsageLog();
+
+    if (::isWorker) {
+        // the parent process takes care of the rest of the compilation
+        EWorkerExitCode ec = WEC_OK;
+        if (::cntErrorsAtFork != cl_cnt_errors())
+            ec = WEC_ERRORS;
+        else if (::cntWarningsAtFork != cl_cnt_warnings())
+            ec = WEC_WARNINGS;
+
+        fflush(0);
+        _exit(ec);
+    }
 }
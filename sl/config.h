@@ -68,6 +68,12 @@
  */
 #define DEBUG_SYMCUT                        0
 
+/**
+ * if 1, cross-check the segment discovery restricted by SE_DISCOVER_NEAR_DIRTY
+ * against the discovery probing all objects on heap (expensive)
+ */
+#define DEBUG_SYMDISCOVER                   0
+
 /**
  * if 1, plot shape of the data structures being leaked
  */
@@ -188,6 +194,14 @@
  */
 #define SE_DISABLE_SYMCUT                   0
 
+/**
+ * - 0 ... probe all objects on heap as segment entries in each abstraction
+ * - N ... probe only objects at most N pointer hops away from an object that
+ *         has been written since the last abstraction of the heap
+ * @note a segment may be missed if its entry is too far from the change
+ */
+#define SE_DISCOVER_NEAR_DIRTY              0
+
 /**
  * - 0 ... do not dump trace graphs unless explicitly asked to do so
  * - 1 ... dump a single trace graph for all errors/warnings (may be huge)
@@ -234,11 +248,26 @@
  */
 #define SE_JOIN_ON_LOOP_EDGES_ONLY          3
 
+/**
+ * - 0 ... SymStateWithJoin calls joinSymHeaps() for each heap in the state
+ * - 1 ... skip heaps whose joinSignature() is provably incompatible
+ * - 2 ... same as 1, but cross-check the skipped heaps with joinSymHeaps()
+ */
+#define SE_JOIN_PREFILTER                   1
+
 /**
  * maximal call depth
  */
 #define SE_MAX_CALL_DEPTH                   0x40
 
+/**
+ * - 0 ... build the trace graph
+ * - 1 ... replace the trace graph by a single shared node (no error traces)
+ * - 2 ... like 1, but analyze a root function that has reported an error once
+ *         again with the trace graph being built in order to print its trace
+ */
+#define SE_NO_TRACE                         0
+
 /**
  * if non-zero, plot each state that caused an error to be reported
  */
@@ -259,6 +288,13 @@
  */
 #define SE_RESTRICT_SLS_MINLEN              2
 
+/**
+ * - 0 ... SymHeapUnion looks for isomorphic heaps by linear search only
+ * - 1 ... call areEqual() only for heaps with matching heapFingerprint()
+ * - 2 ... same as 1, but cross-check the result with linear search (slow)
+ */
+#define SE_STATE_HASH_LOOKUP                1
+
 /**
  * - 0 ... do not try to optimize the order of heaps in SymState containers
  * - 1 ... reorder heaps in SymStateWithJoin based on hit ratio
@@ -284,6 +320,12 @@
  */
 #define SE_STATE_PRUNING_TOTAL_THR          0x80
 
+/**
+ * count of basic blocks to enter before the memory budget (see the mem_budget
+ * option) is checked again after a step of graceful degradation
+ */
+#define SE_MEM_BUDGET_DELAY                 0x100
+
 /**
  * if 1, the symcut module allows generic minimal lengths to survive a function
  * call/return.  @b Not recommended unless SymCallCache has been rewritten to
@@ -309,6 +351,12 @@
  */
 #define SH_DELAYED_FIELDS_DESTRUCTION       1
 
+/**
+ * if 1, allocate heap entities and trace graph nodes from slab pools (one pool
+ * per size class)
+ */
+#define SH_ENT_POOL                         1
+
 /**
  * if 1, prevent collisions on entity IDs with descendants heaps
  */
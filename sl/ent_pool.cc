@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include "ent_pool.hh"
+
+#include <cl/cl_msg.hh>
+
+#include "symheap.hh"               // for printEntPoolStats()
+
+EntPool *EntPoolSet::pools_[EntPoolSet::CNT_POOLS];
+
+void EntPoolSet::printStats()
+{
+    for (unsigned idx = 0; idx < CNT_POOLS; ++idx) {
+        const EntPool *pool = pools_[idx];
+        if (!pool)
+            continue;
+
+        CL_DEBUG("entity pool of " << pool->slotSize()
+                << "B slots: " << pool->cntLive() << " live, "
+                << pool->cntFree() << " free, "
+                << pool->cntSlabs() << " slabs");
+    }
+}
+
+void printEntPoolStats()
+{
+    EntPoolSet::printStats();
+}
\ No newline at end of file
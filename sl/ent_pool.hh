@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_ENT_POOL_H
+#define H_GUARD_ENT_POOL_H
+
+/**
+ * @file ent_pool.hh
+ * slab pools of fixed-size slots shared by heap entities and trace graph nodes
+ */
+
+#include "config.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include <stdint.h>
+
+/**
+ * slab allocator of fixed-size slots, a free slot is reused on next alloc()
+ *
+ * Slabs are aligned to their size, so the slab owning a slot is given by its
+ * address.  A slab whose slots have all been released is returned to the
+ * system, except for a single empty slab kept per pool to avoid thrashing.
+ */
+class EntPool {
+    public:
+        EntPool(size_t slotSize):
+            slotSize_(slotSize),
+            cntSlotsPerSlab_((SLAB_SIZE - slotsOffset()) / slotSize),
+            avail_(0),
+            cntSlabs_(0),
+            cntEmpty_(0),
+            cntLive_(0),
+            cntFree_(0)
+        {
+        }
+
+        void* alloc() {
+            if (!avail_)
+                this->addSlab();
+
+            Slab *slab = avail_;
+            FreeSlot *slot = slab->freeList;
+            slab->freeList = slot->next;
+            if (!slab->freeList)
+                // the slab is full now
+                this->unlink(slab);
+
+            if (!slab->cntLive++)
+                --cntEmpty_;
+
+            --cntFree_;
+            ++cntLive_;
+            return slot;
+        }
+
+        void release(void *ptr) {
+            Slab *slab = slabOf(ptr);
+            if (!slab->freeList)
+                // the slab has been full so far
+                this->link(slab);
+
+            FreeSlot *slot = static_cast<FreeSlot *>(ptr);
+            slot->next = slab->freeList;
+            slab->freeList = slot;
+            --cntLive_;
+            ++cntFree_;
+
+            if (--slab->cntLive)
+                return;
+
+            if (!cntEmpty_++)
+                // keep one empty slab for the next alloc()
+                return;
+
+            this->dropSlab(slab);
+        }
+
+        size_t slotSize()   const { return slotSize_;   }
+        size_t cntSlabs()   const { return cntSlabs_;   }
+        size_t cntLive()    const { return cntLive_;    }
+        size_t cntFree()    const { return cntFree_;    }
+
+    private:
+        struct FreeSlot {
+            FreeSlot                   *next;
+        };
+
+        struct Slab {
+            Slab                       *prev;       ///< in the list of avail_
+            Slab                       *next;       ///< in the list of avail_
+            FreeSlot                   *freeList;
+            size_t                      cntLive;
+        };
+
+        enum {
+            /// a power of two, as the slabs are aligned to their size
+            SLAB_SIZE = 0x10000,
+            SLOT_ALIGN = sizeof(void *) * 2
+        };
+
+        const size_t                    slotSize_;
+        const size_t                    cntSlotsPerSlab_;
+        Slab                           *avail_;     ///< slabs with free slots
+        size_t                          cntSlabs_;
+        size_t                          cntEmpty_;
+        size_t                          cntLive_;
+        size_t                          cntFree_;
+
+        static size_t slotsOffset() {
+            return (sizeof(Slab) + SLOT_ALIGN - 1) / SLOT_ALIGN * SLOT_ALIGN;
+        }
+
+        static Slab* slabOf(void *ptr) {
+            const uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+            return reinterpret_cast<Slab *>(addr & ~(uintptr_t)(SLAB_SIZE - 1));
+        }
+
+        void link(Slab *slab) {
+            slab->prev = 0;
+            slab->next = avail_;
+            if (avail_)
+                avail_->prev = slab;
+
+            avail_ = slab;
+        }
+
+        void unlink(Slab *slab) {
+            if (slab->prev)
+                slab->prev->next = slab->next;
+            else
+                avail_ = slab->next;
+
+            if (slab->next)
+                slab->next->prev = slab->prev;
+        }
+
+        void addSlab() {
+            void *mem;
+            if (posix_memalign(&mem, SLAB_SIZE, SLAB_SIZE))
+                throw std::bad_alloc();
+
+            Slab *slab = static_cast<Slab *>(mem);
+            slab->freeList = 0;
+            slab->cntLive = 0;
+
+            // chain the slots such that they are handed out in address order
+            char *slots = static_cast<char *>(mem) + slotsOffset();
+            for (size_t i = cntSlotsPerSlab_; 0 < i; --i) {
+                FreeSlot *slot = reinterpret_cast<FreeSlot *>(slots
+                        + (i - 1) * slotSize_);
+                slot->next = slab->freeList;
+                slab->freeList = slot;
+            }
+
+            this->link(slab);
+            ++cntSlabs_;
+            ++cntEmpty_;
+            cntFree_ += cntSlotsPerSlab_;
+        }
+
+        void dropSlab(Slab *slab) {
+            this->unlink(slab);
+            free(slab);
+
+            --cntSlabs_;
+            --cntEmpty_;
+            cntFree_ -= cntSlotsPerSlab_;
+        }
+
+        // intentionally not implemented
+        EntPool(const EntPool &);
+        EntPool& operator=(const EntPool &);
+};
+
+/// slab pools indexed by size class, entities of the same type share a pool
+class EntPoolSet {
+    public:
+        enum {
+            GRANULARITY = sizeof(void *) * 2,
+            MAX_SLOT_SIZE = 0x400
+        };
+
+        static EntPool* poolBySize(const size_t size) {
+            if (MAX_SLOT_SIZE < size)
+                // too big to be pooled
+                return 0;
+
+            const size_t idx = (size + GRANULARITY - 1) / GRANULARITY;
+            EntPool *&pool = pools_[idx];
+            if (!pool)
+                // pools are never released, some entities may outlive statics
+                pool = new EntPool(idx * GRANULARITY);
+
+            return pool;
+        }
+
+        /// allocate a slot of the given size, fall back to the global new
+        static void* alloc(const size_t size) {
+            EntPool *pool = poolBySize(size);
+            return (pool)
+                ? pool->alloc()
+                : ::operator new(size);
+        }
+
+        /// release a slot allocated by alloc() with the same size
+        static void release(void *ptr, const size_t size) {
+            EntPool *pool = poolBySize(size);
+            if (pool)
+                pool->release(ptr);
+            else
+                ::operator delete(ptr);
+        }
+
+        /// print live/free slots of all pools allocated so far
+        static void printStats();
+
+    private:
+        enum { CNT_POOLS = MAX_SLOT_SIZE / GRANULARITY + 1 };
+        static EntPool *pools_[CNT_POOLS];
+};
+
+#endif /* H_GUARD_ENT_POOL_H */
@@ -33,6 +33,7 @@
 
 #include <cl/cl_msg.hh>
 #include <cl/cldebug.hh>
+#include <cl/memdebug.hh>
 #include <cl/storage.hh>
 
 #include <fstream>
@@ -61,8 +62,14 @@ StateByInsn::StateByInsn():
 {
 }
 
+/// count of heaps kept by all instances of StateByInsn
+static MemCounter cntFixedPointHeaps("fixed_point_heaps");
+
 StateByInsn::~StateByInsn()
 {
+    BOOST_FOREACH(TStateMap::const_reference item, d->stateByInsn)
+        cntFixedPointHeaps.dec(item.second.size());
+
     delete d;
 }
 
@@ -77,7 +84,10 @@ bool /* any change */ StateByInsn::insert(const TInsn insn, const SymHeap &sh)
         d->visitedFncs[uid] = fnc;
     }
 
-    return state.insert(sh, /* allowThreeWay */ false);
+    const int cntOrig = state.size();
+    const bool changed = state.insert(sh, /* allowThreeWay */ false);
+    cntFixedPointHeaps.inc(state.size() - cntOrig);
+    return changed;
 }
 
 const StateByInsn::TStateMap& StateByInsn::stateMap() const
@@ -50,6 +50,9 @@ Options::Options():
     joinOnLoopEdgesOnly(SE_JOIN_ON_LOOP_EDGES_ONLY),
     stateLiveOrdering(SE_STATE_ON_THE_FLY_ORDERING),
     detectContainers(false),
+    cntJobs(1),
+    memBudget(0),
+    noTrace(SE_NO_TRACE),
     fixedPoint(0)
 {
 }
@@ -94,6 +97,48 @@ void handleErrorLabel(const string &name, const string &value)
     data.errLabel = value;
 }
 
+void handleMemBudget(const string &name, const string &value)
+{
+    try {
+        data.memBudget = boost::lexical_cast<int>(value);
+        if (data.memBudget < 0)
+            data.memBudget = 0;
+    }
+    catch (...) {
+        CL_WARN("ignoring option \"" << name << "\" with invalid value");
+    }
+}
+
+void handleMemUsageLog(const string &name, const string &value)
+{
+    if (value.empty()) {
+        CL_WARN("ignoring option \"" << name << "\" without a valid value");
+        return;
+    }
+
+    data.memUsageLog = value;
+}
+
+void handleTraceStream(const string &name, const string &value)
+{
+    if (value.empty()) {
+        CL_WARN("ignoring option \"" << name << "\" without a valid value");
+        return;
+    }
+
+    data.traceStream = value;
+}
+
+void handleFncSummaries(const string &name, const string &value)
+{
+    if (value.empty()) {
+        CL_WARN("ignoring option \"" << name << "\" without a valid value");
+        return;
+    }
+
+    data.fncSummaries = value;
+}
+
 void handleAllowThreeWayJoin(const string &name, const string &value)
 {
     if (value.empty()) {
@@ -164,6 +209,18 @@ void handleIntArithmeticLimit(const string &name, const string &value)
     }
 }
 
+void handleJobs(const string &name, const string &value)
+{
+    try {
+        data.cntJobs = boost::lexical_cast<int>(value);
+        if (data.cntJobs < 1)
+            data.cntJobs = 1;
+    }
+    catch (...) {
+        CL_WARN("ignoring option \"" << name << "\" with invalid value");
+    }
+}
+
 void handleAllowCyclicTraceGraph(const string &name, const string &value)
 {
     assumeNoValue(name, value);
@@ -188,6 +245,26 @@ void handleNoErrorRecovery(const string &name, const string &value)
     data.errorRecoveryMode = /* no_error_recovery */ 0;
 }
 
+void handleNoTrace(const string &name, const string &value)
+{
+    if (value.empty()) {
+        data.noTrace = /* replace the trace graph by a single node */ 1;
+        return;
+    }
+
+    try {
+        data.noTrace = boost::lexical_cast<int>(value);
+        if (data.noTrace < 0)
+            data.noTrace = 0;
+        if (data.noTrace > 2)
+            data.noTrace = 2;
+    }
+    catch (...) {
+        CL_WARN("ignoring option \"" << name << "\" with invalid value");
+        return;
+    }
+}
+
 void handleNoPlot(const string &name, const string &value)
 {
     assumeNoValue(name, value);
@@ -229,14 +306,20 @@ ConfigStringParser::ConfigStringParser()
     tbl_["dump_fixed_point"]        = handleDumpFixedPoint;
     tbl_["detect_containers"]       = handleDetectContainers;
     tbl_["error_label"]             = handleErrorLabel;
+    tbl_["fnc_summaries"]           = handleFncSummaries;
     tbl_["forbid_heap_replace"]     = handleForbidHeapReplace;
     tbl_["int_arithmetic_limit"]    = handleIntArithmeticLimit;
+    tbl_["jobs"]                    = handleJobs;
     tbl_["join_on_loop_edges_only"] = handleJoinOnLoopEdgesOnly;
+    tbl_["mem_budget"]              = handleMemBudget;
+    tbl_["mem_usage_log"]           = handleMemUsageLog;
     tbl_["memleak_is_error"]        = handleMemLeakIsError;
     tbl_["no_error_recovery"]       = handleNoErrorRecovery;
     tbl_["no_plot"]                 = handleNoPlot;
+    tbl_["no_trace"]                = handleNoTrace;
     tbl_["oom"]                     = handleOOM;
     tbl_["state_live_ordering"]     = handleStateLiveOrdering;
+    tbl_["trace_stream"]            = handleTraceStream;
     tbl_["track_uninit"]            = handleTrackUninit;
 }
 
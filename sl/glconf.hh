@@ -44,6 +44,12 @@ struct Options {
     int joinOnLoopEdgesOnly;///< @copydoc config.h::SE_JOIN_ON_LOOP_EDGES_ONLY
     int stateLiveOrdering;  ///< @copydoc config.h::SE_STATE_ON_THE_FLY_ORDERING
     bool detectContainers;  ///< detect containers and operations over them
+    int cntJobs;            ///< count of processes to analyze virtual roots
+    std::string memUsageLog;///< if not empty, write memory usage samples there
+    int memBudget;          ///< memory budget in MiB (0 means unlimited)
+    std::string traceStream;///< if not empty, stream the trace graph there
+    std::string fncSummaries;///< if not empty, load/save fnc summaries there
+    int noTrace;            ///< @copydoc config.h::SE_NO_TRACE
     FixedPoint::StateByInsn *fixedPoint;  ///< fixed-point plotter (0 if unused)
 
     Options();
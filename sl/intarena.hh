@@ -22,15 +22,37 @@
 
 #include "config.h"
 
-#include <map>
+#include <algorithm>
 #include <set>
 #include <vector>
 
 #include <boost/foreach.hpp>
 
-#define IA_AGGRESSIVE_OPTIMIZATION          0
+/// if 1, record all operations on IntervalArena to intarena-trace.txt (slow)
+#define IA_RECORD_TRACE                     0
 
-/// ad-hoc implementation;  wastes memory, performance, and human resources
+#if IA_RECORD_TRACE
+#   include <fstream>
+
+inline std::ofstream& iaTraceStream()
+{
+    static std::ofstream str("intarena-trace.txt");
+    return str;
+}
+
+#   define IA_TRACE(what) (iaTraceStream() << what << "\n")
+#else
+#   define IA_TRACE(what) do { } while (0)
+#endif
+
+/**
+ * set of (interval, field) pairs that can be queried for overlaps
+ *
+ * The items are kept in a flat vector sorted by the upper bound of the
+ * interval, its lower bound, and the field.  Objects usually have only a few
+ * fields, so linear scans of a contiguous vector beat any node-based tree.
+ * See intarena_bench.cc for a comparison with the former std::map-based one.
+ */
 template <typename TInt, typename TFld>
 class IntervalArena {
     public:
@@ -43,12 +65,55 @@ class IntervalArena {
         typedef std::vector<key_type>               TKeySet;
 
     private:
-        typedef std::set<TFld>                      TLeaf;
-        typedef std::map</* beg */ TInt, TLeaf>     TLine;
-        typedef std::map</* end */ TInt, TLine>     TCont;
+        struct Item {
+            TInt    end;
+            TInt    beg;
+            TFld    fld;
+
+            Item(TInt end_, TInt beg_, TFld fld_):
+                end(end_),
+                beg(beg_),
+                fld(fld_)
+            {
+            }
+
+            bool operator<(const Item &ref) const {
+                if (end != ref.end)
+                    return (end < ref.end);
+                if (beg != ref.beg)
+                    return (beg < ref.beg);
+                return (fld < ref.fld);
+            }
+        };
+
+        typedef std::vector<Item>                   TCont;
         TCont                                       cont_;
 
+        /// return iterator to the first item whose upper bound exceeds winBeg
+        typename TCont::iterator firstAbove(TInt winBeg);
+        typename TCont::const_iterator firstAbove(TInt winBeg) const;
+
     public:
+#if IA_RECORD_TRACE
+        IntervalArena() {
+        }
+
+        IntervalArena(const IntervalArena &ref):
+            cont_(ref.cont_)
+        {
+            IA_TRACE("= " << this << " " << &ref);
+        }
+
+        IntervalArena& operator=(const IntervalArena &ref) {
+            cont_ = ref.cont_;
+            IA_TRACE("= " << this << " " << &ref);
+            return *this;
+        }
+
+        ~IntervalArena() {
+            IA_TRACE("d " << this);
+        }
+#endif
         void add(const key_type &, TFld);
         void sub(const key_type &, TFld);
         void intersects(TSet &dst, const key_type &key) const;
@@ -58,6 +123,7 @@ class IntervalArena {
         void reverseLookup(TKeySet &dst, TFld) const;
 
         void clear() {
+            IA_TRACE("c " << this);
             cont_.clear();
         }
 
@@ -72,14 +138,49 @@ class IntervalArena {
         }
 };
 
+template <typename TInt, typename TFld>
+typename IntervalArena<TInt, TFld>::TCont::iterator
+IntervalArena<TInt, TFld>::firstAbove(const TInt winBeg)
+{
+    typename TCont::iterator it = cont_.begin();
+    typename TCont::iterator itEnd = cont_.end();
+    while (it != itEnd) {
+        // binary search on the upper bound only
+        typename TCont::iterator itMid = it + (itEnd - it) / 2;
+        if (itMid->end <= winBeg)
+            it = itMid + 1;
+        else
+            itEnd = itMid;
+    }
+
+    return it;
+}
+
+template <typename TInt, typename TFld>
+typename IntervalArena<TInt, TFld>::TCont::const_iterator
+IntervalArena<TInt, TFld>::firstAbove(const TInt winBeg) const
+{
+    IntervalArena *self = const_cast<IntervalArena *>(this);
+    return self->firstAbove(winBeg);
+}
+
 template <typename TInt, typename TFld>
 void IntervalArena<TInt, TFld>::add(const key_type &key, const TFld fld)
 {
     const TInt beg = key.first;
     const TInt end = key.second;
     CL_BREAK_IF(end <= beg);
+    IA_TRACE("a " << this << " " << beg << " " << end << " " << fld);
 
-    cont_[end][beg].insert(fld);
+    const Item item(end, beg, fld);
+    const typename TCont::iterator it =
+        std::lower_bound(cont_.begin(), cont_.end(), item);
+
+    if (cont_.end() != it && !(item < *it))
+        // already there
+        return;
+
+    cont_.insert(it, item);
 }
 
 template <typename TInt, typename TFld>
@@ -88,96 +189,40 @@ void IntervalArena<TInt, TFld>::sub(const key_type &key, const TFld fld)
     const TInt winBeg = key.first;
     const TInt winEnd = key.second;
     CL_BREAK_IF(winEnd <= winBeg);
+    IA_TRACE("s " << this << " " << winBeg << " " << winEnd << " " << fld);
 
-    std::vector<value_type> recoverList;
+    // parts of the removed items that lie outside of the window (rarely used)
+    std::vector<Item> recoverList;
 
+    // remove the matching items in place, preserving the order of the others
     const typename TCont::iterator itEnd = cont_.end();
-    typename TCont::iterator it =
-        cont_.lower_bound(winBeg + /* right-open interval given as key */ 1);
-
-    while (itEnd != it) {
-        TLine &line = it->second;
-#if !IA_AGGRESSIVE_OPTIMIZATION
-        if (line.empty()) {
-            // skip orphans
-            ++it;
-            continue;
-        }
-#endif
-        typename TLine::iterator lineIt = line.begin();
-        TInt beg = lineIt->first;
-        if (winEnd <= beg) {
-            // we are beyond the window already
-            ++it;
+    typename TCont::iterator it = this->firstAbove(winBeg);
+    typename TCont::iterator itDst = it;
+    for (; itEnd != it; ++it) {
+        if (fld != it->fld || winEnd <= it->beg) {
+            // not affected by the window
+            *itDst++ = *it;
             continue;
         }
 
-        const TInt end = it->first;
-        bool anyHit = false;
-
-        const typename TLine::iterator lineItEnd = line.end();
-        do {
-            // make sure the basic window axioms hold
-            CL_BREAK_IF(winEnd <= beg);
-            CL_BREAK_IF(end <= winBeg);
-
-            // remove the object from the current leaf (if found)
-            TLeaf &os = lineIt->second;
-            if (os.erase(fld)) {
-                anyHit = true;
-
-                if (beg < winBeg) {
-                    // schedule "the part above" for re-insertion
-                    const key_type key(beg, winBeg);
-                    const value_type item(key, fld);
-                    recoverList.push_back(item);
-                }
-            }
+        if (it->beg < winBeg)
+            // schedule "the part above" for re-insertion
+            recoverList.push_back(Item(winBeg, it->beg, fld));
 
-#if IA_AGGRESSIVE_OPTIMIZATION
-            if (os.empty())
-                // FIXME: Can we remove items from std::map during traversal??
-                line.erase(lineIt++);
-            else
-#endif
-            ++lineIt;
-
-            if (lineItEnd == lineIt)
-                // end of line
-                break;
-
-            beg = lineIt->first;
-        }
-        while (beg < winEnd);
-
-        if (anyHit) {
-            if (winEnd < end) {
-                // schedule "the part beyond" for re-insertion
-                const key_type key(winEnd, end);
-                const value_type item(key, fld);
-                recoverList.push_back(item);
-            }
-
-#if IA_AGGRESSIVE_OPTIMIZATION
-            if (line.empty()) {
-                // FIXME: Can we remove items from std::map during traversal??
-                cont_.erase(it++);
-                continue;
-            }
-#endif
-        }
-
-        ++it;
+        if (winEnd < it->end)
+            // schedule "the part beyond" for re-insertion
+            recoverList.push_back(Item(it->end, winEnd, fld));
     }
 
+    cont_.erase(itDst, itEnd);
+
     // go through the recoverList and re-insert the missing parts
-    BOOST_FOREACH(const value_type &rItem, recoverList) {
-        const key_type &key = rItem.first;
-        const TFld fld = rItem.second;
-        const TInt beg = key.first;
-        const TInt end = key.second;
+    BOOST_FOREACH(const Item &item, recoverList) {
+        const typename TCont::iterator itPos =
+            std::lower_bound(cont_.begin(), cont_.end(), item);
 
-        cont_[end][beg].insert(fld);
+        if (cont_.end() == itPos || item < *itPos)
+            cont_.insert(itPos, item);
     }
 }
 
@@ -187,83 +232,35 @@ void IntervalArena<TInt, TFld>::intersects(TSet &dst, const key_type &key) const
     const TInt winBeg = key.first;
     const TInt winEnd = key.second;
     CL_BREAK_IF(winEnd <= winBeg);
+    IA_TRACE("i " << this << " " << winBeg << " " << winEnd);
 
-    typename TCont::const_iterator it =
-        cont_.lower_bound(winBeg + /* right-open interval given as key */ 1);
-
-    for (; cont_.end() != it; ++it) {
-        const TLine &line = it->second;
-#if !IA_AGGRESSIVE_OPTIMIZATION
-        if (line.empty())
-            // skip orphans
-            continue;
-#endif
-        typename TLine::const_iterator lineIt = line.begin();
-        TInt beg = lineIt->first;
-        if (winEnd <= beg)
-            // we are beyond the window already
-            continue;
-
-        const typename TLine::const_iterator lineItEnd = line.end();
-        do {
-            // make sure the basic window axioms hold
-            CL_BREAK_IF(winEnd <= beg);
-            CL_BREAK_IF(/* end */ it->first <= winBeg);
-
-            const TLeaf &os = lineIt->second;
-            std::copy(os.begin(), os.end(), std::inserter(dst, dst.begin()));
-
-            // increment for next wheel
-            if (lineItEnd == ++lineIt)
-                // end of line
-                break;
-
-            beg = lineIt->first;
-        }
-        while (beg < winEnd);
-    }
+    typename TCont::const_iterator it = this->firstAbove(winBeg);
+    for (; cont_.end() != it; ++it)
+        if (it->beg < winEnd)
+            dst.insert(it->fld);
 }
 
-// FIXME: brute-force method
-// FIXME: no assumptions can be made about the output format
 template <typename TInt, typename TFld>
 void IntervalArena<TInt, TFld>::reverseLookup(TKeySet &dst, const TFld fld)
     const
 {
-    key_type key;
-
-    BOOST_FOREACH(typename TCont::const_reference item, cont_) {
-        key/* end */.second = item/* end */.first;
-        const TLine &line = item.second;
+    IA_TRACE("r " << this << " " << fld);
 
-        BOOST_FOREACH(typename TLine::const_reference lineItem, line) {
-            const TLeaf &leaf = lineItem.second;
-            if (!hasKey(leaf, fld))
-                continue;
-
-            key/* beg */.first = lineItem/* beg */.first;
-            dst.push_back(key);
-        }
-    }
+    // the keys are reported in the order of their upper bounds
+    BOOST_FOREACH(const Item &item, cont_)
+        if (fld == item.fld)
+            dst.push_back(key_type(item.beg, item.end));
 }
 
 template <typename TInt, typename TFld>
 void IntervalArena<TInt, TFld>::exactMatch(TSet &dst, const key_type &key) const
 {
-    typedef typename TCont::const_iterator TEndIt;
-    const TEndIt itEnd = cont_.find(/* end */ key.second);
-    if (cont_.end() == itEnd)
-        // upper bound not found
-        return;
-
-    const TLine &line = itEnd->second;
-    const typename TLine::const_iterator itBeg = line.find(/* beg */ key.first);
-    if (line.end() == itBeg)
-        // lower bound not found
-        return;
+    IA_TRACE("e " << this << " " << key.first << " " << key.second);
 
-    const TLeaf &leaf = itBeg->second;
-    std::copy(leaf.begin(), leaf.end(), std::inserter(dst, dst.begin()));
+    typename TCont::const_iterator it = this->firstAbove(key.second - 1);
+    for (; cont_.end() != it && key.second == it->end; ++it)
+        if (key.first == it->beg)
+            dst.insert(it->fld);
 }
 
 #endif /* H_GUARD_INTARENA_H */
@@ -0,0 +1,477 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file intarena_bench.cc
+ * micro-benchmark of IntervalArena against its former std::map-based version
+ *
+ * Usage: intarena_bench [TRACE_FILE [REPEAT]]
+ *
+ * The trace can be recorded by predator built with IA_RECORD_TRACE enabled
+ * in intarena.hh.  If no trace file is given, a synthetic trace is generated
+ * that mimics field writes into objects of a few dozens of bytes.  Results of
+ * all queries are cross-checked between both implementations.
+ */
+
+#include "config.h"
+#include "trap.h"
+
+#include "intarena.hh"
+#include "util.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+typedef long                                TInt;
+typedef int                                 TFld;
+
+/// the former std::map-based implementation of IntervalArena (for comparison)
+template <typename TInt, typename TFld>
+class IntervalArenaMap {
+    public:
+        typedef std::set<TFld>                      TSet;
+
+        // for compatibility with STL
+        typedef std::pair<TInt, TInt>               key_type;
+        typedef std::pair<key_type, TFld>           value_type;
+
+        typedef std::vector<key_type>               TKeySet;
+
+    private:
+        typedef std::set<TFld>                      TLeaf;
+        typedef std::map</* beg */ TInt, TLeaf>     TLine;
+        typedef std::map</* end */ TInt, TLine>     TCont;
+        TCont                                       cont_;
+
+    public:
+        void add(const key_type &, TFld);
+        void sub(const key_type &, TFld);
+        void intersects(TSet &dst, const key_type &key) const;
+        void exactMatch(TSet &dst, const key_type &key) const;
+
+        /// return the set of all keys that map to this object
+        void reverseLookup(TKeySet &dst, TFld) const;
+
+        void clear() {
+            cont_.clear();
+        }
+
+        IntervalArenaMap& operator+=(const value_type &item) {
+            this->add(item.first, item.second);
+            return *this;
+        }
+
+        IntervalArenaMap& operator-=(const value_type &item) {
+            this->sub(item.first, item.second);
+            return *this;
+        }
+};
+
+template <typename TInt, typename TFld>
+void IntervalArenaMap<TInt, TFld>::add(const key_type &key, const TFld fld)
+{
+    const TInt beg = key.first;
+    const TInt end = key.second;
+    CL_BREAK_IF(end <= beg);
+
+    cont_[end][beg].insert(fld);
+}
+
+template <typename TInt, typename TFld>
+void IntervalArenaMap<TInt, TFld>::sub(const key_type &key, const TFld fld)
+{
+    const TInt winBeg = key.first;
+    const TInt winEnd = key.second;
+    CL_BREAK_IF(winEnd <= winBeg);
+
+    std::vector<value_type> recoverList;
+
+    const typename TCont::iterator itEnd = cont_.end();
+    typename TCont::iterator it =
+        cont_.lower_bound(winBeg + /* right-open interval given as key */ 1);
+
+    while (itEnd != it) {
+        TLine &line = it->second;
+        if (line.empty()) {
+            // skip orphans
+            ++it;
+            continue;
+        }
+        typename TLine::iterator lineIt = line.begin();
+        TInt beg = lineIt->first;
+        if (winEnd <= beg) {
+            // we are beyond the window already
+            ++it;
+            continue;
+        }
+
+        const TInt end = it->first;
+        bool anyHit = false;
+
+        const typename TLine::iterator lineItEnd = line.end();
+        do {
+            // make sure the basic window axioms hold
+            CL_BREAK_IF(winEnd <= beg);
+            CL_BREAK_IF(end <= winBeg);
+
+            // remove the object from the current leaf (if found)
+            TLeaf &os = lineIt->second;
+            if (os.erase(fld)) {
+                anyHit = true;
+
+                if (beg < winBeg) {
+                    // schedule "the part above" for re-insertion
+                    const key_type key(beg, winBeg);
+                    const value_type item(key, fld);
+                    recoverList.push_back(item);
+                }
+            }
+
+            ++lineIt;
+
+            if (lineItEnd == lineIt)
+                // end of line
+                break;
+
+            beg = lineIt->first;
+        }
+        while (beg < winEnd);
+
+        if (anyHit) {
+            if (winEnd < end) {
+                // schedule "the part beyond" for re-insertion
+                const key_type key(winEnd, end);
+                const value_type item(key, fld);
+                recoverList.push_back(item);
+            }
+        }
+
+        ++it;
+    }
+
+    // go through the recoverList and re-insert the missing parts
+    BOOST_FOREACH(const value_type &rItem, recoverList) {
+        const key_type &key = rItem.first;
+        const TFld fld = rItem.second;
+        const TInt beg = key.first;
+        const TInt end = key.second;
+
+        cont_[end][beg].insert(fld);
+    }
+}
+
+template <typename TInt, typename TFld>
+void IntervalArenaMap<TInt, TFld>::intersects(TSet &dst, const key_type &key) const
+{
+    const TInt winBeg = key.first;
+    const TInt winEnd = key.second;
+    CL_BREAK_IF(winEnd <= winBeg);
+
+    typename TCont::const_iterator it =
+        cont_.lower_bound(winBeg + /* right-open interval given as key */ 1);
+
+    for (; cont_.end() != it; ++it) {
+        const TLine &line = it->second;
+        if (line.empty())
+            // skip orphans
+            continue;
+        typename TLine::const_iterator lineIt = line.begin();
+        TInt beg = lineIt->first;
+        if (winEnd <= beg)
+            // we are beyond the window already
+            continue;
+
+        const typename TLine::const_iterator lineItEnd = line.end();
+        do {
+            // make sure the basic window axioms hold
+            CL_BREAK_IF(winEnd <= beg);
+            CL_BREAK_IF(/* end */ it->first <= winBeg);
+
+            const TLeaf &os = lineIt->second;
+            std::copy(os.begin(), os.end(), std::inserter(dst, dst.begin()));
+
+            // increment for next wheel
+            if (lineItEnd == ++lineIt)
+                // end of line
+                break;
+
+            beg = lineIt->first;
+        }
+        while (beg < winEnd);
+    }
+}
+
+// FIXME: brute-force method
+// FIXME: no assumptions can be made about the output format
+template <typename TInt, typename TFld>
+void IntervalArenaMap<TInt, TFld>::reverseLookup(TKeySet &dst, const TFld fld)
+    const
+{
+    key_type key;
+
+    BOOST_FOREACH(typename TCont::const_reference item, cont_) {
+        key/* end */.second = item/* end */.first;
+        const TLine &line = item.second;
+
+        BOOST_FOREACH(typename TLine::const_reference lineItem, line) {
+            const TLeaf &leaf = lineItem.second;
+            if (!hasKey(leaf, fld))
+                continue;
+
+            key/* beg */.first = lineItem/* beg */.first;
+            dst.push_back(key);
+        }
+    }
+}
+
+template <typename TInt, typename TFld>
+void IntervalArenaMap<TInt, TFld>::exactMatch(TSet &dst, const key_type &key) const
+{
+    typedef typename TCont::const_iterator TEndIt;
+    const TEndIt itEnd = cont_.find(/* end */ key.second);
+    if (cont_.end() == itEnd)
+        // upper bound not found
+        return;
+
+    const TLine &line = itEnd->second;
+    const typename TLine::const_iterator itBeg = line.find(/* beg */ key.first);
+    if (line.end() == itBeg)
+        // lower bound not found
+        return;
+
+    const TLeaf &leaf = itBeg->second;
+    std::copy(leaf.begin(), leaf.end(), std::inserter(dst, dst.begin()));
+}
+
+struct TraceOp {
+    char                    code;
+    int                     arena;      ///< index of the arena
+    int                     arenaSrc;   ///< source of '=' (copy) operations
+    TInt                    beg;
+    TInt                    end;
+    TFld                    fld;
+};
+
+typedef std::vector<TraceOp>                TTrace;
+
+/// read trace recorded with IA_RECORD_TRACE, map addresses to arena indexes
+bool readTrace(TTrace &dst, int *pCntArenas, const char *fileName)
+{
+    std::ifstream str(fileName);
+    if (!str)
+        return false;
+
+    typedef std::map<std::string, int> TAddrMap;
+    TAddrMap addrMap;
+    int cntArenas = 0;
+
+    std::string line;
+    while (std::getline(str, line)) {
+        std::istringstream lstr(line);
+        TraceOp op = TraceOp();
+        std::string addr;
+        lstr >> op.code >> addr;
+
+        // every destroyed arena gets a fresh index on the next use of addr
+        TAddrMap::iterator it = addrMap.find(addr);
+        if (addrMap.end() == it)
+            it = addrMap.insert(std::make_pair(addr, cntArenas++)).first;
+        op.arena = it->second;
+        if ('d' == op.code)
+            addrMap.erase(it);
+
+        switch (op.code) {
+            case '=':
+                lstr >> addr;
+                it = addrMap.find(addr);
+                if (addrMap.end() == it)
+                    it = addrMap.insert(std::make_pair(addr, cntArenas++)).first;
+                op.arenaSrc = it->second;
+                break;
+
+            case 'a':
+            case 's':
+                lstr >> op.beg >> op.end >> op.fld;
+                break;
+
+            case 'i':
+            case 'e':
+                lstr >> op.beg >> op.end;
+                break;
+
+            case 'r':
+                lstr >> op.fld;
+                break;
+        }
+
+        dst.push_back(op);
+    }
+
+    *pCntArenas = cntArenas;
+    return true;
+}
+
+/// generate a synthetic trace that resembles field writes into small objects
+void genTrace(TTrace &dst, int *pCntArenas)
+{
+    const int cntArenas = 0x100;
+    const int cntOps = 0x40000;
+    srand(0);
+
+    for (int i = 0; i < cntOps; ++i) {
+        TraceOp op = TraceOp();
+        op.arena = rand() % cntArenas;
+        op.beg = 4 * (rand() % 16);
+        op.end = op.beg + 4 * (1 + rand() % 4);
+        op.fld = rand() % 64;
+
+        switch (rand() % 16) {
+            case 0:
+                op.code = 's';
+                break;
+
+            case 1:
+                op.code = 'e';
+                break;
+
+            case 2:
+                op.code = 'r';
+                break;
+
+            case 3:
+                op.code = (rand() % 8) ? '=' : 'c';
+                op.arenaSrc = rand() % cntArenas;
+                break;
+
+            default:
+                // queries and writes are the most frequent
+                op.code = (rand() % 2) ? 'a' : 'i';
+        }
+
+        dst.push_back(op);
+    }
+
+    *pCntArenas = cntArenas;
+}
+
+/// replay the trace and return a checksum of all query results
+template <class TArena>
+size_t replayTrace(const TTrace &trace, const int cntArenas, double *pTime)
+{
+    typedef typename TArena::key_type TKey;
+    typedef typename TArena::value_type TItem;
+
+    std::vector<TArena> arenas(cntArenas);
+    size_t sum = 0;
+
+    const clock_t start = clock();
+    BOOST_FOREACH(const TraceOp &op, trace) {
+        TArena &arena = arenas[op.arena];
+        const TKey key(op.beg, op.end);
+
+        typename TArena::TSet result;
+        typename TArena::TKeySet keys;
+        switch (op.code) {
+            case 'a':
+                arena += TItem(key, op.fld);
+                break;
+
+            case 's':
+                arena -= TItem(key, op.fld);
+                break;
+
+            case 'i':
+                arena.intersects(result, key);
+                break;
+
+            case 'e':
+                arena.exactMatch(result, key);
+                break;
+
+            case 'r':
+                arena.reverseLookup(keys, op.fld);
+                break;
+
+            case '=':
+                arena = arenas[op.arenaSrc];
+                break;
+
+            case 'c':
+            case 'd':
+                arena.clear();
+                break;
+        }
+
+        // fold the results into the checksum (key order does not matter)
+        sum = sum * 31 + result.size() + keys.size();
+        BOOST_FOREACH(const TFld fld, result)
+            sum += fld;
+        BOOST_FOREACH(const TKey &k, keys)
+            sum += k.first * 7 + k.second;
+    }
+
+    *pTime = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+    return sum;
+}
+
+int main(int argc, char *argv[])
+{
+    TTrace trace;
+    int cntArenas;
+    if (1 < argc) {
+        if (!readTrace(trace, &cntArenas, argv[1])) {
+            std::cerr << "failed to read trace: " << argv[1] << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    else
+        genTrace(trace, &cntArenas);
+
+    const int repeat = (2 < argc) ? atoi(argv[2]) : 8;
+    std::cout << trace.size() << " operations on " << cntArenas
+        << " arenas, " << repeat << " round(s)\n";
+
+    double timeMap = 0.0, timeFlat = 0.0;
+    for (int i = 0; i < repeat; ++i) {
+        double t;
+        const size_t sumMap = replayTrace<IntervalArenaMap<TInt, TFld> >(
+                trace, cntArenas, &t);
+        timeMap += t;
+
+        const size_t sumFlat = replayTrace<IntervalArena<TInt, TFld> >(
+                trace, cntArenas, &t);
+        timeFlat += t;
+
+        if (sumMap != sumFlat) {
+            std::cerr << "results of the implementations differ!\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::cout << "std::map-based: " << timeMap << " s\n"
+        << "flat vector:    " << timeFlat << " s\n";
+
+    return EXIT_SUCCESS;
+}
@@ -25,6 +25,7 @@
 #include <cl/clutil.hh>
 #include <cl/storage.hh>
 
+#include "glconf.hh"
 #include "prototype.hh"
 #include "symcmp.hh"
 #include "symdebug.hh"
@@ -310,10 +311,17 @@ bool applyAbstraction(
 
         // create the trace node in advance, so that we can capture ID mapping
         using namespace Trace;
-        AbstractionNode *trAbs = new AbstractionNode(sh.traceNode(), kind);
-        NodeHandle trAbsHandle(trAbs);
+        Node *trOrig = sh.traceNode();
+        AbstractionNode *trAbs = (GlConf::data.noTrace)
+            ? 0
+            : new AbstractionNode(trOrig, kind);
+        NodeHandle trAbsHandle((trAbs) ? trAbs : trOrig);
 
-        if (!segAbstractionStep(sh, shape.props, &cursor, trAbs->idMapper())) {
+        // the ID mapping is thrown away if the trace graph is disabled
+        TIdMapper idMapNoTrace;
+        TIdMapper &idMap = (trAbs) ? trAbs->idMapper() : idMapNoTrace;
+
+        if (!segAbstractionStep(sh, shape.props, &cursor, idMap)) {
             CL_DEBUG("<-- validity of next " << (len - i - 1)
                     << " abstraction step(s) broken, forcing re-discovery...");
 
@@ -328,9 +336,11 @@ bool applyAbstraction(
         std::string pName;
         LDP_PLOTN(symabstract, sh, &pName);
 
-        // abstraction step has succeeded, update the trace graph!
-        trAbs->setPlotName(pName);
-        sh.traceUpdate(trAbs);
+        if (trAbs) {
+            // abstraction step has succeeded, update the trace graph!
+            trAbs->setPlotName(pName);
+            sh.traceUpdate(trAbs);
+        }
 
         CL_BREAK_IF(!protoCheckConsistency(sh));
     }
@@ -349,11 +359,14 @@ void dlSegReplaceByConcrete(SymHeap &sh, const TObjId obj)
     CL_BREAK_IF(!segCheckConsistency(sh));
     CL_BREAK_IF(!protoCheckConsistency(sh));
 
-    // append a trace node for this operation (object IDs preserved 1:1)
-    Trace::Node *trOrig = sh.traceNode();
-    Trace::Node *trNode = new Trace::ConcretizationNode(trOrig, OK_DLS, pName);
-    trNode->idMapper().setNotFoundAction(Trace::TIdMapper::NFA_RETURN_IDENTITY);
-    sh.traceUpdate(trNode);
+    if (!GlConf::data.noTrace) {
+        // append a trace node for this operation (object IDs preserved 1:1)
+        Trace::Node *trOrig = sh.traceNode();
+        Trace::Node *trNode =
+            new Trace::ConcretizationNode(trOrig, OK_DLS, pName);
+        trNode->setNotFoundAction(Trace::TIdMapper::NFA_RETURN_IDENTITY);
+        sh.traceUpdate(trNode);
+    }
 
     // redirect all references originally pointing to obj
     redirectRefs(sh,
@@ -381,14 +394,19 @@ void spliceOutListSegment(
     CL_BREAK_IF(objMinLength(sh, seg));
 
     // append a trace node representing this operation
-    Trace::Node *const trNode = new Trace::SpliceOutNode(sh.traceNode());
-    sh.traceUpdate(trNode);
+    Trace::TIdMapper idMapNoTrace;
+    Trace::TIdMapper *pIdMap = &idMapNoTrace;
+    if (!GlConf::data.noTrace) {
+        Trace::Node *const trNode = new Trace::SpliceOutNode(sh.traceNode());
+        sh.traceUpdate(trNode);
+        pIdMap = &trNode->idMapper();
+    }
 
     const TValId valNext = nextValFromSeg(sh, seg);
     const TObjId objNext = sh.objByAddr(valNext);
     const TOffset offHead = headOffset(sh, seg);
 
-    Trace::TIdMapper &idMap = trNode->idMapper();
+    Trace::TIdMapper &idMap = *pIdMap;
     if (sh.isValid(objNext)) {
         // map the next object as continuation of the empty variant of 0+ DLS
         idMap.insert(seg, objNext);
@@ -483,6 +501,9 @@ void abstractIfNeeded(SymHeap &sh)
         // some part of the symbolic heap has just been successfully abstracted,
         // let's look if there remains anything else suitable for abstraction
     }
+
+    // the next discovery needs to probe only objects written from now on
+    sh.resetDirtyObjects();
 }
 
 void concretizeObj(
@@ -505,12 +526,18 @@ void concretizeObj(
     const EObjKind kind = sh.objKind(seg);
 
     // append a trace node for this operation
-    Trace::Node *trOrig = sh.traceNode();
-    Trace::Node *trNode = new Trace::ConcretizationNode(trOrig, kind, pName);
-    sh.traceUpdate(trNode);
+    Trace::TIdMapper idMapNoTrace;
+    Trace::TIdMapper *pIdMap = &idMapNoTrace;
+    if (!GlConf::data.noTrace) {
+        Trace::Node *trOrig = sh.traceNode();
+        Trace::Node *trNode =
+            new Trace::ConcretizationNode(trOrig, kind, pName);
+        sh.traceUpdate(trNode);
+        pIdMap = &trNode->idMapper();
+    }
 
     // set default ID mapping to identity
-    Trace::TIdMapper &idMapper = trNode->idMapper();
+    Trace::TIdMapper &idMapper = *pIdMap;
     idMapper.setNotFoundAction(Trace::TIdMapper::NFA_RETURN_IDENTITY);
 
     if (isMayExistObj(kind)) {
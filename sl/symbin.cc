@@ -28,6 +28,7 @@
 #include "../include/predator-builtins/verifier-builtins.h"
 #undef PREDATOR
 
+#include "glconf.hh"
 #include "symabstract.hh"
 #include "symdump.hh"
 #include "symgc.hh"
@@ -1097,7 +1098,9 @@ bool BuiltInTable::handleBuiltIn(
         hdl = it->second;
 
     SymHeap &sh = core.sh();
-    sh.traceUpdate(new Trace::InsnNode(sh.traceNode(), &insn, /* bin */ true));
+    if (!GlConf::data.noTrace)
+        sh.traceUpdate(
+                new Trace::InsnNode(sh.traceNode(), &insn, /* bin */ true));
 
     return hdl(dst, core, insn, name);
 }
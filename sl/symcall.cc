@@ -21,6 +21,7 @@
 #include "symcall.hh"
 
 #include <cl/cl_msg.hh>
+#include <cl/memdebug.hh>
 #include <cl/storage.hh>
 
 #include "glconf.hh"
@@ -33,6 +34,7 @@
 #include "symjoin.hh"
 #include "symproc.hh"
 #include "symstate.hh"
+#include "symsummary.hh"
 #include "symutil.hh"
 #include "symtrace.hh"
 #include "util.hh"
@@ -49,16 +51,28 @@ LOCAL_DEBUG_PLOTTER(symcall, DEBUG_SYMCALL)
 class PerFncCache {
     private:
         typedef std::vector<SymCallCtx *> TCtxMap;
+        typedef std::vector<JoinSignature> TSigList;
+        typedef std::vector<bool> TSigDone;
 
         SymHeapUnion    huni_;
         TCtxMap         ctxMap_;
+        TSigList        sigs_;          ///< used by join-based lookup only
+        TSigDone        sigDone_;       ///< true if sigs_[i] is up to date
 #if !SE_ENABLE_CALL_CACHE
         SymCallCtx     *null_;
 #endif
         int             missCntSinceLastHit_;
+        unsigned long   lastHit_;
 
         int lookupCore(const SymHeap &sh);
 
+        bool joinable(int idx, const JoinSignature &sig);
+
+        void swapEntry(int idx, SymHeap &sh) {
+            huni_.swapExisting(idx, sh);
+            sigDone_[idx] = false;
+        }
+
         void cacheHit() {
             if (0 < missCntSinceLastHit_)
                 missCntSinceLastHit_ = 0;
@@ -68,7 +82,8 @@ class PerFncCache {
 
     public:
         PerFncCache():
-            missCntSinceLastHit_(0)
+            missCntSinceLastHit_(0),
+            lastHit_(0UL)
         {
         }
 
@@ -82,6 +97,25 @@ class PerFncCache {
             return missCntSinceLastHit_;
         }
 
+        /// count of call contexts kept by this cache
+        int size() const {
+            return ctxMap_.size();
+        }
+
+        /// time stamp of the last cache hit (or of the first miss if no hit)
+        unsigned long lastHit() const {
+            return lastHit_;
+        }
+
+        void stampHit(unsigned long stamp) {
+            lastHit_ = stamp;
+        }
+
+        void stampMiss(unsigned long stamp) {
+            if (!lastHit_)
+                lastHit_ = stamp;
+        }
+
         bool inUse() const {
             BOOST_FOREACH(const SymCallCtx *ctx, ctxMap_)
                 if (ctx->inUse())
@@ -99,7 +133,7 @@ class PerFncCache {
             CL_BREAK_IF(!areEqual(of, huni_[idx]));
 
             Trace::waiveCloneOperation(by);
-            huni_.swapExisting(idx, by);
+            this->swapEntry(idx, by);
             missCntSinceLastHit_ = missCnt;
         }
 
@@ -117,6 +151,22 @@ class PerFncCache {
         }
 };
 
+bool PerFncCache::joinable(const int idx, const JoinSignature &sig)
+{
+#if SE_JOIN_PREFILTER
+    if (!sigDone_[idx]) {
+        joinSignature(&sigs_[idx], huni_[idx]);
+        sigDone_[idx] = true;
+    }
+
+    return joinSigCompatible(sigs_[idx], sig);
+#else
+    (void) idx;
+    (void) sig;
+    return true;
+#endif
+}
+
 int PerFncCache::lookupCore(const SymHeap &sh)
 {
 #if 1 < SE_ENABLE_CALL_CACHE
@@ -124,13 +174,28 @@ int PerFncCache::lookupCore(const SymHeap &sh)
         CL_DIE("SE_STATE_ON_THE_FLY_ORDERING"
                " is incompatible with join-based call cache");
 
+    // an isomorphic entry is found by fingerprint without trying any join
+    int idx = huni_.lookup(sh);
+    if (-1 != idx) {
+        this->cacheHit();
+        return idx;
+    }
+
     EJoinStatus     status;
     SymHeap         result(sh.stor(), new Trace::TransientNode("PerFncCache"));
     const int       cnt = huni_.size();
-    int             idx;
+
+    JoinSignature sig;
+#if SE_JOIN_PREFILTER
+    joinSignature(&sig, sh);
+#endif
 
     // try join
     for(idx = 0; idx < cnt; ++idx) {
+        if (!this->joinable(idx, sig))
+            // the join would fail anyway
+            continue;
+
         const SymHeap &shIn = huni_[idx];
         if (!joinSymHeaps(&status, &result, shIn, sh))
             // join failed with this heap, try the next one
@@ -160,12 +225,12 @@ int PerFncCache::lookupCore(const SymHeap &sh)
 
         // update the cache entry
         if (JS_THREE_WAY == status)
-            huni_.swapExisting(idx, result);
+            this->swapEntry(idx, result);
         else {
             CL_BREAK_IF(JS_USE_SH2 != status);
             SymHeap shDup(sh);
             Trace::waiveCloneOperation(shDup);
-            huni_.swapExisting(idx, shDup);
+            this->swapEntry(idx, shDup);
         }
 
         this->cacheHit();
@@ -179,6 +244,8 @@ int PerFncCache::lookupCore(const SymHeap &sh)
 
         if (1 < GlConf::data.stateLiveOrdering) {
             rotate(ctxMap_.begin(), ctxMap_.begin() + idx, ctxMap_.end());
+            rotate(sigs_.begin(), sigs_.begin() + idx, sigs_.end());
+            rotate(sigDone_.begin(), sigDone_.begin() + idx, sigDone_.end());
             idx = 0;
         }
 
@@ -190,6 +257,8 @@ int PerFncCache::lookupCore(const SymHeap &sh)
     idx = ctxMap_.size();
     huni_.insertNew(sh);
     ctxMap_.push_back((SymCallCtx *) 0);
+    sigs_.push_back(JoinSignature());
+    sigDone_.push_back(false);
     CL_BREAK_IF(huni_.size() != ctxMap_.size());
 
     ++missCntSinceLastHit_;
@@ -208,13 +277,15 @@ struct SymCallCache::Private {
     TCache                      cache;
     TCtxStack                   ctxStack;
     SymBackTrace                bt;
+    unsigned long               clock;
 
     void importGlVar(SymHeap &sh, const CVar &cv);
     void resolveHeapCut(TCVarList &cut, SymHeap &sh, TFncRef fnc);
     SymCallCtx* getCallCtx(const SymHeap &entry, TFncRef fnc);
 
     Private(TStorRef stor):
-        bt(stor)
+        bt(stor),
+        clock(0UL)
     {
     }
 };
@@ -231,6 +302,8 @@ struct SymCallCtx::Private {
     int                         nestLevel;
     bool                        computed;
     bool                        flushed;
+    int                         cntMsgs;    ///< messages emitted before call
+    bool                        dirty;      ///< results hide some messages
 
     void assignReturnValue(SymHeap &sh);
     void destroyStackFrame(SymHeap &sh);
@@ -244,19 +317,32 @@ struct SymCallCtx::Private {
         callFrame(cd_->bt.stor(),
                 new Trace::TransientNode("SymCallCtx::Private::callFrame")),
         computed(false),
-        flushed(false)
+        flushed(false),
+        cntMsgs(0),
+        dirty(false)
     {
     }
 };
 
+/// count of errors and warnings emitted so far
+static int cntMessages()
+{
+    return cl_cnt_errors() + cl_cnt_warnings();
+}
+
+/// count of live call contexts, sampled by printMemUsage()
+static MemCounter cntCallCtxs("call_ctxs");
+
 SymCallCtx::SymCallCtx(SymCallCache::Private *cd):
     d(new Private(cd))
 {
+    cntCallCtxs.inc();
 }
 
 SymCallCtx::~SymCallCtx()
 {
     delete d;
+    cntCallCtxs.dec();
 }
 
 bool SymCallCtx::needExec() const
@@ -364,8 +450,13 @@ void joinHeapsWithCare(
     LDP_PLOT(symcall, callFrame);
 
     // create a new trace graph node
+    Node *trCallFrame = callFrame.traceNode();
+    if (!GlConf::data.noTrace)
+        // bypass the clone node
+        trCallFrame = trCallFrame->parent();
+
     NodeHandle trResult(sh.traceNode());
-    NodeHandle trFrame(callFrame.traceNode()->parent());
+    NodeHandle trFrame(trCallFrame);
 
     // first off, we need to make sure that a gl variable from callFrame will
     // not overwrite the result of just completed function call since the var
@@ -397,9 +488,11 @@ void joinHeapsWithCare(
         isFrameAlive = !liveVars.empty();
     }
 
-    Node *trDone = (isFrameAlive)
-        ? new CallDoneNode(trResult.node(), trFrame.node(), fnc)
-        : new CallDoneNode(trResult.node(), fnc);
+    Node *trDone = trResult.node();
+    if (!GlConf::data.noTrace)
+        trDone = (isFrameAlive)
+            ? new CallDoneNode(trResult.node(), trFrame.node(), fnc)
+            : new CallDoneNode(trResult.node(), fnc);
 
     joinHeapsByCVars(&sh, &callFrame);
     sh.traceUpdate(trDone);
@@ -417,6 +510,16 @@ void SymCallCtx::flushCallResults(SymState &dst)
     CL_BREAK_IF(this != d->cd->ctxStack.back());
     d->cd->ctxStack.pop_back();
 
+    if (!d->computed) {
+        // the results of a call that has reported something cannot be reused
+        // by the next run, which would not report anything then
+        if (cntMessages() != d->cntMsgs)
+            d->dirty = true;
+
+        if (!d->dirty)
+            recordFncSummary(*d->fnc, d->entry, d->rawResults);
+    }
+
     // go through the results and make them of the form that the caller likes
     const unsigned cnt = d->rawResults.size();
     for (unsigned i = 0; i < cnt; ++i) {
@@ -430,7 +533,7 @@ void SymCallCtx::flushCallResults(SymState &dst)
         SymHeap sh(origin);
         waiveCloneOperation(sh);
 
-        if (d->computed) {
+        if (d->computed && !GlConf::data.noTrace) {
             // call cache hit --> tag the raw result as cached
             Node *trEntry = d->entry.traceNode();
             Node *trOrig = origin.traceNode();
@@ -514,6 +617,34 @@ SymBackTrace& SymCallCache::bt()
     return d->bt;
 }
 
+int SymCallCache::evictColdEntries()
+{
+    typedef Private::TCache TCache;
+    typedef std::pair<unsigned long /* last hit */, int /* uid */> TItem;
+    typedef std::vector<TItem> TItemList;
+
+    // gather caches that are not used by the current backtrace
+    TItemList items;
+    BOOST_FOREACH(TCache::const_reference item, d->cache) {
+        const PerFncCache &pfc = item.second;
+        if (!pfc.inUse())
+            items.push_back(TItem(pfc.lastHit(), /* uid */ item.first));
+    }
+
+    // drop the half of them that has gone without a hit for the longest time
+    std::sort(items.begin(), items.end());
+    items.resize((items.size() + 1U) / 2U);
+
+    int cntCtxs = 0;
+    BOOST_FOREACH(const TItem &item, items) {
+        const TCache::iterator it = d->cache.find(item.second);
+        cntCtxs += it->second.size();
+        d->cache.erase(it);
+    }
+
+    return cntCtxs;
+}
+
 void pullGlVar(SymHeap &result, SymHeap origin, const CVar &cv)
 {
     // do not try to combine things, it causes problems
@@ -568,7 +699,9 @@ void SymCallCache::Private::importGlVar(SymHeap &entry, const CVar &cv)
 #endif
 
     // create a trace node for this call of importGlVar()
-    entry.traceUpdate(new Trace::ImportGlVarNode(entry.traceNode(), varString));
+    if (!GlConf::data.noTrace)
+        entry.traceUpdate(
+                new Trace::ImportGlVarNode(entry.traceNode(), varString));
 
     // seek the gl var going through the ctx stack backward
     int idx;
@@ -720,17 +853,29 @@ SymCallCtx* SymCallCache::Private::getCallCtx(const SymHeap &entry, TFncRef fnc)
     // cache lookup
     const int uid = uidOf(fnc);
     PerFncCache &pfc = this->cache[uid];
+    const unsigned long stamp = ++this->clock;
     SymCallCtx *&ctx = pfc.lookup(entry);
     if (!ctx) {
         // cache miss
+        pfc.stampMiss(stamp);
         ctx = new SymCallCtx(this);
         ctx->d->fnc     = &fnc;
         ctx->d->entry   = entry;
         Trace::waiveCloneOperation(ctx->d->entry);
 
-        // enter ctx stack
-        this->ctxStack.push_back(ctx);
-        return ctx;
+        if (!lookupFncSummary(ctx->d->rawResults, fnc, entry)) {
+            ctx->d->cntMsgs = cntMessages();
+
+            // enter ctx stack
+            this->ctxStack.push_back(ctx);
+            return ctx;
+        }
+
+        // the results have been computed by a previous run
+        CL_DEBUG_MSG(locationOf(fnc), "SymCallCache uses a summary of "
+                << nameOf(fnc) << "()");
+        ctx->d->computed = true;
+        ctx->d->flushed  = true;
     }
 
     const struct cl_loc *loc = locationOf(fnc);
@@ -749,6 +894,14 @@ SymCallCtx* SymCallCache::Private::getCallCtx(const SymHeap &entry, TFncRef fnc)
         return 0;
     }
 
+    pfc.stampHit(stamp);
+
+    if (ctx->d->dirty) {
+        // the messages of the cached call are not going to be reported again
+        BOOST_FOREACH(SymCallCtx *caller, this->ctxStack)
+            caller->d->dirty = true;
+    }
+
     // enter ctx stack
     this->ctxStack.push_back(ctx);
 
@@ -764,11 +917,15 @@ SymCallCtx* SymCallCache::getCallCtx(
     const struct cl_loc *loc = &insn.loc;
     CL_DEBUG_MSG(loc, "SymCallCache is looking for " << nameOf(fnc) << "()...");
 
-    // build two new nodes of the trace graph
+    // build two new nodes of the trace graph (unless it is disabled)
     Trace::waiveCloneOperation(entry);
     Trace::Node *trCall = entry.traceNode();
-    Trace::Node *trEntry = new Trace::CallEntryNode(trCall, &insn);
-    Trace::Node *trFrame = new Trace::CallFrameNode(trCall, &insn);
+    Trace::Node *trEntry = trCall;
+    Trace::Node *trFrame = trCall;
+    if (!GlConf::data.noTrace) {
+        trEntry = new Trace::CallEntryNode(trCall, &insn);
+        trFrame = new Trace::CallFrameNode(trCall, &insn);
+    }
 
     // enlarge the backtrace
     const int uid = uidOf(fnc);
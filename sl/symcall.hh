@@ -46,6 +46,13 @@ class SymCallCache {
 
         SymBackTrace& bt();
 
+        /**
+         * drop the half of per-function caches that are not used by the
+         * current backtrace and have gone without a cache hit for the longest
+         * @return count of call contexts that have been dropped
+         */
+        int evictColdEntries();
+
         /**
          * cache entry point.  This returns either existing, or a newly created
          * call context.
@@ -27,7 +27,10 @@
 #include "util.hh"
 #include "worklist.hh"
 
+#include <set>
+
 #include <boost/foreach.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/tuple/tuple.hpp>
 
 bool matchOffsets(
@@ -127,6 +130,10 @@ bool matchRoots(
     const TObjId obj1 = sh1.objByAddr(root1);
     const TObjId obj2 = sh2.objByAddr(root2);
 
+    if (obj1 == obj2 && sh1.objShared(obj1, sh2))
+        // the object has not been touched since the heaps were copied
+        return true;
+
     const TSizeRange size1 = sh1.objSize(obj1);
     const TSizeRange size2 = sh2.objSize(obj2);
     if (size1 != size2)
@@ -327,6 +334,18 @@ bool areEqual(
         const SymHeap           &sh1,
         const SymHeap           &sh2)
 {
+    if (&sh1 == &sh2 || sh1.sharesAll(sh2))
+        // copy-on-write did not trigger since the heaps were copied
+        return true;
+
+    unsigned cntNeqs1, cntCoins1;
+    unsigned cntNeqs2, cntCoins2;
+    sh1.cntPreds(&cntNeqs1, &cntCoins1);
+    sh2.cntPreds(&cntNeqs2, &cntCoins2);
+    if (cntNeqs1 != cntNeqs2 || cntCoins1 != cntCoins2)
+        // matchPreds() below would need a bijection between the predicates
+        return false;
+
     SymHeap &sh1Writable = const_cast<SymHeap &>(sh1);
     SymHeap &sh2Writable = const_cast<SymHeap &>(sh2);
 
@@ -357,3 +376,114 @@ bool areEqual(
     return sh1.matchPreds(sh2, vMap[0])
         && sh2.matchPreds(sh1, vMap[1]);
 }
+
+/// hash the properties of the target checked by cmpValues() and matchRoots()
+THeapHash hashOfTarget(const SymHeap &sh, const TValId val)
+{
+    THeapHash seed = 0;
+    boost::hash_combine(seed, static_cast<int>(sh.targetSpec(val)));
+
+    if (VT_RANGE == sh.valTarget(val)) {
+        const IR::Range offRange = sh.valOffsetRange(val);
+        boost::hash_combine(seed, offRange.lo);
+        boost::hash_combine(seed, offRange.hi);
+        boost::hash_combine(seed, offRange.alignment);
+    }
+    else
+        boost::hash_combine(seed, sh.valOffset(val));
+
+    const TObjId obj = sh.objByAddr(val);
+    boost::hash_combine(seed, sh.isValid(obj));
+
+    const TSizeRange size = sh.objSize(obj);
+    boost::hash_combine(seed, size.lo);
+    boost::hash_combine(seed, size.hi);
+
+    // types with different UIDs may still be equal, so hash only their code
+    const TObjType clt = sh.objEstimatedType(obj);
+    boost::hash_combine(seed, (clt) ? static_cast<int>(clt->code) : -1);
+
+    boost::hash_combine(seed, sh.objProtoLevel(obj));
+
+    const EObjKind kind = sh.objKind(obj);
+    boost::hash_combine(seed, static_cast<int>(kind));
+    if (OK_REGION == kind)
+        return seed;
+
+    boost::hash_combine(seed, sh.segMinLength(obj));
+    if (OK_OBJ_OR_NULL == kind)
+        return seed;
+
+    const BindingOff &bf = sh.segBinding(obj);
+    boost::hash_combine(seed, bf.head);
+    boost::hash_combine(seed, bf.next);
+    boost::hash_combine(seed, bf.prev);
+    return seed;
+}
+
+THeapHash heapFingerprint(const SymHeap &sh)
+{
+    SymHeap &shWritable = const_cast<SymHeap &>(sh);
+
+    // areEqual() requires the sets of program variables to match exactly
+    TCVarSet cVars;
+    gatherProgramVars(cVars, sh);
+
+    THeapHash seed = 0;
+    WorkList<TObjId> wl;
+    BOOST_FOREACH(const CVar &cv, cVars) {
+        boost::hash_combine(seed, cv.uid);
+        boost::hash_combine(seed, cv.inst);
+
+        const TObjId reg = shWritable.regionByVar(cv, /* createIfNeeded */ false);
+        if (OBJ_INVALID != reg)
+            wl.schedule(reg);
+    }
+
+    // the order in which we reach the objects depends on their IDs, so we
+    // need to combine the hashes of objects in a commutative way
+    THeapHash sumOfObjs = 0;
+
+    TObjId obj;
+    while (wl.next(obj)) {
+        // the same field may be live with more than one type in only one of
+        // the heaps being compared, so we hash the set of distinct fields
+        std::set<THeapHash> fldHashes;
+
+        FldList fields;
+        sh.gatherLiveFields(fields, obj);
+        BOOST_FOREACH(const FldHandle &fld, fields) {
+            const TValId val = fld.value();
+            if (val <= 0)
+                // special values are not worth hashing
+                continue;
+
+            const EValueTarget code = sh.valTarget(val);
+
+            THeapHash fldHash = 0;
+            boost::hash_combine(fldHash, fld.offset());
+            boost::hash_combine(fldHash, static_cast<int>(code));
+
+            if (!isAnyDataArea(code))
+                // gatherLiveFields() does not see fields covered by uniform
+                // blocks, whereas areEqual() reads them through the blocks, so
+                // a custom value may be explicit in only one of the heaps; we
+                // are not able to compare other values without a mapping
+                continue;
+
+            boost::hash_combine(fldHash, hashOfTarget(sh, val));
+            wl.schedule(sh.objByAddr(val));
+
+            fldHashes.insert(fldHash);
+        }
+
+        THeapHash objHash = 0;
+        BOOST_FOREACH(const THeapHash fldHash, fldHashes)
+            boost::hash_combine(objHash, fldHash);
+
+        sumOfObjs += objHash;
+    }
+
+    boost::hash_combine(seed, sumOfObjs);
+    return seed;
+}
@@ -32,11 +32,22 @@
 /// either intra-heap or inter-heap value mapping
 typedef TValMap                                             TValMapBidir[2];
 
+/// a hash of symbolic heap that does not depend on IDs of its entities
+typedef size_t                                              THeapHash;
+
 /// @todo some dox
 bool areEqual(
         const SymHeap           &sh1,
         const SymHeap           &sh2);
 
+/**
+ * compute a cheap hash of the given heap that is invariant under isomorphism
+ *
+ * areEqual(sh1, sh2) implies heapFingerprint(sh1) == heapFingerprint(sh2), so
+ * areEqual() needs to be called only for pairs of heaps with equal fingerprint
+ */
+THeapHash heapFingerprint(const SymHeap &sh);
+
 inline bool checkNonPosValues(int a, int b)
 {
     if (0 < a && 0 < b)
@@ -675,14 +675,12 @@ bool selectBestAbstraction(
     return true;
 }
 
-bool discoverBestAbstraction(Shape *pDst, SymHeap &sh)
+void gatherSegCandidates(
+        TSegCandidateList          &dst,
+        SymHeap                    &sh,
+        const TObjList             &entries)
 {
-    TSegCandidateList candidates;
-
-    // go through all potential segment entries
-    TObjList heapObjs;
-    sh.gatherObjects(heapObjs, isOnHeap);
-    BOOST_FOREACH(const TObjId obj, heapObjs) {
+    BOOST_FOREACH(const TObjId obj, entries) {
         /// probe neighbouring objects
         SegCandidate segc;
         digShapePropsCandidates(&segc.propsList, sh, obj);
@@ -692,8 +690,92 @@ bool discoverBestAbstraction(Shape *pDst, SymHeap &sh)
 
         // append a segment candidate
         segc.entry = obj;
-        candidates.push_back(segc);
+        dst.push_back(segc);
+    }
+}
+
+#if SE_DISCOVER_NEAR_DIRTY
+/// gather heap objects at most SE_DISCOVER_NEAR_DIRTY hops from a dirty one
+bool gatherObjectsNearDirty(TObjList &dst, const SymHeap &sh)
+{
+    TObjSet seen;
+    if (!sh.gatherDirtyObjects(seen))
+        // all objects are dirty
+        return false;
+
+    TObjList wl(seen.begin(), seen.end());
+    for (int hops = 0; hops < (SE_DISCOVER_NEAR_DIRTY) && !wl.empty(); ++hops) {
+        TObjList next;
+        BOOST_FOREACH(const TObjId obj, wl) {
+            if (!sh.isValid(obj))
+                continue;
+
+            // objects pointed by this object
+            FldList fields;
+            sh.gatherLiveFields(fields, obj);
+            BOOST_FOREACH(const FldHandle &fld, fields) {
+                const TObjId tgt = sh.objByAddr(fld.value());
+                if (OBJ_INVALID != tgt && insertOnce(seen, tgt))
+                    next.push_back(tgt);
+            }
+
+            // objects pointing to this object
+            FldList refs;
+            sh.pointedBy(refs, obj);
+            BOOST_FOREACH(const FldHandle &fld, refs) {
+                const TObjId src = fld.obj();
+                if (insertOnce(seen, src))
+                    next.push_back(src);
+            }
+        }
+
+        wl.swap(next);
     }
 
+    // keep the order of SymHeap::gatherObjects() for equal-cost candidates
+    BOOST_FOREACH(const TObjId obj, seen)
+        if (sh.isValid(obj) && isOnHeap(sh.objStorClass(obj)))
+            dst.push_back(obj);
+
+    return true;
+}
+#endif
+
+bool discoverBestAbstraction(Shape *pDst, SymHeap &sh)
+{
+    TSegCandidateList candidates;
+
+#if SE_DISCOVER_NEAR_DIRTY
+    TObjList nearObjs;
+    if (gatherObjectsNearDirty(nearObjs, sh)) {
+        // probe only the neighbourhood of objects written since last time
+        gatherSegCandidates(candidates, sh, nearObjs);
+        const bool found = selectBestAbstraction(pDst, sh, candidates);
+# if DEBUG_SYMDISCOVER
+        Shape shapeAll;
+        TSegCandidateList candidatesAll;
+        TObjList heapObjs;
+        sh.gatherObjects(heapObjs, isOnHeap);
+        gatherSegCandidates(candidatesAll, sh, heapObjs);
+        const bool foundAll = selectBestAbstraction(&shapeAll, sh, candidatesAll);
+        if (found != foundAll || (found && *pDst != shapeAll)) {
+            CL_DEBUG("discoverBestAbstraction() restricted to "
+                    << nearObjs.size() << " of " << heapObjs.size()
+                    << " heap objects differs from the full scan");
+            if (foundAll)
+                *pDst = shapeAll;
+
+            return foundAll;
+        }
+# endif
+        return found;
+    }
+#endif
+
+    // go through all potential segment entries
+    TObjList heapObjs;
+    sh.gatherObjects(heapObjs, isOnHeap);
+    gatherSegCandidates(candidates, sh, heapObjs);
+
     return selectBestAbstraction(pDst, sh, candidates);
 }
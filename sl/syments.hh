@@ -22,6 +22,7 @@
 
 #include "config.h"
 
+#include <algorithm>
 #include <vector>
 
 #include <boost/foreach.hpp>
@@ -176,6 +177,47 @@ struct EntCounter {
 #endif
 };
 
+/// fixed-size block of entity pointers, shared among EntStore instances
+template <class TBaseEnt>
+struct EntChunk {
+    static const long   SHIFT = 5;
+    static const long   SIZE  = 1L << SHIFT;
+    static const long   MASK  = SIZE - 1L;
+
+    TBaseEnt           *ents[SIZE];
+    RefCounter          refCnt;
+
+    EntChunk() {
+        std::fill(ents, ents + SIZE, static_cast<TBaseEnt *>(0));
+    }
+
+    /// a copy of the chunk is yet another owner of all the entities inside
+    EntChunk(const EntChunk &ref) {
+        std::copy(ref.ents, ref.ents + SIZE, ents);
+        BOOST_FOREACH(TBaseEnt *&ent, ents)
+            if (ent)
+                RefCntLib<RCO_VIRTUAL>::enter(ent);
+    }
+
+    ~EntChunk() {
+        BOOST_FOREACH(TBaseEnt *ent, ents)
+            if (ent)
+                RefCntLib<RCO_VIRTUAL>::leave(ent);
+    }
+
+    private:
+        // intentionally not implemented
+        EntChunk& operator=(const EntChunk &);
+};
+
+/**
+ * two-level storage of entities indexed by their IDs
+ *
+ * Copying of EntStore copies only the list of chunks, the chunks themselves
+ * are shared until they are written to.  A copy of the whole SymHeap followed
+ * by a single write thus costs O(N / EntChunk::SIZE + EntChunk::SIZE) instead
+ * of O(N), where N is the count of entities.
+ */
 template <class TBaseEnt>
 class EntStore {
     public:
@@ -188,9 +230,16 @@ class EntStore {
         template <typename TId> inline void releaseEnt(TId id);
         template <typename TId> inline bool isValidEnt(TId id) const;
 
+        /// true if ref holds the very same entity (or none) at the given ID
+        template <typename TId>
+        inline bool sharesEnt(const EntStore &ref, TId id) const;
+
+        /// true if ref shares all chunks (and thus all entities) with us
+        inline bool sharesAll(const EntStore &ref) const;
+
         template <typename TId> TId lastId() const {
             // we need to be careful with integral arithmetic on enums
-            const long last = -1L + ents_.size();
+            const long last = -1L + size_;
             return static_cast<TId>(last);
         }
 
@@ -211,13 +260,35 @@ class EntStore {
         // intentionally not implemented
         EntStore& operator=(const EntStore &);
 
-        std::vector<TBaseEnt *>                 ents_;
+        typedef EntChunk<TBaseEnt>              TChunk;
+
+        inline TBaseEnt* slotRO(long id) const;
+        inline TBaseEnt*& slotRW(long id);
+
+        std::vector<TChunk *>                   chunks_;
+        long                                    size_;
         EntCounter                             *entCnt_;
 };
 
 
 // /////////////////////////////////////////////////////////////////////////////
 // implementation of EntStore
+template <class TBaseEnt>
+inline TBaseEnt* EntStore<TBaseEnt>::slotRO(const long id) const
+{
+    const TChunk *chunk = chunks_[id >> TChunk::SHIFT];
+    return chunk->ents[id & TChunk::MASK];
+}
+
+template <class TBaseEnt>
+inline TBaseEnt*& EntStore<TBaseEnt>::slotRW(const long id)
+{
+    // unshare the chunk before we write into it
+    TChunk *&chunk = chunks_[id >> TChunk::SHIFT];
+    RefCntLib<RCO_NON_VIRT>::requireExclusivity(chunk);
+    return chunk->ents[id & TChunk::MASK];
+}
+
 template <class TBaseEnt>
 template <typename TId>
 TId EntStore<TBaseEnt>::assignId(TBaseEnt *ptr)
@@ -228,8 +299,9 @@ TId EntStore<TBaseEnt>::assignId(TBaseEnt *ptr)
     this->assignId(id, ptr);
     return id;
 #else
-    this->ents_.push_back(ptr);
-    return this->lastId<TId>();
+    const TId id = static_cast<TId>(size_);
+    this->assignId(id, ptr);
+    return id;
 #endif
 }
 
@@ -240,10 +312,13 @@ void EntStore<TBaseEnt>::assignId(const TId id, TBaseEnt *ptr)
     CL_BREAK_IF(ptr->refCnt.isShared());
 
     // make sure we have enough space allocated
-    if (this->lastId<TId>() < id)
-        ents_.resize(id + 1, 0);
+    if (this->lastId<TId>() < id) {
+        size_ = 1L + id;
+        while (static_cast<long>(chunks_.size()) << TChunk::SHIFT < size_)
+            chunks_.push_back(new TChunk);
+    }
 
-    TBaseEnt *&ref = ents_[id];
+    TBaseEnt *&ref = this->slotRW(id);
 
     // if this fails, you wanted to overwrite pointer to a valid entity
     CL_BREAK_IF(ref);
@@ -260,7 +335,7 @@ template <class TBaseEnt>
 template <typename TId>
 void EntStore<TBaseEnt>::releaseEnt(const TId id)
 {
-    RefCntLib<RCO_VIRTUAL>::leave(ents_[id]);
+    RefCntLib<RCO_VIRTUAL>::leave(this->slotRW(id));
 }
 
 template <class TBaseEnt>
@@ -270,20 +345,44 @@ bool EntStore<TBaseEnt>::isValidEnt(const TId id) const
     if (this->outOfRange(id))
         return false;
 
-    return !!ents_[id];
+    return !!this->slotRO(id);
+}
+
+template <class TBaseEnt>
+template <typename TId>
+bool EntStore<TBaseEnt>::sharesEnt(const EntStore &ref, const TId id) const
+{
+    const TBaseEnt *ent = (this->outOfRange(id))
+        ? 0
+        : this->slotRO(id);
+
+    const TBaseEnt *refEnt = (ref.outOfRange(id))
+        ? 0
+        : ref.slotRO(id);
+
+    return (ent == refEnt);
+}
+
+template <class TBaseEnt>
+bool EntStore<TBaseEnt>::sharesAll(const EntStore &ref) const
+{
+    return (size_ == ref.size_)
+        && (chunks_ == ref.chunks_);
 }
 
 template <class TBaseEnt>
-EntStore<TBaseEnt>::EntStore()
+EntStore<TBaseEnt>::EntStore():
+    size_(0L)
 #if SH_PREVENT_AMBIGUOUS_ENT_ID
-    : entCnt_(new EntCounter)
+    , entCnt_(new EntCounter)
 #endif
 {
 }
 
 template <class TBaseEnt>
 EntStore<TBaseEnt>::EntStore(const EntStore &ref):
-    ents_(ref.ents_)
+    chunks_(ref.chunks_),
+    size_(ref.size_)
 #if SH_PREVENT_AMBIGUOUS_ENT_ID
     , entCnt_(ref.entCnt_)
 #endif
@@ -291,9 +390,8 @@ EntStore<TBaseEnt>::EntStore(const EntStore &ref):
 #if SH_PREVENT_AMBIGUOUS_ENT_ID
     RefCntLib<RCO_NON_VIRT>::enter(entCnt_);
 #endif
-    BOOST_FOREACH(TBaseEnt *&ent, ents_)
-        if (ent)
-            RefCntLib<RCO_VIRTUAL>::enter(ent);
+    BOOST_FOREACH(TChunk *&chunk, chunks_)
+        RefCntLib<RCO_NON_VIRT>::enter(chunk);
 }
 
 template <class TBaseEnt>
@@ -302,9 +400,8 @@ EntStore<TBaseEnt>::~EntStore()
 #if SH_PREVENT_AMBIGUOUS_ENT_ID
     RefCntLib<RCO_NON_VIRT>::leave(entCnt_);
 #endif
-    BOOST_FOREACH(TBaseEnt *ent, ents_)
-        if (ent)
-            RefCntLib<RCO_VIRTUAL>::leave(ent);
+    BOOST_FOREACH(TChunk *&chunk, chunks_)
+        RefCntLib<RCO_NON_VIRT>::leave(chunk);
 }
 
 template <class TBaseEnt>
@@ -315,7 +412,7 @@ inline const TBaseEnt* EntStore<TBaseEnt>::getEntRO(const TId id)
     CL_BREAK_IF(this->outOfRange(id));
 
     // if this fails, the ID is no longer valid
-    const TBaseEnt *ptr = ents_[id];
+    const TBaseEnt *ptr = this->slotRO(id);
     CL_BREAK_IF(!ptr);
     return ptr;
 }
@@ -327,7 +424,7 @@ inline TBaseEnt* EntStore<TBaseEnt>::getEntRW(const TId id)
 #ifndef NDEBUG
     this->getEntRO(id);
 #endif
-    TBaseEnt *&entRW = ents_[id];
+    TBaseEnt *&entRW = this->slotRW(id);
     RefCntLib<RCO_VIRTUAL>::requireExclusivity(entRW);
     return entRW;
 }
@@ -67,13 +67,141 @@ struct ExecStackItem {
 
 typedef std::deque<ExecStackItem> TExecStack;
 
+// /////////////////////////////////////////////////////////////////////////////
+// MemBudget
+/// graceful degradation of the analysis on approaching GlConf::data.memBudget
+class MemBudget {
+    public:
+        MemBudget(SymCallCache &callCache):
+            callCache_(callCache),
+            limit_(static_cast<ssize_t>(GlConf::data.memBudget) << /* MiB */ 20),
+            level_(MD_NONE),
+            cntSkip_(0)
+        {
+        }
+
+        /// check the amount of allocated memory, degrade the analysis if needed
+        void check(const struct cl_loc *lw);
+
+        /// true if states of basic blocks are pruned regardless of thresholds
+        bool forcePruning() const {
+            return (MD_FORCE_PRUNING <= level_);
+        }
+
+    private:
+        enum EDegradation {
+            MD_NONE = 0,
+            MD_EVICT_CALL_CACHE,
+            MD_FORCE_PRUNING,
+            MD_DROP_PLOTS
+        };
+
+        SymCallCache                   &callCache_;
+        const ssize_t                   limit_;
+        EDegradation                    level_;
+        int                             cntSkip_;
+
+        void dropPlots();
+};
+
+void MemBudget::dropPlots()
+{
+    // ignore all ___sl_plot*() calls from now on
+    GlConf::data.skipUserPlots = true;
+
+    // drop the trace graphs scheduled for plotting at the end of the run
+    if (Trace::Globals::alive())
+        Trace::Globals::cleanup();
+
+    // drop the fixed-point store unless it is needed to detect containers
+    FixedPoint::StateByInsn *&fixedPoint = GlConf::data.fixedPoint;
+    if (fixedPoint && !GlConf::data.detectContainers) {
+        delete fixedPoint;
+        fixedPoint = 0;
+    }
+}
+
+void MemBudget::check(const struct cl_loc *lw)
+{
+    if (!limit_)
+        // no budget given
+        return;
+
+    if (0 < cntSkip_) {
+        // give the last step of degradation some time to take effect
+        --cntSkip_;
+        return;
+    }
+
+    // glibc does not see the fragmentation and freed memory not yet returned
+    // to the system, which a cgroup limit counts as RSS, so take the maximum
+    ssize_t usage = 0;
+    ssize_t rss;
+    if (rawRssUsage(&rss))
+        usage = rss;
+
+    ssize_t heap;
+    if (rawMemUsage(&heap) && usage < heap)
+        usage = heap;
+
+    if (usage < limit_ / 10 * 9)
+        // we are not approaching the budget (yet)
+        return;
+
+    cntSkip_ = (SE_MEM_BUDGET_DELAY);
+
+    // the call cache is cheap to rebuild, so we evict it on each step
+    const int cntCtxs = callCache_.evictColdEntries();
+
+    const EDegradation levelOrig = level_;
+    if (level_ < MD_DROP_PLOTS)
+        level_ = static_cast<EDegradation>(level_ + 1);
+
+    if (MD_DROP_PLOTS == level_ && levelOrig != level_)
+        this->dropPlots();
+
+    // return the freed memory to the system, we may be running in a cgroup
+    trimMemUsage();
+
+    const ssize_t mib = usage >> /* MiB */ 20;
+    if (levelOrig == level_) {
+        CL_DEBUG_MSG(lw, "memory budget approached (" << mib << " MiB), "
+                << cntCtxs << " call contexts evicted");
+        return;
+    }
+
+    CL_WARN_MSG(lw, "memory budget approached (" << mib << " of "
+            << GlConf::data.memBudget << " MiB in use)");
+
+    switch (level_) {
+        case MD_NONE:
+            CL_BREAK_IF("MemBudget::check() failed to degrade the analysis");
+            break;
+
+        case MD_EVICT_CALL_CACHE:
+            CL_NOTE_MSG(lw, "evicting call cache, " << cntCtxs
+                    << " call contexts dropped");
+            break;
+
+        case MD_FORCE_PRUNING:
+            CL_NOTE_MSG(lw, "pruning states of basic blocks"
+                    " regardless of thresholds");
+            break;
+
+        case MD_DROP_PLOTS:
+            CL_NOTE_MSG(lw, "dropping scheduled plots and trace graphs");
+            break;
+    }
+}
+
 // /////////////////////////////////////////////////////////////////////////////
 // SymExec
 class SymExec: public IStatsProvider {
     public:
         SymExec(const CodeStorage::Storage &stor):
             stor_(stor),
-            callCache_(stor)
+            callCache_(stor),
+            budget_(callCache_)
         {
         }
 
@@ -98,6 +226,7 @@ class SymExec: public IStatsProvider {
     private:
         const CodeStorage::Storage              &stor_;
         SymCallCache                            callCache_;
+        MemBudget                               budget_;
         TExecStack                              execStack_;
 };
 
@@ -109,11 +238,13 @@ class SymExecEngine: public IStatsProvider {
                 SymState                &results,
                 const SymHeap           &entry,
                 const IStatsProvider    &stats,
-                SymBackTrace            &bt):
+                SymBackTrace            &bt,
+                MemBudget               &budget):
             stor_(entry.stor()),
             bt_(bt),
             dst_(results),
             stats_(stats),
+            budget_(budget),
             sched_(stateMap_),
             block_(0),
             insnIdx_(0),
@@ -141,6 +272,7 @@ class SymExecEngine: public IStatsProvider {
         SymBackTrace                    &bt_;
         SymState                        &dst_;
         const IStatsProvider            &stats_;
+        MemBudget                       &budget_;
         std::string                     fncName_;
         TObjType                        fncReturnType_;
 
@@ -246,9 +378,11 @@ void SymExecEngine::execReturn()
     const SymHeap &origin = localState_[heapIdx_];
     SymHeap sh(origin);
 
-    Trace::Node *trOrig = origin.traceNode();
-    Trace::Node *trRet = new Trace::InsnNode(trOrig, insn, /* bin */ false);
-    sh.traceUpdate(trRet);
+    if (!GlConf::data.noTrace) {
+        Trace::Node *trOrig = origin.traceNode();
+        Trace::Node *trRet = new Trace::InsnNode(trOrig, insn, /* bin */ false);
+        sh.traceUpdate(trRet);
+    }
 
     if (CL_TYPE_VOID != fncReturnType_->code) {
         SymProc proc(sh, &bt_);
@@ -352,8 +486,9 @@ void SymExecEngine::updateStateInBranch(
 
     // append trace node for a non-deterministic condition
     Trace::waiveCloneOperation(shOrig);
-    shOrig.traceUpdate(new Trace::CondNode(shOrig.traceNode(),
-                &insnCmp, &insnCnd, /* det */ false, branch));
+    if (!GlConf::data.noTrace)
+        shOrig.traceUpdate(new Trace::CondNode(shOrig.traceNode(),
+                    &insnCmp, &insnCnd, /* det */ false, branch));
 
 #if DEBUG_SE_NONDET_COND < 2
     const bool hasAbstract = isAnyAbstractOf(shOrig, v1, v2);
@@ -422,8 +557,9 @@ skip_tracking:
     proc.killInsn(insnCmp);
 
     SymHeap sh1(sh);
-    sh1.traceUpdate(new Trace::CondNode(sh.traceNode(),
-                &insnCmp, &insnCnd, /* det */ false, /* branch */ true));
+    if (!GlConf::data.noTrace)
+        sh1.traceUpdate(new Trace::CondNode(sh.traceNode(),
+                    &insnCmp, &insnCnd, /* det */ false, /* branch */ true));
 
     CL_DEBUG_MSG(lw_, "-T- CL_INSN_COND updates TRUE branch");
     SymProc proc1(sh1, proc.bt());
@@ -432,8 +568,9 @@ skip_tracking:
     this->updateState(sh1, insnCnd.targets[/* then label */ 0]);
 
     SymHeap sh2(sh);
-    sh2.traceUpdate(new Trace::CondNode(sh.traceNode(),
-                &insnCmp, &insnCnd, /* det */ false, /* branch */ false));
+    if (!GlConf::data.noTrace)
+        sh2.traceUpdate(new Trace::CondNode(sh.traceNode(),
+                    &insnCmp, &insnCnd, /* det */ false, /* branch */ false));
 
     CL_DEBUG_MSG(lw_, "-F- CL_INSN_COND updates FALSE branch");
     SymProc proc2(sh2, proc.bt());
@@ -480,8 +617,9 @@ void SymExecEngine::execCondInsn()
     // check whether we know where to go
     switch (val) {
         case VAL_TRUE:
-            sh.traceUpdate(new Trace::CondNode(sh.traceNode(),
-                        insnCmp, insnCnd, /* det */ true, /* branch */ true));
+            if (!GlConf::data.noTrace)
+                sh.traceUpdate(new Trace::CondNode(sh.traceNode(), insnCmp,
+                            insnCnd, /* det */ true, /* branch */ true));
 
             CL_DEBUG_MSG(lw_, ".T. CL_INSN_COND got VAL_TRUE");
             proc.killInsn(*insnCmp);
@@ -490,8 +628,9 @@ void SymExecEngine::execCondInsn()
             return;
 
         case VAL_FALSE:
-            sh.traceUpdate(new Trace::CondNode(sh.traceNode(),
-                        insnCmp, insnCnd, /* det */ true, /* branch */ false));
+            if (!GlConf::data.noTrace)
+                sh.traceUpdate(new Trace::CondNode(sh.traceNode(), insnCmp,
+                            insnCnd, /* det */ true, /* branch */ false));
 
             CL_DEBUG_MSG(lw_, ".F. CL_INSN_COND got VAL_FALSE");
             proc.killInsn(*insnCmp);
@@ -797,6 +936,9 @@ bool /* complete */ SymExecEngine::run()
         insnIdx_ = 0;
         heapIdx_ = 0;
 
+        // degrade the analysis if we are running out of memory
+        budget_.check(lw_);
+
         // process the basic block till the first function call
         if (!this->execBlock())
             // function call reached, suspend the execution for now
@@ -971,6 +1113,7 @@ void SymExecEngine::processPendingSignals()
     CL_WARN_MSG(lw_, "caught signal " << signum);
     stats_.printStats();
     printMemUsage("SymExec::printStats");
+    printEntPoolStats();
 
     switch (signum) {
         case SIGUSR1:
@@ -984,15 +1127,22 @@ void SymExecEngine::processPendingSignals()
 
 void SymExecEngine::pruneOrigin()
 {
-#if SE_STATE_PRUNING_MODE
     if (block_->isLoopEntry())
-#endif
         // never prune loop entry, it would break the fixed-point computation
         return;
 
+#if !SE_STATE_PRUNING_MODE
+    if (!budget_.forcePruning())
+        return;
+#endif
+
     SymStateMarked &origin = stateMap_[block_];
     const unsigned size = origin.size();
 
+    if (budget_.forcePruning())
+        // running out of the memory budget, prune regardless of thresholds
+        goto thr_reached;
+
 #if SE_STATE_PRUNING_MISS_THR
     if (!stateMap_.anyReuseHappened(block_)
             && (SE_STATE_PRUNING_MISS_THR) <= size)
@@ -1016,9 +1166,7 @@ void SymExecEngine::pruneOrigin()
         return;
 #endif
 
-#if SE_STATE_PRUNING_MISS_THR || SE_STATE_PRUNING_TOTAL_THR
 thr_reached:
-#endif
     if (0x100 < size)
         printMemUsage("SymExecEngine::execInsn");
 
@@ -1138,7 +1286,8 @@ void SymExec::enterCall(SymCallCtx *ctx, SymState &results)
             ctx->rawResults(),
             ctx->entry(),
             /* IStatsProvider */ *this,
-            callCache_.bt());
+            callCache_.bt(),
+            budget_);
 
     // initialize a stack item
     ExecStackItem item;
@@ -1235,6 +1384,8 @@ void SymExec::printStats() const
 {
     // TODO: print SymCallCache stats here as soon as we have implemented some
 
+    printJoinStats();
+
     BOOST_FOREACH(const ExecStackItem &item, execStack_) {
         const IStatsProvider *provider = item.eng;
         provider->printStats();
@@ -23,8 +23,11 @@
 
 #include <cl/cl_msg.hh>
 #include <cl/clutil.hh>
+#include <cl/memdebug.hh>
 #include <cl/storage.hh>
 
+#include "ent_pool.hh"
+#include "glconf.hh"
 #include "intarena.hh"
 #include "syments.hh"
 #include "sympred.hh"
@@ -344,6 +347,17 @@ class AbstractHeapEntity {
         // NVI to catch missing/incorrect overrides of doClone()
         AbstractHeapEntity* clone() const;
 
+#if SH_ENT_POOL
+        static void* operator new(size_t size) {
+            return EntPoolSet::alloc(size);
+        }
+
+        // the size of the dynamic type is given thanks to virtual destructor
+        static void operator delete(void *ptr, size_t size) {
+            EntPoolSet::release(ptr, size);
+        }
+#endif
+
     private:
         // see Herb Sutter: C++ Coding Standards (rules #39 and #54) for details
         virtual AbstractHeapEntity* doClone() const = 0;
@@ -628,11 +642,18 @@ struct SymHeapCore::Private {
     CustomValueMapper              *cValueMap;
     CoincidenceDb                  *coinDb;
     NeqDb                          *neqDb;
+#if SE_DISCOVER_NEAR_DIRTY
+    TObjSet                         dirtyObjs;
+    bool                            allDirty;
+#endif
 
     inline TFldId assignId(BlockEntity *);
     inline TValId assignId(BaseValue *);
     inline TObjId assignId(Region *);
 
+    inline void markDirty(TObjId);
+    void markTargetDirty(TValId);
+
     TValId valCreate(EValueTarget code, EValueOrigin origin);
     TValId valDup(TValId);
     bool valsEqual(TValId, TValId);
@@ -733,6 +754,35 @@ inline TObjId SymHeapCore::Private::assignId(Region *regData)
     return this->ents.assignId<TObjId>(regData);
 }
 
+inline void SymHeapCore::Private::markDirty(const TObjId obj)
+{
+#if SE_DISCOVER_NEAR_DIRTY
+    if (!this->allDirty)
+        this->dirtyObjs.insert(obj);
+#else
+    (void) obj;
+#endif
+}
+
+void SymHeapCore::Private::markTargetDirty(const TValId val)
+{
+#if SE_DISCOVER_NEAR_DIRTY
+    if (this->allDirty || val < VAL_NULL)
+        return;
+
+    const BaseValue *valData;
+    this->ents.getEntRO(&valData, val);
+    if (!isAnyDataArea(valData->code))
+        return;
+
+    const BaseAddress *rootData;
+    this->ents.getEntRO(&rootData, valData->valRoot);
+    this->dirtyObjs.insert(rootData->obj);
+#else
+    (void) val;
+#endif
+}
+
 bool /* wasPtr */ SymHeapCore::Private::releaseValueOf(TFldId fld, TValId val)
 {
     if (val <= 0)
@@ -768,6 +818,7 @@ bool /* wasPtr */ SymHeapCore::Private::releaseValueOf(TFldId fld, TValId val)
     // jump to region
     Region *regData;
     this->ents.getEntRW(&regData, rootData->obj);
+    this->markDirty(rootData->obj);
 
     if (1 != regData->usedByGl.erase(fld))
         CL_BREAK_IF("SymHeapCore::Private::releaseValueOf(): offset detected");
@@ -798,6 +849,7 @@ void SymHeapCore::Private::registerValueOf(TFldId fld, TValId val)
     Region *regData;
     this->ents.getEntRW(&regData, rootData->obj);
     regData->usedByGl.insert(fld);
+    this->markDirty(rootData->obj);
 }
 
 // runs only in debug build
@@ -1240,6 +1292,7 @@ void SymHeapCore::Private::setValueOf(
     const TObjId obj = fldData->obj;
     Region *rootData;
     this->ents.getEntRW(&rootData, obj);
+    this->markDirty(obj);
 
     // (re)insert self into the arena if not there
     TArena &arena = rootData->arena;
@@ -1482,11 +1535,26 @@ SymHeapCore::Private::Private(Trace::Node *trace):
     cValueMap   (new CustomValueMapper),
     coinDb      (new CoincidenceDb),
     neqDb       (new NeqDb)
+#if SE_DISCOVER_NEAR_DIRTY
+    , allDirty  (true)
+#endif
+{
+    if (GlConf::data.noTrace)
+        // the trace graph is disabled, this also releases the given node
+        traceHandle.reset(Trace::NullNode::instance());
+}
+
+/// a heap being cloned shares the trace node if the trace graph is disabled
+inline Trace::Node* traceOfClone(Trace::Node *ref)
 {
+    if (GlConf::data.noTrace)
+        return ref;
+
+    return new Trace::CloneNode(ref);
 }
 
 SymHeapCore::Private::Private(const SymHeapCore::Private &ref):
-    traceHandle (new Trace::CloneNode(ref.traceHandle.node())),
+    traceHandle (traceOfClone(ref.traceHandle.node())),
     ents        (ref.ents),
     liveObjs    (ref.liveObjs),
     anonStackMap(ref.anonStackMap),
@@ -1494,6 +1562,10 @@ SymHeapCore::Private::Private(const SymHeapCore::Private &ref):
     cValueMap   (ref.cValueMap),
     coinDb      (ref.coinDb),
     neqDb       (ref.neqDb)
+#if SE_DISCOVER_NEAR_DIRTY
+    , dirtyObjs (ref.dirtyObjs)
+    , allDirty  (ref.allDirty)
+#endif
 {
     RefCntLib<RCO_NON_VIRT>::enter(this->liveObjs);
     RefCntLib<RCO_NON_VIRT>::enter(this->anonStackMap);
@@ -1731,6 +1803,7 @@ TObjId SymHeapCore::objClone(TObjId obj)
     const TObjId dup = d->assignId(new Region(objDataSrc->code));
     Region *objDataDst;
     d->ents.getEntRW(&objDataDst, dup);
+    d->markDirty(dup);
 
     // duplicate root metadata
     objDataDst->cVar                = objDataSrc->cVar;
@@ -1877,11 +1950,15 @@ bool SymHeapCore::findCoveringUniBlocks(
     return false;
 }
 
+/// count of live symbolic heaps, sampled by printMemUsage()
+static MemCounter cntSymHeaps("sym_heaps");
+
 SymHeapCore::SymHeapCore(TStorRef stor, Trace::Node *trace):
     stor_(stor),
     d(new Private(trace))
 {
     CL_BREAK_IF(!&stor_);
+    cntSymHeaps.inc();
 
     // allocate the VAL_NULL base address
     const TValId valNull = d->assignId(new BaseAddress(OBJ_NULL, TS_REGION));
@@ -1911,11 +1988,13 @@ SymHeapCore::SymHeapCore(const SymHeapCore &ref):
     d(new Private(*ref.d))
 {
     CL_BREAK_IF(!&stor_);
+    cntSymHeaps.inc();
 }
 
 SymHeapCore::~SymHeapCore()
 {
     delete d;
+    cntSymHeaps.dec();
 }
 
 // cppcheck-suppress operatorEqToSelf
@@ -1977,6 +2056,7 @@ TFldId SymHeapCore::Private::writeUniformBlock(
     // jump to region
     Region *regData;
     this->ents.getEntRW(&regData, obj);
+    this->markDirty(obj);
 
     // check up to now arena consistency
     CL_BREAK_IF(!this->chkArenaConsistency(regData));
@@ -2863,6 +2943,8 @@ void SymHeapCore::valReplace(TValId val, TValId replaceBy)
 void SymHeapCore::addNeq(TValId v1, TValId v2)
 {
     RefCntLib<RCO_NON_VIRT>::requireExclusivity(d->neqDb);
+    d->markTargetDirty(v1);
+    d->markTargetDirty(v2);
 
     const EValueTarget code1 = this->valTarget(v1);
     const EValueTarget code2 = this->valTarget(v2);
@@ -2881,6 +2963,8 @@ void SymHeapCore::delNeq(TValId v1, TValId v2)
 
     RefCntLib<RCO_NON_VIRT>::requireExclusivity(d->neqDb);
     d->neqDb->del(v1, v2);
+    d->markTargetDirty(v1);
+    d->markTargetDirty(v2);
 }
 
 void SymHeapCore::gatherRelatedValues(TValList &dst, TValId val) const
@@ -2991,6 +3075,57 @@ bool SymHeapCore::matchPreds(
     return true;
 }
 
+void SymHeapCore::cntPreds(unsigned *pCntNeqs, unsigned *pCntCoins) const
+{
+    *pCntNeqs  = d->neqDb->size();
+    *pCntCoins = d->coinDb->size();
+}
+
+bool SymHeapCore::objShared(TObjId obj, const SymHeapCore &ref) const
+{
+    EntStore<AbstractHeapEntity> &ents = d->ents;
+    if (!ents.sharesEnt(ref.d->ents, obj))
+        return false;
+
+    if (!ents.isValidEnt(obj))
+        // neither of the heaps knows the object
+        return true;
+
+    // the Region entity is shared, check its uniform blocks and their values
+    const Region *regData;
+    ents.getEntRO(&regData, obj);
+    BOOST_FOREACH(TLiveObjs::const_reference item, regData->liveFields) {
+        if (BK_UNIFORM != item.second)
+            continue;
+
+        const TFldId fld = item.first;
+        if (!ents.sharesEnt(ref.d->ents, fld))
+            return false;
+
+        const BlockEntity *blData;
+        ents.getEntRO(&blData, fld);
+        const TValId val = blData->value;
+        if (0 < val && !ents.sharesEnt(ref.d->ents, val))
+            return false;
+    }
+
+    return true;
+}
+
+bool SymHeapCore::sharesAll(const SymHeapCore &ref) const
+{
+    const Private &d1 = *d;
+    const Private &d2 = *ref.d;
+
+    return (d1.liveObjs     == d2.liveObjs)
+        && (d1.anonStackMap == d2.anonStackMap)
+        && (d1.cVarMap      == d2.cVarMap)
+        && (d1.cValueMap    == d2.cValueMap)
+        && (d1.coinDb       == d2.coinDb)
+        && (d1.neqDb        == d2.neqDb)
+        && d1.ents.sharesAll(d2.ents);
+}
+
 TObjId SymHeapCore::objByField(TFldId fld) const
 {
     if (fld < 0)
@@ -3466,6 +3601,7 @@ void SymHeapCore::objSetEstimatedType(TObjId obj, TObjType clt)
 {
     Region *rootData;
     d->ents.getEntRW(&rootData, obj);
+    d->markDirty(obj);
 
     if (OBJ_RETURN == obj) {
         // destroy any stale OBJ_RETURN object
@@ -3495,6 +3631,7 @@ void SymHeapCore::objInvalidate(TObjId obj)
     Region *rootData;
     d->ents.getEntRW(&rootData, obj);
     rootData->isValid = false;
+    d->markDirty(obj);
 
     if (OBJ_RETURN == obj)
         rootData->lastKnownClt = 0;
@@ -3619,6 +3756,34 @@ void SymHeapCore::objSetProtoLevel(TObjId obj, TProtoLevel level)
     Region *regData;
     d->ents.getEntRW(&regData, obj);
     regData->protoLevel = level;
+    d->markDirty(obj);
+}
+
+bool SymHeapCore::gatherDirtyObjects(TObjSet &dst) const
+{
+#if SE_DISCOVER_NEAR_DIRTY
+    if (d->allDirty)
+        return false;
+
+    dst.insert(d->dirtyObjs.begin(), d->dirtyObjs.end());
+    return true;
+#else
+    (void) dst;
+    return false;
+#endif
+}
+
+void SymHeapCore::resetDirtyObjects()
+{
+#if SE_DISCOVER_NEAR_DIRTY
+    d->dirtyObjs.clear();
+    d->allDirty = false;
+#endif
+}
+
+void SymHeapCore::objMarkDirty(TObjId obj)
+{
+    d->markDirty(obj);
 }
 
 bool SymHeapCore::chkNeq(TValId v1, TValId v2) const
@@ -3713,6 +3878,26 @@ TObjId SymHeap::objClone(TObjId obj)
     return dup;
 }
 
+bool SymHeap::objShared(TObjId obj, const SymHeapCore &baseRef) const
+{
+    if (!SymHeapCore::objShared(obj, baseRef))
+        return false;
+
+    const SymHeap &ref = DCAST<const SymHeap &>(baseRef);
+    return (d == ref.d)
+        || d->absRoots.sharesEnt(ref.d->absRoots, obj);
+}
+
+bool SymHeap::sharesAll(const SymHeapCore &baseRef) const
+{
+    if (!SymHeapCore::sharesAll(baseRef))
+        return false;
+
+    const SymHeap &ref = DCAST<const SymHeap &>(baseRef);
+    return (d == ref.d)
+        || d->absRoots.sharesAll(ref.d->absRoots);
+}
+
 EObjKind SymHeap::objKind(TObjId obj) const
 {
     if (!d->absRoots.isValidEnt(obj))
@@ -3740,6 +3925,7 @@ void SymHeap::objSetAbstract(
     CL_BREAK_IF(OK_SEE_THROUGH == kind && off.prev != off.next);
 
     RefCntLib<RCO_NON_VIRT>::requireExclusivity(d);
+    this->objMarkDirty(obj);
 
     if (d->absRoots.isValidEnt(obj)) {
         // the object already exists, just update its properties
@@ -3761,6 +3947,7 @@ void SymHeap::objSetConcrete(TObjId obj)
 {
     CL_DEBUG("SymHeap::objSetConcrete() is taking place...");
     RefCntLib<RCO_NON_VIRT>::requireExclusivity(d);
+    this->objMarkDirty(obj);
 
     // unregister an abstract object
     d->absRoots.releaseEnt(obj);
@@ -3802,6 +3989,7 @@ TMinLen SymHeap::segMinLength(TObjId seg) const
 void SymHeap::segSetMinLength(TObjId seg, TMinLen len)
 {
     RefCntLib<RCO_NON_VIRT>::requireExclusivity(d);
+    this->objMarkDirty(seg);
 
     AbstractObject *aData = d->absRoots.getEntRW(seg);
 
@@ -438,6 +438,16 @@ class SymHeapCore {
                 bool                         nonZeroOnly = false)
             const;
 
+        /// count Neq predicates and coincidences, used to skip matchPreds()
+        void cntPreds(unsigned *pCntNeqs, unsigned *pCntCoins) const;
+
+    public:
+        /// true if the object is represented by the same entities in ref
+        virtual bool objShared(TObjId, const SymHeapCore &ref) const;
+
+        /// true if ref shares all its entities and predicates with this heap
+        virtual bool sharesAll(const SymHeapCore &ref) const;
+
     public:
         /// translate the given address by the given offset
         TValId valByOffset(TValId, TOffset offset);
@@ -569,6 +579,21 @@ class SymHeapCore {
         /// set prototype level of the given boject (0 means not a prototype)
         void objSetProtoLevel(TObjId obj, TProtoLevel level);
 
+    public:
+        /**
+         * gather objects written since the last call of resetDirtyObjects(),
+         * return false if all objects need to be treated as dirty
+         * @note objects are tracked only if SE_DISCOVER_NEAR_DIRTY is enabled
+         */
+        bool gatherDirtyObjects(TObjSet &dst) const;
+
+        /// treat all objects as clean from now on (used after abstraction)
+        void resetDirtyObjects();
+
+    protected:
+        /// mark the given object as written since the last resetDirtyObjects()
+        void objMarkDirty(TObjId);
+
     protected:
         /// return a @b data pointer inside the given object at the given offset
         TFldId ptrLookup(TObjId obj, TOffset off);
@@ -866,6 +891,8 @@ class SymHeap: public SymHeapCore {
         // just overrides (inherits the dox)
         virtual void objInvalidate(TObjId);
         virtual TObjId objClone(TObjId);
+        virtual bool objShared(TObjId, const SymHeapCore &ref) const;
+        virtual bool sharesAll(const SymHeapCore &ref) const;
 
     private:
         struct Private;
@@ -875,6 +902,9 @@ class SymHeap: public SymHeapCore {
 /// enable/disable built-in self-checks (takes effect only in debug build)
 void enableProtectedMode(bool enable);
 
+/// print live/free slots of the slab pools (heap entities and trace nodes)
+void printEntPoolStats();
+
 /// temporarily disable protected mode of SymHeap in a debug build
 class ProtectionIntrusion {
     public:
@@ -36,6 +36,8 @@
 #include "worklist.hh"
 #include "util.hh"
 
+#include <algorithm>
+
 #include <boost/foreach.hpp>
 #include <boost/tuple/tuple.hpp>
 
@@ -2531,6 +2533,12 @@ void initTrace(SymJoinCtx &ctx)
 {
     Trace::Node *const tr1 = ctx.sh1.traceNode();
     Trace::Node *const tr2 = ctx.sh2.traceNode();
+    if (GlConf::data.noTrace) {
+        // the trace graph is disabled, all heaps share a single node
+        ctx.dst.traceUpdate(tr1);
+        return;
+    }
+
     if (tr1 == tr2) {
         // detected isomorphism of identical heaps, skip the trace node creation
         CL_BREAK_IF(JS_USE_ANY != ctx.status);
@@ -2615,6 +2623,120 @@ fail:
     return false;
 }
 
+JoinSignature::EKind joinSigKindOf(IR::TInt *pNum, const SymHeap &sh, TValId val)
+{
+    *pNum = static_cast<IR::TInt>(val);
+
+    // special values have to match exactly (see ObjJoinVisitor)
+    if (val < VAL_NULL || VAL_TRUE == val)
+        return JoinSignature::JSK_SPECIAL;
+
+    const IR::TInt limit = GlConf::data.intArithmeticLimit;
+    if (!limit || VAL_NULL == val || VT_CUSTOM != sh.valTarget(val))
+        return JoinSignature::JSK_OTHER;
+
+    // two distinct integers within the limit are never joined by
+    // joinCustomValues(), no matter what the rest of the heaps looks like
+    const CustomValue &cVal = sh.valUnwrapCustom(val);
+    if (CV_INT_RANGE != cVal.code())
+        return JoinSignature::JSK_OTHER;
+
+    const IR::Range &rng = cVal.rng();
+    if (!isSingular(rng) || limit < std::abs(rng.lo))
+        return JoinSignature::JSK_OTHER;
+
+    *pNum = rng.lo;
+    return JoinSignature::JSK_INT;
+}
+
+bool joinSigItemLess(const JoinSignature::Item &a, const JoinSignature::Item &b)
+{
+    if (a.cv != b.cv)
+        return a.cv < b.cv;
+
+    RETURN_IF_COMPARED(a, b, off);
+    return a.clt < b.clt;
+}
+
+void joinSignature(JoinSignature *pDst, const SymHeap &sh)
+{
+    SymHeap &shWritable = const_cast<SymHeap &>(sh);
+    pDst->glVars.clear();
+    pDst->items.clear();
+
+    // the set of gl variables needs to match exactly in traverseProgramVars()
+    TCVarSet cVars;
+    gatherProgramVars(cVars, sh);
+    BOOST_FOREACH(const CVar &cv, cVars) {
+        if (!cv.inst)
+            pDst->glVars.push_back(cv);
+
+        const TObjId reg = shWritable.regionByVar(cv, /* createIfNeeded */ false);
+        CL_BREAK_IF(OBJ_INVALID == reg);
+
+        // summarize the live fields as joinFields() will see them
+        FldList fields;
+        sh.gatherLiveFields(fields, reg);
+        BOOST_FOREACH(const FldHandle &fld, fields) {
+            JoinSignature::Item item;
+            item.cv     = cv;
+            item.off    = fld.offset();
+            item.clt    = fld.type();
+            item.kind   = joinSigKindOf(&item.num, sh, fld.value());
+            pDst->items.push_back(item);
+        }
+    }
+
+    std::sort(pDst->items.begin(), pDst->items.end(), joinSigItemLess);
+}
+
+bool joinSigItemsCompatible(
+        const JoinSignature::Item &a,
+        const JoinSignature::Item &b)
+{
+    if (JoinSignature::JSK_SPECIAL == a.kind
+            || JoinSignature::JSK_SPECIAL == b.kind)
+        // special values are joinable only with themselves
+        return (a.kind == b.kind) && (a.num == b.num);
+
+    if (JoinSignature::JSK_INT == a.kind && JoinSignature::JSK_INT == b.kind)
+        // joinCustomValues() refuses to join distinct integers within limit
+        return (a.num == b.num);
+
+    return true;
+}
+
+bool joinSigCompatible(const JoinSignature &sig1, const JoinSignature &sig2)
+{
+    if (sig1.glVars != sig2.glVars)
+        // asymmetric join of gl variables is not allowed
+        return false;
+
+    // go through the fields that are live in both heaps
+    JoinSignature::TItems::const_iterator it1 = sig1.items.begin();
+    JoinSignature::TItems::const_iterator it2 = sig2.items.begin();
+    while (it1 != sig1.items.end() && it2 != sig2.items.end()) {
+        if (joinSigItemLess(*it1, *it2)) {
+            ++it1;
+            continue;
+        }
+
+        if (joinSigItemLess(*it2, *it1)) {
+            ++it2;
+            continue;
+        }
+
+        if (!joinSigItemsCompatible(*it1, *it2))
+            return false;
+
+        ++it1;
+        ++it2;
+    }
+
+    // no conflict found, we need to call joinSymHeaps() to know more
+    return true;
+}
+
 // FIXME: this works only for nullified blocks anyway
 void killUniBlocksUnderBindingPtrs(
         SymHeap                &sh,
@@ -50,6 +50,40 @@ bool joinSymHeaps(
         SymHeap                  sh2,
         bool                     allowThreeWay = true);
 
+/**
+ * cheap summary of a heap that any successful joinSymHeaps() needs to preserve
+ *
+ * Two heaps whose signatures are not joinSigCompatible() are guaranteed not to
+ * be joinable, so the caller can skip the (expensive) call of joinSymHeaps().
+ */
+struct JoinSignature {
+    enum EKind {
+        JSK_SPECIAL,        ///< special value that has to match exactly
+        JSK_INT,            ///< integral value preserved by intArithmeticLimit
+        JSK_OTHER           ///< anything else (not constrained by the signature)
+    };
+
+    struct Item {
+        CVar                cv;
+        TOffset             off;
+        TObjType            clt;
+        EKind               kind;
+        IR::TInt            num;
+    };
+
+    typedef std::vector<CVar>       TGlVars;
+    typedef std::vector<Item>       TItems;
+
+    TGlVars                 glVars;         ///< sorted list of live gl vars
+    TItems                  items;          ///< sorted by (cv, off, clt)
+};
+
+/// compute JoinSignature of the given heap
+void joinSignature(JoinSignature *pDst, const SymHeap &sh);
+
+/// false if joinSymHeaps() is guaranteed to fail on the corresponding heaps
+bool joinSigCompatible(const JoinSignature &sig1, const JoinSignature &sig2);
+
 /// enable/disable debugging of symjoin
 void debugSymJoin(bool enable);
 
@@ -39,6 +39,10 @@ class SymPairSet {
             return cont_.empty();
         }
 
+        unsigned size() const {
+            return cont_.size();
+        }
+
         bool chk(TKey k1, TKey k2) const {
             sortValues(k1, k2);
             const TItem item(k1, k2);
@@ -80,6 +84,9 @@ class SymPairMap {
         /// return STL-like iterator to go through the container
         const_iterator end()   const { return db_.end();   }
 
+        /// return count of items in the container
+        unsigned size()        const { return db_.size();  }
+
     public:
         void add(TKey k1, TKey k2, TVal val) {
             sortValues(k1, k2);
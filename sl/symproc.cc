@@ -64,8 +64,11 @@
 void SymProc::printBackTrace(EMsgLevel level, bool forcePtrace)
 {
     // update trace graph
-    Trace::MsgNode *trMsg = new Trace::MsgNode(sh_.traceNode(), level, lw_);
-    sh_.traceUpdate(trMsg);
+    Trace::Node *trMsg = sh_.traceNode();
+    if (!GlConf::data.noTrace) {
+        trMsg = new Trace::MsgNode(trMsg, level, lw_);
+        sh_.traceUpdate(trMsg);
+    }
     CL_BREAK_IF(!chkTraceGraphConsistency(trMsg));
 
     // print the backtrace (or full trace if error recovery is disabled)
@@ -1799,7 +1802,8 @@ bool dlSegMergeAddressesIfNeeded(
         dlSegMergeAddressesOfEmpty(dst, proc, v1, v2);
 
     dlSegReplaceByConcrete(sh, obj1 /* = obj2 */);
-    sh.traceUpdate(new Trace::SpliceOutNode(sh.traceNode(), /* len */ 1));
+    if (!GlConf::data.noTrace)
+        sh.traceUpdate(new Trace::SpliceOutNode(sh.traceNode(), /* len */ 1));
     dst.insert(sh);
     return true;
 }
@@ -1902,8 +1906,10 @@ bool valMerge(SymState &dst, SymProc &proc, TValId v1, TValId v2)
 
 fail:
     CL_DEBUG_MSG(loc, "failed to splice-out list segment!");
-    trNode = new Trace::SpliceOutNode(trNode, /* failed */ 0);
-    sh.traceUpdate(trNode);
+    if (!GlConf::data.noTrace) {
+        trNode = new Trace::SpliceOutNode(trNode, /* failed */ 0);
+        sh.traceUpdate(trNode);
+    }
     dst.insert(sh);
     return false;
 }
@@ -2573,9 +2579,12 @@ bool SymExecCore::execCore(
     // kill variables
     this->killInsn(insn);
 
-    Trace::Node *trOrig = sh_.traceNode();
-    Trace::Node *trInsn = new Trace::InsnNode(trOrig, &insn, /* bin */ false);
-    sh_.traceUpdate(trInsn);
+    if (!GlConf::data.noTrace) {
+        Trace::Node *trOrig = sh_.traceNode();
+        Trace::Node *trInsn =
+            new Trace::InsnNode(trOrig, &insn, /* bin */ false);
+        sh_.traceUpdate(trInsn);
+    }
     dst.insert(sh_);
     return true;
 }
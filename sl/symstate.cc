@@ -47,6 +47,10 @@ static bool debugSymState = static_cast<bool>(DEBUG_SYMSTATE);
 
 static int cntLookups = -1;
 
+// statistics of SymStateWithJoin (see printJoinStats())
+static unsigned cntJoinAttempts = 0U;
+static unsigned cntJoinsAvoided = 0U;
+
 namespace {
     void debugPlot(const char *name, int idx, const SymHeap &sh) {
 #if DEBUG_SYMJOIN
@@ -168,7 +172,45 @@ void SymState::updateTraceOf(const int idx, Trace::Node *tr, EJoinStatus status)
 
 // /////////////////////////////////////////////////////////////////////////////
 // SymHeapUnion implementation
-int SymHeapUnion::lookup(const SymHeap &lookFor) const
+namespace {
+    THeapHash fingerprintOf(const SymHeap &sh)
+    {
+#if SE_STATE_HASH_LOOKUP
+        return heapFingerprint(sh);
+#else
+        // put all heaps into a single bucket, which means linear search
+        (void) sh;
+        return 0;
+#endif
+    }
+}
+
+void SymHeapUnion::appendHash(const THeapHash hash) const
+{
+    const int idx = hashes_.size();
+    hashes_.push_back(hash);
+    index_[hash].push_back(idx);
+}
+
+void SymHeapUnion::syncHashes() const
+{
+    // SymState::operator=() and insertNew() append the heaps without hashing
+    const int cnt = this->size();
+    for (int idx = hashes_.size(); idx < cnt; ++idx)
+        this->appendHash(fingerprintOf(this->operator[](idx)));
+}
+
+void SymHeapUnion::rebuildIndex() const
+{
+    index_.clear();
+
+    const int cnt = hashes_.size();
+    for (int idx = 0; idx < cnt; ++idx)
+        index_[hashes_[idx]].push_back(idx);
+}
+
+int SymHeapUnion::lookupCore(const SymHeap &lookFor, const THeapHash hash)
+    const
 {
     const int cnt = this->size();
     if (!cnt)
@@ -177,34 +219,236 @@ int SymHeapUnion::lookup(const SymHeap &lookFor) const
 
     ++::cntLookups;
     debugPlot("lookup", 0, lookFor);
+    this->syncHashes();
 
-    for(int idx = 0; idx < cnt; ++idx) {
-        const int nth = idx + 1;
+    const THashIndex::const_iterator it = index_.find(hash);
+    if (index_.end() != it) {
+        // only heaps with the same fingerprint can be isomorphic
+        BOOST_FOREACH(const int idx, it->second) {
+            const int nth = idx + 1;
 
-        const SymHeap &sh = this->operator[](idx);
-        debugPlot("lookup", nth, sh);
+            const SymHeap &sh = this->operator[](idx);
+            debugPlot("lookup", nth, sh);
 
-        if (areEqual(lookFor, sh)) {
-            CL_DEBUG("<I> sh #" << idx << " is equal to the given one, "
-                    << cnt << " heaps in total");
+            if (areEqual(lookFor, sh)) {
+                CL_DEBUG("<I> sh #" << idx << " is equal to the given one, "
+                        << cnt << " heaps in total");
 
-            if (1 < GlConf::data.stateLiveOrdering)
-                // put the matched heap at beginning of the list [optimization]
-                const_cast<SymHeapUnion *>(this)->rotateExisting(0U, idx);
+                if (1 < GlConf::data.stateLiveOrdering)
+                    // put the matched heap at beginning of the list
+                    const_cast<SymHeapUnion *>(this)->rotateExisting(0U, idx);
 
-            return idx;
+                return idx;
+            }
         }
     }
 
+#if 1 < SE_STATE_HASH_LOOKUP
+    // cross-check the result with the linear search (expensive)
+    for(int idx = 0; idx < cnt; ++idx)
+        if (areEqual(lookFor, this->operator[](idx)))
+            CL_BREAK_IF("heapFingerprint() is not invariant under isomorphism");
+#endif
+
     // not found
     return -1;
 }
 
+int SymHeapUnion::lookup(const SymHeap &lookFor) const
+{
+    if (!this->size())
+        // empty state --> not found (do not waste time by hashing the heap)
+        return -1;
+
+    return this->lookupCore(lookFor, fingerprintOf(lookFor));
+}
+
+bool SymHeapUnion::insert(const SymHeap &sh, bool /* allowThreeWay */ )
+{
+    const THeapHash hash = fingerprintOf(sh);
+    if (-1 != this->lookupCore(sh, hash))
+        return false;
+
+    // add given heap to union
+    this->syncHashes();
+    this->insertNew(sh);
+
+    // the inserted heap is a clone of sh, so we can reuse its fingerprint
+    this->appendHash(hash);
+    return true;
+}
+
+void SymHeapUnion::clear()
+{
+    SymState::clear();
+    hashes_.clear();
+    index_.clear();
+}
+
+void SymHeapUnion::swap(SymState &other)
+{
+    SymState::swap(other);
+
+    // invalidate the fingerprints on both sides
+    hashes_.clear();
+    index_.clear();
+    SymHeapUnion *huni = dynamic_cast<SymHeapUnion *>(&other);
+    if (huni) {
+        huni->hashes_.clear();
+        huni->index_.clear();
+    }
+}
+
+void SymHeapUnion::insertNew(const SymHeap &sh)
+{
+    // the heap is going to be hashed on the next lookup (if any)
+    SymState::insertNew(sh);
+}
+
+void SymHeapUnion::eraseExisting(const int nth)
+{
+    SymState::eraseExisting(nth);
+    if (static_cast<int>(hashes_.size()) <= nth)
+        // the heap has not been hashed yet
+        return;
+
+    // indices of all heaps behind the erased one are shifted by one
+    hashes_.erase(hashes_.begin() + nth);
+    this->rebuildIndex();
+}
+
+void SymHeapUnion::swapExisting(const int nth, SymHeap &sh)
+{
+    SymState::swapExisting(nth, sh);
+    if (static_cast<int>(hashes_.size()) <= nth)
+        // the heap has not been hashed yet
+        return;
+
+    // remove the heap from the bucket of its original fingerprint
+    THeapHash &hash = hashes_[nth];
+    TIdxList &idxListOld = index_[hash];
+    idxListOld.erase(std::find(idxListOld.begin(), idxListOld.end(), nth));
+    if (idxListOld.empty())
+        index_.erase(hash);
+
+    // hash the swapped heap and keep the bucket sorted by indices
+    hash = fingerprintOf(this->operator[](nth));
+    TIdxList &idxList = index_[hash];
+    idxList.insert(std::lower_bound(idxList.begin(), idxList.end(), nth), nth);
+}
+
+void SymHeapUnion::rotateExisting(const int idxA, const int idxB)
+{
+    this->syncHashes();
+    SymState::rotateExisting(idxA, idxB);
+
+    THashList::iterator itA = hashes_.begin() + idxA;
+    THashList::iterator itB = hashes_.begin() + idxB;
+    rotate(itA, itB, hashes_.end());
+
+    // indices of all heaps behind idxA have changed
+    this->rebuildIndex();
+}
+
 
 // /////////////////////////////////////////////////////////////////////////////
 // SymStateWithJoin implementation
+void SymStateWithJoin::syncSigs() const
+{
+    // SymState::operator=() appends the heaps without calling insertNew()
+    sigs_.resize(this->size());
+    sigDone_.resize(this->size(), /* not computed yet */ false);
+}
+
+bool SymStateWithJoin::joinable(const int nth, const JoinSignature &sigOther)
+    const
+{
+    ++::cntJoinAttempts;
+#if SE_JOIN_PREFILTER
+    this->syncSigs();
+    if (!sigDone_[nth]) {
+        joinSignature(&sigs_[nth], this->operator[](nth));
+        sigDone_[nth] = true;
+    }
+
+    if (joinSigCompatible(sigs_[nth], sigOther))
+        return true;
+
+    ++::cntJoinsAvoided;
+    return false;
+#else
+    (void) nth;
+    (void) sigOther;
+    return true;
+#endif
+}
+
+void SymStateWithJoin::clear()
+{
+    SymHeapUnion::clear();
+    sigs_.clear();
+    sigDone_.clear();
+}
+
+void SymStateWithJoin::swap(SymState &other)
+{
+    SymHeapUnion::swap(other);
+
+    // invalidate the signatures on both sides
+    sigs_.clear();
+    sigDone_.clear();
+    SymStateWithJoin *sswj = dynamic_cast<SymStateWithJoin *>(&other);
+    if (sswj) {
+        sswj->sigs_.clear();
+        sswj->sigDone_.clear();
+    }
+}
+
+void SymStateWithJoin::insertNew(const SymHeap &sh)
+{
+    this->syncSigs();
+    SymHeapUnion::insertNew(sh);
+    sigs_.push_back(JoinSignature());
+    sigDone_.push_back(/* not computed yet */ false);
+}
+
+void SymStateWithJoin::eraseExisting(const int nth)
+{
+    this->syncSigs();
+    SymHeapUnion::eraseExisting(nth);
+    sigs_.erase(sigs_.begin() + nth);
+    sigDone_.erase(sigDone_.begin() + nth);
+}
+
+void SymStateWithJoin::swapExisting(const int nth, SymHeap &sh)
+{
+    this->syncSigs();
+    SymHeapUnion::swapExisting(nth, sh);
+    sigDone_[nth] = /* not computed yet */ false;
+}
+
+void SymStateWithJoin::rotateExisting(const int idxA, const int idxB)
+{
+    this->syncSigs();
+    SymHeapUnion::rotateExisting(idxA, idxB);
+
+    TSigList::iterator itA = sigs_.begin() + idxA;
+    TSigList::iterator itB = sigs_.begin() + idxB;
+    rotate(itA, itB, sigs_.end());
+
+    TSigDone::iterator itDoneA = sigDone_.begin() + idxA;
+    TSigDone::iterator itDoneB = sigDone_.begin() + idxB;
+    rotate(itDoneA, itDoneB, sigDone_.end());
+}
+
 void SymStateWithJoin::packState(unsigned idxNew, bool allowThreeWay)
 {
+    // signature of the heap at idxNew (kept outside of sigs_ as we erase)
+    JoinSignature sigNew;
+#if SE_JOIN_PREFILTER
+    joinSignature(&sigNew, this->operator[](idxNew));
+#endif
+
     for (unsigned idxOld = 0U; idxOld < this->size();) {
         if (idxNew == idxOld) {
             // do not remove the newly inserted heap based on identity with self
@@ -220,6 +464,15 @@ void SymStateWithJoin::packState(unsigned idxNew, bool allowThreeWay)
 
         EJoinStatus     status;
         SymHeap         result(stor, new Trace::TransientNode("packState()"));
+        if (!this->joinable(idxOld, sigNew)) {
+#if 1 < SE_JOIN_PREFILTER
+            if (joinSymHeaps(&status, &result, shOld, shNew, allowThreeWay))
+                CL_BREAK_IF("joinSigCompatible() is not join-monotone");
+#endif
+            ++idxOld;
+            continue;
+        }
+
         if (!joinSymHeaps(&status, &result, shOld, shNew, allowThreeWay)) {
             ++idxOld;
             continue;
@@ -249,6 +502,12 @@ void SymStateWithJoin::packState(unsigned idxNew, bool allowThreeWay)
                 break;
         }
 
+#if SE_JOIN_PREFILTER
+        if (JS_USE_SH1 == status || JS_THREE_WAY == status)
+            // the heap at idxNew has changed, so has its signature
+            joinSignature(&sigNew, this->operator[](idxNew));
+#endif
+
         if (JS_THREE_WAY != status)
             // pick the resulting tr node while preserving the heap itself
             this->updateTraceOf(idxNew, result.traceNode(), status);
@@ -296,9 +555,22 @@ bool SymStateWithJoin::insert(const SymHeap &shNew, bool allowThreeWay)
             new Trace::TransientNode("SymStateWithJoin::insert()"));
     int             idx;
 
+    JoinSignature sigNew;
+#if SE_JOIN_PREFILTER
+    joinSignature(&sigNew, shNew);
+#endif
+
     ++::cntLookups;
     for(idx = 0; idx < cnt; ++idx) {
         const SymHeap &shOld = this->operator[](idx);
+        if (!this->joinable(idx, sigNew)) {
+#if 1 < SE_JOIN_PREFILTER
+            if (joinSymHeaps(&status, &result, shOld, shNew, allowThreeWay))
+                CL_BREAK_IF("joinSigCompatible() is not join-monotone");
+#endif
+            continue;
+        }
+
         if (!joinSymHeaps(&status, &result, shOld, shNew, allowThreeWay))
             continue;
 
@@ -372,6 +644,13 @@ bool SymStateWithJoin::insert(const SymHeap &shNew, bool allowThreeWay)
 }
 
 
+void printJoinStats()
+{
+    CL_NOTE("SymStateWithJoin: " << ::cntJoinAttempts << " join attempt(s), "
+            << ::cntJoinsAvoided << " join attempt(s) avoided by signature");
+}
+
+
 // /////////////////////////////////////////////////////////////////////////////
 // BlockScheduler implementation
 struct BlockScheduler::Private {
@@ -560,7 +839,7 @@ void SymStateMarked::swap(SymState &other)
 
 void SymStateMarked::rotateExisting(const int idxA, const int idxB)
 {
-    SymState::rotateExisting(idxA, idxB);
+    SymStateWithJoin::rotateExisting(idxA, idxB);
 
     TDone::iterator itA = done_.begin() + idxA;
     TDone::iterator itB = done_.begin() + idxB;
@@ -26,9 +26,12 @@
  */
 
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "join_status.hh"
+#include "symcmp.hh"
+#include "symjoin.hh"
 #include "symheap.hh"
 
 namespace CodeStorage {
@@ -140,20 +143,84 @@ class SymHeapList: public SymState {
  * symbolically executed function is then the SymState taken from the basic
  * block containing CL_INSN_RET as soon as the fix-point calculation has
  * terminated.
+ *
+ * Each heap is accompanied by its fingerprint (see heapFingerprint()), which
+ * is computed lazily on the first lookup.  The expensive areEqual() is then
+ * called only for heaps with matching fingerprints.
  */
 class SymHeapUnion: public SymState {
     public:
         virtual int lookup(const SymHeap &sh) const;
+
+        virtual bool insert(const SymHeap &sh, bool allowThreeWay = true);
+
+        virtual void clear();
+
+        virtual void swap(SymState &);
+
+    protected:
+        virtual void insertNew(const SymHeap &sh);
+        virtual void eraseExisting(int nth);
+        virtual void swapExisting(int nth, SymHeap &sh);
+        virtual void rotateExisting(int idxA, int idxB);
+
+        /// lookup/insert optimization in SymCallCache implementation
+        friend class PerFncCache;
+
+    private:
+        int lookupCore(const SymHeap &sh, THeapHash hash) const;
+        void appendHash(THeapHash hash) const;
+        void syncHashes() const;
+        void rebuildIndex() const;
+
+        typedef std::vector<THeapHash>                      THashList;
+        typedef std::vector<int>                            TIdxList;
+        typedef std::unordered_map<THeapHash, TIdxList>     THashIndex;
+
+        /// fingerprints of the first hashes_.size() heaps in the state
+        mutable THashList       hashes_;
+
+        /// indices of heaps with the given fingerprint in ascending order
+        mutable THashIndex      index_;
 };
 
+/**
+ * symbolic state that uses joinSymHeaps() to merge the inserted heaps
+ *
+ * Each heap is accompanied by its JoinSignature, which is computed lazily on
+ * the first insert().  The heaps whose signatures are not compatible with the
+ * inserted heap are skipped without calling joinSymHeaps() on them.
+ */
 class SymStateWithJoin: public SymHeapUnion {
     public:
         virtual bool insert(const SymHeap &sh, bool allowThreeWay = true);
 
+        virtual void clear();
+
+        virtual void swap(SymState &);
+
+    protected:
+        virtual void insertNew(const SymHeap &sh);
+        virtual void eraseExisting(int nth);
+        virtual void swapExisting(int nth, SymHeap &sh);
+        virtual void rotateExisting(int idxA, int idxB);
+
     private:
         void packState(unsigned idx, bool allowThreeWay);
+        bool joinable(int nth, const JoinSignature &sigOther) const;
+        void syncSigs() const;
+
+        typedef std::vector<JoinSignature>              TSigList;
+        typedef std::vector<bool>                       TSigDone;
+
+        /// join signatures of the heaps in the state (valid if sigDone_[i])
+        mutable TSigList        sigs_;
+        mutable TSigDone        sigDone_;
 };
 
+/// print the statistics of SymStateWithJoin (see also SE_JOIN_PREFILTER)
+void printJoinStats();
+
 /**
  * Extension of SymStateWithJoin, which distinguishes among already processed
  * symbolic heaps and symbolic heaps scheduled for processing.  Newly inserted
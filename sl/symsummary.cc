@@ -0,0 +1,1313 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include "symsummary.hh"
+
+#include <cl/cl_msg.hh>
+#include <cl/clutil.hh>
+#include <cl/storage.hh>
+
+#include "glconf.hh"
+#include "symcmp.hh"
+#include "symseg.hh"
+#include "symstate.hh"
+#include "symtrace.hh"
+#include "symutil.hh"
+#include "worklist.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/foreach.hpp>
+
+// The summaries are written as plain text, one item per line:
+//
+//   summaries SHA1 CONFIG          applies to the records that follow
+//   fnc UID NAME KEY               starts a record, KEY covers fnc and callees
+//   check t|v|f UID HASH           identity of a type/var/fnc used by the heaps
+//   heap ... done                  the call entry, then the results of the call
+//   end                            closes the record
+//
+// The heaps refer to their objects and values by indexes local to the heap,
+// so the format does not depend on IDs of any entities of the analyzer.  The
+// records written by worker processes can be simply appended to each other.
+
+typedef unsigned long long                              THash;
+
+/// 64-bit FNV-1a, stable across runs and builds (unlike std::hash)
+static THash hashOfString(const std::string &str)
+{
+    THash hash = 0xcbf29ce484222325ULL;
+    BOOST_FOREACH(const char c, str) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+static std::string hashToString(const THash hash)
+{
+    std::ostringstream str;
+    str << std::hex << hash;
+    return str.str();
+}
+
+/// options that do not affect the results of the analysis
+static const char *ignoredOptions[] = {
+    "fnc_summaries",
+    "jobs",
+    "mem_budget",
+    "mem_usage_log",
+    "no_plot",
+    "trace_stream"
+};
+
+/// hash of the config string, ignoring the order and the unrelated options
+static THash configHash(const std::string &configString)
+{
+    std::vector<std::string> opts;
+    boost::split(opts, configString, boost::algorithm::is_any_of(","));
+
+    std::vector<std::string> relevant;
+    BOOST_FOREACH(const std::string &opt, opts) {
+        const std::string name(opt.begin(),
+                std::find(opt.begin(), opt.end(), ':'));
+
+        const char **const end = ignoredOptions
+            + sizeof ignoredOptions / sizeof *ignoredOptions;
+        if (end == std::find(ignoredOptions, end, name))
+            relevant.push_back(opt);
+    }
+
+    std::sort(relevant.begin(), relevant.end());
+    return hashOfString(boost::algorithm::join(relevant, ","));
+}
+
+
+// /////////////////////////////////////////////////////////////////////////////
+// SummaryDb, the summaries known to the current process
+struct FncSummary {
+    const CodeStorage::Fnc     *fnc;
+    SymHeap                     entry;
+    SymHeapList                 results;
+
+    FncSummary(const CodeStorage::Fnc *fnc_, const SymHeap &entry_):
+        fnc(fnc_),
+        entry(entry_)
+    {
+        Trace::waiveCloneOperation(entry);
+    }
+};
+
+struct SummaryDb {
+    typedef std::vector<FncSummary *>                   TList;
+    typedef std::map<int /* fnc uid */, TList>          TByFnc;
+    typedef std::map<int /* uid */, THash>              THashMap;
+    typedef std::map<int /* uid */, const cl_type *>    TTypeMap;
+    typedef std::map<int /* uid */, const CodeStorage::Var *> TVarMap;
+    typedef std::map<int /* uid */, const CodeStorage::Fnc *> TFncMap;
+
+    TStorRef                    stor;
+    const std::string           config;
+    TByFnc                      byFnc;
+    THashMap                    fncKeys;
+    THashMap                    typeHashes;
+    TTypeMap                    typeByUid;
+    TVarMap                     varByUid;
+    TFncMap                     fncByUid;
+
+    SummaryDb(TStorRef stor_, const std::string &config_);
+    ~SummaryDb();
+
+    FncSummary* find(const CodeStorage::Fnc &fnc, const SymHeap &entry) const;
+    bool insert(FncSummary *);
+
+    THash typeHash(const cl_type *);
+    THash varHash(int uid);
+    THash fncHash(int uid);
+    THash fncKey(const CodeStorage::Fnc &);
+};
+
+static SummaryDb *summaryDb;
+
+SummaryDb::SummaryDb(TStorRef stor_, const std::string &config_):
+    stor(stor_),
+    config(config_)
+{
+    BOOST_FOREACH(const cl_type *clt, stor.types)
+        if (clt)
+            typeByUid[clt->uid] = clt;
+
+    BOOST_FOREACH(const CodeStorage::Var &var, stor.vars)
+        varByUid[var.uid] = &var;
+
+    BOOST_FOREACH(const CodeStorage::Fnc *fnc, stor.fncs)
+        fncByUid[uidOf(*fnc)] = fnc;
+}
+
+SummaryDb::~SummaryDb()
+{
+    BOOST_FOREACH(TByFnc::const_reference item, byFnc)
+        BOOST_FOREACH(FncSummary *sum, item.second)
+            delete sum;
+}
+
+FncSummary* SummaryDb::find(
+        const CodeStorage::Fnc         &fnc,
+        const SymHeap                  &entry)
+    const
+{
+    const TByFnc::const_iterator it = byFnc.find(uidOf(fnc));
+    if (byFnc.end() == it)
+        return 0;
+
+    BOOST_FOREACH(FncSummary *sum, it->second)
+        if (areEqual(sum->entry, entry))
+            return sum;
+
+    return 0;
+}
+
+bool SummaryDb::insert(FncSummary *sum)
+{
+    if (this->find(*sum->fnc, sum->entry)) {
+        delete sum;
+        return false;
+    }
+
+    byFnc[uidOf(*sum->fnc)].push_back(sum);
+    return true;
+}
+
+
+// /////////////////////////////////////////////////////////////////////////////
+// identification of types, variables, and functions by their contents
+static void digestTypeShallow(std::ostream &str, const struct cl_type *clt)
+{
+    if (!clt) {
+        str << "-";
+        return;
+    }
+
+    str << clt->code << "/" << clt->is_unsigned
+        << "/" << clt->size << "/" << clt->array_size
+        << "/" << ((clt->name) ? clt->name : "");
+}
+
+static void digestType(std::ostream &str, const struct cl_type *clt)
+{
+    digestTypeShallow(str, clt);
+    if (!clt)
+        return;
+
+    const bool isPtr = (CL_TYPE_PTR == clt->code || CL_TYPE_FNC == clt->code);
+
+    str << "{";
+    for (int i = 0; i < clt->item_cnt; ++i) {
+        const struct cl_type_item &item = clt->items[i];
+        str << ((item.name) ? item.name : "") << "@" << item.offset << ":";
+        if (isPtr)
+            // do not follow pointers, the target type may be recursive
+            digestTypeShallow(str, item.type);
+        else
+            digestType(str, item.type);
+    }
+    str << "}";
+}
+
+THash SummaryDb::typeHash(const cl_type *clt)
+{
+    if (!clt)
+        return 0ULL;
+
+    const THashMap::const_iterator it = typeHashes.find(clt->uid);
+    if (typeHashes.end() != it)
+        return it->second;
+
+    std::ostringstream str;
+    digestType(str, clt);
+    return typeHashes[clt->uid] = hashOfString(str.str());
+}
+
+THash SummaryDb::varHash(const int uid)
+{
+    const TVarMap::const_iterator it = varByUid.find(uid);
+    if (varByUid.end() == it)
+        return 0ULL;
+
+    const CodeStorage::Var &var = *it->second;
+    std::ostringstream str;
+    str << var.name << "/" << var.code << "/" << this->typeHash(var.type);
+    return hashOfString(str.str());
+}
+
+THash SummaryDb::fncHash(const int uid)
+{
+    const TFncMap::const_iterator it = fncByUid.find(uid);
+    if (fncByUid.end() == it)
+        return 0ULL;
+
+    return hashOfString(nameOf(*it->second));
+}
+
+static void digestOperand(
+        std::ostream                   &str,
+        SummaryDb                      &db,
+        const struct cl_operand        &op)
+{
+    str << "(" << op.code << "/" << op.scope << "/" << db.typeHash(op.type);
+
+    for (const struct cl_accessor *ac = op.accessor; ac; ac = ac->next) {
+        str << "/" << ac->code << ":" << db.typeHash(ac->type) << ":";
+        switch (ac->code) {
+            case CL_ACCESSOR_DEREF_ARRAY:
+                digestOperand(str, db, *ac->data.array.index);
+                break;
+
+            case CL_ACCESSOR_ITEM:
+                str << ac->data.item.id;
+                break;
+
+            case CL_ACCESSOR_OFFSET:
+                str << ac->data.offset.off;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    str << "/";
+    if (CL_OPERAND_VAR == op.code) {
+        // anonymous variables can be distinguished by their uids only
+        const struct cl_var *var = op.data.var;
+        if (var->name)
+            str << var->name;
+        else
+            str << "#" << var->uid;
+    }
+    else if (CL_OPERAND_CST == op.code) {
+        const struct cl_cst &cst = op.data.cst;
+        switch (cst.code) {
+            case CL_TYPE_FNC:
+                str << ((cst.data.cst_fnc.name) ? cst.data.cst_fnc.name : "");
+                break;
+
+            case CL_TYPE_STRING:
+                str << cst.data.cst_string.value;
+                break;
+
+            case CL_TYPE_REAL:
+                str << std::setprecision(17) << cst.data.cst_real.value;
+                break;
+
+            default:
+                str << cst.data.cst_int.value;
+        }
+    }
+
+    str << ")";
+}
+
+static void digestFnc(
+        std::ostream                   &str,
+        SummaryDb                      &db,
+        const CodeStorage::Fnc         &fnc)
+{
+    str << nameOf(fnc) << "/" << db.typeHash(fnc.def.type) << "(";
+    BOOST_FOREACH(const int uid, fnc.args)
+        str << db.varHash(uid) << ",";
+    str << ")\n";
+
+    if (!isDefined(fnc))
+        // a built-in or an external function, known by its name only
+        return;
+
+    BOOST_FOREACH(const CodeStorage::Block *bb, fnc.cfg) {
+        str << bb->name() << ":\n";
+        BOOST_FOREACH(const CodeStorage::Insn *insn, *bb) {
+            str << insn->code << "/" << insn->subCode;
+            BOOST_FOREACH(const struct cl_operand &op, insn->operands)
+                digestOperand(str, db, op);
+            BOOST_FOREACH(const CodeStorage::Block *target, insn->targets)
+                str << " -> " << target->name();
+            str << "\n";
+        }
+    }
+}
+
+/// hash of the code of the function and all its callees, 0 if not available
+THash SummaryDb::fncKey(const CodeStorage::Fnc &fnc)
+{
+    const int uid = uidOf(fnc);
+    const THashMap::const_iterator it = fncKeys.find(uid);
+    if (fncKeys.end() != it)
+        return it->second;
+
+    THash &key = fncKeys[uid];
+    key = 0ULL;
+
+    // gather the function and its callees, ordered by name to be stable
+    typedef std::map<std::string, const CodeStorage::Fnc *> TFncByName;
+    TFncByName closure;
+
+    const CodeStorage::Fnc *item = &fnc;
+    WorkList<const CodeStorage::Fnc *> wl(item);
+    while (wl.next(item)) {
+        closure[nameOf(*item)] = item;
+        if (!isDefined(*item))
+            continue;
+
+        const CodeStorage::CallGraph::Node *cgNode = item->cgNode;
+        if (!cgNode)
+            // no call graph, we cannot tell which functions are called
+            return key;
+
+        BOOST_FOREACH(CodeStorage::TInsnListByFnc::const_reference call,
+                cgNode->calls)
+        {
+            const CodeStorage::Fnc *callee = call.first;
+            if (!callee)
+                // an indirect call may reach any function
+                return key;
+
+            wl.schedule(callee);
+        }
+    }
+
+    std::ostringstream str;
+    BOOST_FOREACH(TFncByName::const_reference ref, closure)
+        digestFnc(str, *this, *ref.second);
+
+    key = hashOfString(str.str());
+    if (!key)
+        // 0 is reserved for functions that cannot be summarized
+        key = 1ULL;
+
+    return key;
+}
+
+
+// /////////////////////////////////////////////////////////////////////////////
+// serialization of SymHeap
+struct SummaryRefs {
+    typedef std::set<int /* uid */>                     TUidSet;
+
+    TUidSet                     types;
+    TUidSet                     vars;
+    TUidSet                     fncs;
+};
+
+static void writeRange(std::ostream &str, const IR::Range &rng)
+{
+    str << rng.lo << " " << rng.hi << " " << rng.alignment;
+}
+
+static bool readRange(std::istream &str, IR::Range *pRng)
+{
+    return !!(str >> pRng->lo >> pRng->hi >> pRng->alignment);
+}
+
+class HeapWriter {
+    public:
+        HeapWriter(SummaryDb &db, const SymHeap &sh, SummaryRefs &refs):
+            db_(db),
+            sh_(const_cast<SymHeap &>(sh)),
+            refs_(refs),
+            ok_(true)
+        {
+        }
+
+        bool /* success */ write(std::ostream &out);
+
+    private:
+        typedef std::map<TObjId, int /* idx */>         TObjIdx;
+        typedef std::map<TValId, int /* idx */>         TValIdx;
+
+        SummaryDb                  &db_;
+        SymHeap                    &sh_;
+        SummaryRefs                &refs_;
+        bool                        ok_;
+        TObjIdx                     objIdx_;
+        TValIdx                     valIdx_;
+        WorkList<TObjId>            wl_;
+        std::ostringstream          objs_;
+        std::ostringstream          vals_;
+        std::ostringstream          data_;
+
+        int typeRef(TObjType clt);
+        int objRef(TObjId obj);
+        int valRef(TValId val);
+        void writeObj(int idx, TObjId obj);
+        void writeCustomValue(std::ostream &str, TValId val);
+        void digFields(TObjId obj);
+        void writeNeqs();
+};
+
+int HeapWriter::typeRef(const TObjType clt)
+{
+    if (!clt)
+        return -1;
+
+    const int uid = clt->uid;
+    const SummaryDb::TTypeMap::const_iterator it = db_.typeByUid.find(uid);
+    if (db_.typeByUid.end() == it || it->second != clt)
+        // a type synthesized by the analyzer, we would not find it next time
+        ok_ = false;
+
+    refs_.types.insert(uid);
+    return uid;
+}
+
+void HeapWriter::writeObj(const int idx, const TObjId obj)
+{
+    const bool valid = sh_.isValid(obj);
+    objs_ << "obj " << idx << " ";
+
+    if (OBJ_RETURN == obj) {
+        const TObjType clt = sh_.objEstimatedType(obj);
+        objs_ << "ret " << valid << " " << this->typeRef(clt) << "\n";
+        return;
+    }
+
+    const EStorageClass code = sh_.objStorClass(obj);
+    if (isProgramVar(code)) {
+        CallInst from(-1, -1);
+        if (sh_.isAnonStackObj(obj, &from)) {
+            // anonymous stack object (used for C99 variadic arrays)
+            refs_.fncs.insert(from.uid);
+            objs_ << "anon ";
+            writeRange(objs_, sh_.objSize(obj));
+            objs_ << " " << from.uid << " " << from.inst;
+        }
+        else {
+            // regular program variable
+            const CVar cv = sh_.cVarByObject(obj);
+            refs_.vars.insert(cv.uid);
+            objs_ << "var " << cv.uid << " " << cv.inst;
+        }
+
+        objs_ << " " << valid << "\n";
+        return;
+    }
+
+    objs_ << "heap ";
+    writeRange(objs_, sh_.objSize(obj));
+    objs_ << " " << valid
+        << " " << this->typeRef(sh_.objEstimatedType(obj))
+        << " " << sh_.objProtoLevel(obj);
+
+    const EObjKind kind = sh_.objKind(obj);
+    objs_ << " " << kind;
+    if (OK_REGION != kind) {
+        const BindingOff off = (OK_OBJ_OR_NULL == kind)
+            ? BindingOff(OK_OBJ_OR_NULL)
+            : sh_.segBinding(obj);
+
+        objs_ << " " << off.head << " " << off.next << " " << off.prev
+            << " " << objMinLength(sh_, obj);
+    }
+
+    objs_ << "\n";
+}
+
+int HeapWriter::objRef(const TObjId obj)
+{
+    if (OBJ_NULL == obj)
+        // OBJ_NULL is a globally valid object ID
+        return 0;
+
+    const TObjIdx::const_iterator it = objIdx_.find(obj);
+    if (objIdx_.end() != it)
+        return it->second;
+
+    const int idx = objIdx_.size() + 1;
+    objIdx_[obj] = idx;
+    this->writeObj(idx, obj);
+    wl_.schedule(obj);
+    return idx;
+}
+
+void HeapWriter::writeCustomValue(std::ostream &str, const TValId val)
+{
+    const CustomValue &cv = sh_.valUnwrapCustom(val);
+    switch (cv.code()) {
+        case CV_FNC:
+            refs_.fncs.insert(cv.uid());
+            str << "fnc " << cv.uid();
+            return;
+
+        case CV_INT_RANGE:
+            str << "int ";
+            writeRange(str, cv.rng());
+            return;
+
+        case CV_REAL: {
+            // write the exact bits, decimal representation would be lossy
+            const double fpn = cv.fpn();
+            THash bits = 0ULL;
+            memcpy(&bits, &fpn, std::min(sizeof bits, sizeof fpn));
+            str << "real " << std::hex << bits << std::dec;
+            return;
+        }
+
+        case CV_STRING: {
+            const std::string &data = cv.str();
+            str << "str " << std::hex;
+            BOOST_FOREACH(const char c, data)
+                str << std::setw(2) << std::setfill('0')
+                    << static_cast<int>(static_cast<unsigned char>(c));
+            str << std::dec << "-";
+            return;
+        }
+
+        case CV_INVALID:
+            break;
+    }
+
+    CL_BREAK_IF("invalid custom value in HeapWriter::writeCustomValue()");
+    ok_ = false;
+}
+
+int HeapWriter::valRef(const TValId val)
+{
+    if (val <= 0)
+        // special value IDs always match
+        return val;
+
+    const TValIdx::const_iterator it = valIdx_.find(val);
+    if (valIdx_.end() != it)
+        return it->second;
+
+    std::ostringstream str;
+    const EValueTarget code = sh_.valTarget(val);
+    if (VT_CUSTOM == code)
+        this->writeCustomValue(str, val);
+
+    else if (isAnyDataArea(code)) {
+        const int obj = this->objRef(sh_.objByAddr(val));
+        const ETargetSpecifier ts = sh_.targetSpec(val);
+        if (VT_RANGE == code) {
+            str << "range " << obj << " " << ts << " ";
+            writeRange(str, sh_.valOffsetRange(val));
+        }
+        else
+            str << "addr " << obj << " " << ts << " " << sh_.valOffset(val);
+    }
+    else
+        // an unknown value
+        str << "unknown " << code << " " << sh_.valOrigin(val);
+
+    const int idx = valIdx_.size() + 1;
+    valIdx_[val] = idx;
+    vals_ << "val " << idx << " " << str.str() << "\n";
+    return idx;
+}
+
+void HeapWriter::digFields(const TObjId obj)
+{
+    if (!sh_.isValid(obj))
+        return;
+
+    const int idx = objIdx_[obj];
+
+    TUniBlockMap bMap;
+    sh_.gatherUniformBlocks(bMap, obj);
+    BOOST_FOREACH(TUniBlockMap::const_reference item, bMap) {
+        const UniformBlock &ub = item.second;
+        const int val = this->valRef(ub.tplValue);
+        data_ << "blk " << idx << " " << ub.off << " " << ub.size
+            << " " << val << "\n";
+    }
+
+    FldList fields;
+    sh_.gatherLiveFields(fields, obj);
+    BOOST_FOREACH(const FldHandle &fld, fields) {
+        const TObjType clt = fld.type();
+        if (isComposite(clt, /* includingArray */ false))
+            continue;
+
+        const TValId val = fld.value();
+        if (VAL_INVALID == val)
+            continue;
+
+        const int type = this->typeRef(clt);
+        const int valIdx = this->valRef(val);
+        data_ << "fld " << idx << " " << fld.offset() << " " << type
+            << " " << valIdx << "\n";
+    }
+}
+
+void HeapWriter::writeNeqs()
+{
+    BOOST_FOREACH(TValIdx::const_reference item, valIdx_) {
+        const TValId val = item.first;
+        TValList related;
+        sh_.gatherRelatedValues(related, val);
+        BOOST_FOREACH(const TValId other, related) {
+            if (!sh_.chkNeq(val, other))
+                continue;
+
+            int otherIdx = other;
+            if (0 < other) {
+                const TValIdx::const_iterator it = valIdx_.find(other);
+                if (valIdx_.end() == it || it->second < item.second)
+                    // not relevant, or already written the other way around
+                    continue;
+
+                otherIdx = it->second;
+            }
+
+            data_ << "neq " << item.second << " " << otherIdx << "\n";
+        }
+    }
+}
+
+bool HeapWriter::write(std::ostream &out)
+{
+    unsigned cntNeqs, cntCoins;
+    sh_.cntPreds(&cntNeqs, &cntCoins);
+    if (cntCoins)
+        // coincidences of offset ranges are not serialized for now
+        return false;
+
+    this->objRef(OBJ_RETURN);
+
+    TObjList live;
+    sh_.gatherObjects(live);
+    BOOST_FOREACH(const TObjId obj, live)
+        this->objRef(obj);
+
+    TObjId obj;
+    while (ok_ && wl_.next(obj))
+        this->digFields(obj);
+
+    this->writeNeqs();
+    if (!ok_)
+        return false;
+
+    out << "heap\n" << objs_.str() << vals_.str() << data_.str() << "done\n";
+    return true;
+}
+
+
+// /////////////////////////////////////////////////////////////////////////////
+// deserialization of SymHeap
+class HeapReader {
+    public:
+        HeapReader(SummaryDb &db, SymHeap &sh):
+            db_(db),
+            sh_(sh)
+        {
+        }
+
+        bool /* success */ readLine(const std::string &line);
+
+    private:
+        typedef std::map<int /* idx */, TObjId>         TObjByIdx;
+        typedef std::map<int /* idx */, TValId>         TValByIdx;
+
+        SummaryDb                  &db_;
+        SymHeap                    &sh_;
+        TObjByIdx                   objs_;
+        TValByIdx                   vals_;
+
+        bool readType(std::istream &, TObjType *);
+        bool readObjRef(std::istream &, TObjId *);
+        bool readValRef(std::istream &, TValId *);
+        bool readObj(std::istream &);
+        bool readVal(std::istream &);
+        bool readCustomValue(std::istream &, const std::string &, TValId *);
+};
+
+bool HeapReader::readType(std::istream &str, TObjType *pClt)
+{
+    int uid;
+    if (!(str >> uid))
+        return false;
+
+    if (-1 == uid) {
+        *pClt = 0;
+        return true;
+    }
+
+    const SummaryDb::TTypeMap::const_iterator it = db_.typeByUid.find(uid);
+    if (db_.typeByUid.end() == it)
+        return false;
+
+    *pClt = it->second;
+    return true;
+}
+
+bool HeapReader::readObjRef(std::istream &str, TObjId *pObj)
+{
+    int idx;
+    if (!(str >> idx))
+        return false;
+
+    if (!idx) {
+        *pObj = OBJ_NULL;
+        return true;
+    }
+
+    const TObjByIdx::const_iterator it = objs_.find(idx);
+    if (objs_.end() == it)
+        return false;
+
+    *pObj = it->second;
+    return true;
+}
+
+bool HeapReader::readValRef(std::istream &str, TValId *pVal)
+{
+    int idx;
+    if (!(str >> idx))
+        return false;
+
+    if (idx <= 0) {
+        *pVal = static_cast<TValId>(idx);
+        return true;
+    }
+
+    const TValByIdx::const_iterator it = vals_.find(idx);
+    if (vals_.end() == it)
+        return false;
+
+    *pVal = it->second;
+    return true;
+}
+
+bool HeapReader::readObj(std::istream &str)
+{
+    int idx;
+    std::string kind;
+    if (!(str >> idx >> kind) || objs_.end() != objs_.find(idx))
+        return false;
+
+    TObjId obj;
+    bool valid;
+    if ("ret" == kind) {
+        TObjType clt;
+        if (!(str >> valid) || !this->readType(str, &clt))
+            return false;
+
+        obj = OBJ_RETURN;
+        if (clt)
+            sh_.objSetEstimatedType(obj, clt);
+    }
+    else if ("var" == kind) {
+        CVar cv;
+        if (!(str >> cv.uid >> cv.inst >> valid))
+            return false;
+
+        obj = sh_.regionByVar(cv, /* createIfNeeded */ true);
+    }
+    else if ("anon" == kind) {
+        TSizeRange size;
+        CallInst from;
+        if (!readRange(str, &size) || !(str >> from.uid >> from.inst >> valid))
+            return false;
+
+        obj = sh_.stackAlloc(size, from);
+    }
+    else if ("heap" == kind) {
+        TSizeRange size;
+        TObjType clt;
+        TProtoLevel protoLevel;
+        int code;
+        if (!readRange(str, &size) || !(str >> valid)
+                || !this->readType(str, &clt) || !(str >> protoLevel >> code))
+            return false;
+
+        obj = sh_.heapAlloc(size);
+        if (!valid)
+            sh_.objInvalidate(obj);
+
+        if (clt)
+            sh_.objSetEstimatedType(obj, clt);
+
+        sh_.objSetProtoLevel(obj, protoLevel);
+
+        const EObjKind objKind = static_cast<EObjKind>(code);
+        if (OK_REGION != objKind) {
+            BindingOff off;
+            TMinLen minLength;
+            if (!(str >> off.head >> off.next >> off.prev >> minLength))
+                return false;
+
+            sh_.objSetAbstract(obj, objKind, off);
+            sh_.segSetMinLength(obj, minLength);
+        }
+
+        // already invalidated if needed
+        valid = true;
+    }
+    else
+        return false;
+
+    if (!valid)
+        sh_.objInvalidate(obj);
+
+    objs_[idx] = obj;
+    return true;
+}
+
+bool HeapReader::readCustomValue(
+        std::istream                   &str,
+        const std::string              &kind,
+        TValId                         *pVal)
+{
+    if ("fnc" == kind) {
+        int uid;
+        if (!(str >> uid))
+            return false;
+
+        *pVal = sh_.valWrapCustom(CustomValue(uid));
+        return true;
+    }
+
+    if ("int" == kind) {
+        IR::Range rng;
+        if (!readRange(str, &rng))
+            return false;
+
+        *pVal = sh_.valWrapCustom(CustomValue(rng));
+        return true;
+    }
+
+    if ("real" == kind) {
+        THash bits;
+        if (!(str >> std::hex >> bits >> std::dec))
+            return false;
+
+        double fpn = 0.0;
+        memcpy(&fpn, &bits, std::min(sizeof bits, sizeof fpn));
+        *pVal = sh_.valWrapCustom(CustomValue(fpn));
+        return true;
+    }
+
+    if ("str" == kind) {
+        std::string hex;
+        if (!(str >> hex) || hex.empty() || '-' != hex[hex.size() - 1])
+            return false;
+
+        std::string data;
+        for (size_t i = 0U; i + 2U < hex.size(); i += 2U) {
+            const std::string byte(hex, i, 2U);
+            data.push_back(static_cast<char>(strtol(byte.c_str(), 0, 16)));
+        }
+
+        *pVal = sh_.valWrapCustom(CustomValue(data.c_str()));
+        return true;
+    }
+
+    return false;
+}
+
+bool HeapReader::readVal(std::istream &str)
+{
+    int idx;
+    std::string kind;
+    if (!(str >> idx >> kind) || idx <= 0 || vals_.end() != vals_.find(idx))
+        return false;
+
+    TValId val;
+    if ("addr" == kind || "range" == kind) {
+        TObjId obj;
+        int ts;
+        if (!this->readObjRef(str, &obj) || !(str >> ts))
+            return false;
+
+        const ETargetSpecifier spec = static_cast<ETargetSpecifier>(ts);
+        if ("range" == kind) {
+            IR::Range rng;
+            if (!readRange(str, &rng))
+                return false;
+
+            const TValId root = sh_.addrOfTarget(obj, spec);
+            val = sh_.valByRange(root, rng);
+        }
+        else {
+            TOffset off;
+            if (!(str >> off))
+                return false;
+
+            val = sh_.addrOfTarget(obj, spec, off);
+        }
+    }
+    else if ("unknown" == kind) {
+        int code, origin;
+        if (!(str >> code >> origin))
+            return false;
+
+        val = sh_.valCreate(static_cast<EValueTarget>(code),
+                static_cast<EValueOrigin>(origin));
+    }
+    else if (!this->readCustomValue(str, kind, &val))
+        return false;
+
+    vals_[idx] = val;
+    return true;
+}
+
+bool HeapReader::readLine(const std::string &line)
+{
+    std::istringstream str(line);
+    std::string tag;
+    if (!(str >> tag))
+        return false;
+
+    if ("obj" == tag)
+        return this->readObj(str);
+
+    if ("val" == tag)
+        return this->readVal(str);
+
+    if ("blk" == tag) {
+        TObjId obj;
+        UniformBlock ub;
+        if (!this->readObjRef(str, &obj) || !(str >> ub.off >> ub.size)
+                || !this->readValRef(str, &ub.tplValue))
+            return false;
+
+        sh_.writeUniformBlock(obj, ub);
+        return true;
+    }
+
+    if ("fld" == tag) {
+        TObjId obj;
+        TOffset off;
+        TObjType clt;
+        TValId val;
+        if (!this->readObjRef(str, &obj) || !(str >> off)
+                || !this->readType(str, &clt) || !clt
+                || !this->readValRef(str, &val))
+            return false;
+
+        const FldHandle fld(sh_, obj, clt, off);
+        if (!fld.isValidHandle())
+            return false;
+
+        fld.setValue(val);
+        return true;
+    }
+
+    if ("neq" == tag) {
+        TValId v1, v2;
+        if (!this->readValRef(str, &v1) || !this->readValRef(str, &v2))
+            return false;
+
+        sh_.addNeq(v1, v2);
+        return true;
+    }
+
+    return false;
+}
+
+
+// /////////////////////////////////////////////////////////////////////////////
+// records of SummaryDb
+typedef std::vector<std::string>                        TLineList;
+
+static bool writeRecord(
+        std::ostream                   &out,
+        SummaryDb                      &db,
+        const FncSummary               &sum)
+{
+    const CodeStorage::Fnc &fnc = *sum.fnc;
+    const THash key = db.fncKey(fnc);
+    if (!key)
+        return false;
+
+    SummaryRefs refs;
+    std::ostringstream heaps;
+    if (!HeapWriter(db, sum.entry, refs).write(heaps))
+        return false;
+
+    const unsigned cnt = sum.results.size();
+    for (unsigned i = 0; i < cnt; ++i)
+        if (!HeapWriter(db, sum.results[i], refs).write(heaps))
+            return false;
+
+    out << "fnc " << uidOf(fnc) << " " << nameOf(fnc)
+        << " " << hashToString(key) << "\n";
+
+    BOOST_FOREACH(const int uid, refs.types)
+        out << "check t " << uid << " "
+            << hashToString(db.typeHash(db.typeByUid[uid])) << "\n";
+
+    BOOST_FOREACH(const int uid, refs.vars)
+        out << "check v " << uid << " "
+            << hashToString(db.varHash(uid)) << "\n";
+
+    BOOST_FOREACH(const int uid, refs.fncs)
+        out << "check f " << uid << " "
+            << hashToString(db.fncHash(uid)) << "\n";
+
+    out << heaps.str() << "end\n";
+    return true;
+}
+
+/// true if the given record line matches the code being analyzed now
+static bool checkRef(SummaryDb &db, const std::string &line)
+{
+    std::istringstream str(line);
+    std::string tag, kind, hash;
+    int uid;
+    if (!(str >> tag >> kind >> uid >> hash))
+        return false;
+
+    if ("t" == kind) {
+        const SummaryDb::TTypeMap::const_iterator it = db.typeByUid.find(uid);
+        return db.typeByUid.end() != it
+            && hash == hashToString(db.typeHash(it->second));
+    }
+
+    if ("v" == kind)
+        return db.varByUid.count(uid)
+            && hash == hashToString(db.varHash(uid));
+
+    if ("f" == kind)
+        return db.fncByUid.count(uid)
+            && hash == hashToString(db.fncHash(uid));
+
+    return false;
+}
+
+static Trace::Node* createSummaryNode(const CodeStorage::Fnc &fnc)
+{
+    if (GlConf::data.noTrace)
+        return Trace::NullNode::instance();
+
+    return new Trace::SummaryNode(&fnc);
+}
+
+/// return the summary read from the given record, 0 if it is not applicable
+static FncSummary* readRecord(SummaryDb &db, const TLineList &rec)
+{
+    std::istringstream str(rec.front());
+    std::string tag, name, key;
+    int uid;
+    if (!(str >> tag >> uid >> name >> key))
+        return 0;
+
+    const SummaryDb::TFncMap::const_iterator it = db.fncByUid.find(uid);
+    if (db.fncByUid.end() == it)
+        return 0;
+
+    const CodeStorage::Fnc &fnc = *it->second;
+    if (name != nameOf(fnc) || key != hashToString(db.fncKey(fnc)))
+        // the code of the function or any of its callees has changed
+        return 0;
+
+    FncSummary *sum = 0;
+    SymHeap *sh = 0;
+    HeapReader *reader = 0;
+    bool ok = true;
+
+    for (unsigned i = 1U; ok && i < rec.size(); ++i) {
+        const std::string &line = rec[i];
+        if (boost::algorithm::starts_with(line, "check "))
+            ok = checkRef(db, line);
+
+        else if ("heap" == line) {
+            if (sh) {
+                ok = false;
+                break;
+            }
+
+            sh = new SymHeap(db.stor, createSummaryNode(fnc));
+            reader = new HeapReader(db, *sh);
+        }
+
+        else if ("done" == line && sh) {
+            if (sum)
+                sum->results.insert(*sh);
+            else
+                sum = new FncSummary(&fnc, *sh);
+
+            delete reader;
+            delete sh;
+            reader = 0;
+            sh = 0;
+        }
+
+        else
+            ok = reader && reader->readLine(line);
+    }
+
+    delete reader;
+    delete sh;
+    if (ok && sum)
+        return sum;
+
+    delete sum;
+    return 0;
+}
+
+static bool readFile(SummaryDb &db, const std::string &fileName)
+{
+    std::ifstream in(fileName.c_str());
+    if (!in)
+        return false;
+
+    const std::string header = std::string("summaries ") + GIT_SHA1
+        + " " + db.config;
+
+    bool valid = false;
+    int cntLoaded = 0;
+    int cntStale = 0;
+
+    TLineList rec;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (boost::algorithm::starts_with(line, "summaries ")) {
+            // the records that follow apply to this build and configuration
+            valid = (header == line);
+            continue;
+        }
+
+        if ("end" != line) {
+            rec.push_back(line);
+            continue;
+        }
+
+        FncSummary *sum = (valid && !rec.empty())
+            ? readRecord(db, rec)
+            : 0;
+
+        if (sum && db.insert(sum))
+            ++cntLoaded;
+        else if (!sum)
+            ++cntStale;
+
+        rec.clear();
+    }
+
+    CL_DEBUG("loaded " << cntLoaded << " function summaries from '"
+            << fileName << "', " << cntStale << " stale ones skipped");
+    return true;
+}
+
+
+// /////////////////////////////////////////////////////////////////////////////
+// public interface, see symsummary.hh for details
+void loadFncSummaries(
+        TStorRef                        stor,
+        const std::string              &fileName,
+        const std::string              &configString)
+{
+    CL_BREAK_IF(summaryDb);
+    const std::string config = hashToString(configHash(configString));
+    summaryDb = new SummaryDb(stor, config);
+    readFile(*summaryDb, fileName);
+}
+
+void mergeFncSummaries(const std::string &fileName)
+{
+    if (!summaryDb)
+        return;
+
+    if (readFile(*summaryDb, fileName))
+        remove(fileName.c_str());
+}
+
+bool saveFncSummaries(const std::string &fileName)
+{
+    if (!summaryDb)
+        return true;
+
+    std::ofstream out(fileName.c_str(), std::ios::out | std::ios::trunc);
+    out << "summaries " << GIT_SHA1 << " " << summaryDb->config << "\n";
+
+    int cnt = 0;
+    BOOST_FOREACH(SummaryDb::TByFnc::const_reference item, summaryDb->byFnc)
+        BOOST_FOREACH(const FncSummary *sum, item.second)
+            if (writeRecord(out, *summaryDb, *sum))
+                ++cnt;
+
+    out.close();
+    CL_DEBUG("saved " << cnt << " function summaries to '"
+            << fileName << "'");
+
+    delete summaryDb;
+    summaryDb = 0;
+    return !out.fail();
+}
+
+bool lookupFncSummary(
+        SymState                       &dst,
+        const CodeStorage::Fnc         &fnc,
+        const SymHeap                  &entry)
+{
+    if (!summaryDb)
+        return false;
+
+    const FncSummary *sum = summaryDb->find(fnc, entry);
+    if (!sum)
+        return false;
+
+    const unsigned cnt = sum->results.size();
+    for (unsigned i = 0; i < cnt; ++i)
+        dst.insert(sum->results[i]);
+
+    return true;
+}
+
+void recordFncSummary(
+        const CodeStorage::Fnc         &fnc,
+        const SymHeap                  &entry,
+        const SymState                 &results)
+{
+    if (!summaryDb || !summaryDb->fncKey(fnc))
+        return;
+
+    if (summaryDb->find(fnc, entry))
+        // already known, e.g. computed from another root function
+        return;
+
+    SymHeap entryDup(entry);
+    Trace::waiveCloneOperation(entryDup);
+    entryDup.traceUpdate(
+            new Trace::TransientNode("recordFncSummary()"));
+
+    FncSummary *sum = new FncSummary(&fnc, entryDup);
+
+    // detach the results from the trace graph of the current root function
+    const unsigned cnt = results.size();
+    for (unsigned i = 0; i < cnt; ++i) {
+        SymHeap sh(results[i]);
+        Trace::waiveCloneOperation(sh);
+        sh.traceUpdate(createSummaryNode(fnc));
+        sum->results.insert(sh);
+    }
+
+    summaryDb->insert(sum);
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_SYM_SUMMARY_H
+#define H_GUARD_SYM_SUMMARY_H
+
+/**
+ * @file symsummary.hh
+ * persistent function summaries (call entry heap -> results of the call) that
+ * survive the run of the analyzer, see the option @b fnc_summaries of GlConf
+ */
+
+#include "symheap.hh"
+
+#include <string>
+
+class SymState;
+
+namespace CodeStorage {
+    struct Fnc;
+}
+
+/**
+ * load the function summaries written by a previous run on the same code
+ * @param configString the configuration of the current run, summaries written
+ * with a different configuration (or by a different build) are ignored
+ * @note a missing file is not an error, there is nothing to load on first run
+ */
+void loadFncSummaries(
+        TStorRef                    stor,
+        const std::string          &fileName,
+        const std::string          &configString);
+
+/**
+ * merge the summaries written by a worker process and remove its file
+ * @note the summaries already known to the current process are skipped
+ */
+void mergeFncSummaries(const std::string &fileName);
+
+/**
+ * write all summaries known to the current process and drop them from memory
+ * @return false if the file could not be written
+ */
+bool saveFncSummaries(const std::string &fileName);
+
+/**
+ * look for a summary of the given function for the given call entry
+ * @param dst where to put the results of the call if the summary is found
+ * @param fnc the function which is about to be called
+ * @param entry the call entry heap as used by SymCallCache
+ * @return true if the summary has been found and the results copied to dst
+ */
+bool lookupFncSummary(
+        SymState                   &dst,
+        const CodeStorage::Fnc     &fnc,
+        const SymHeap              &entry);
+
+/**
+ * remember the results of a just completed function call for the next run
+ * @note the caller is responsible for not recording results of calls that
+ * have reported an error or warning, those would be silently lost next time
+ * @note the call is skipped unless the results can be safely serialized and
+ * the function along with its callees can be identified by their code
+ */
+void recordFncSummary(
+        const CodeStorage::Fnc     &fnc,
+        const SymHeap              &entry,
+        const SymState             &results);
+
+#endif /* H_GUARD_SYM_SUMMARY_H */
@@ -21,13 +21,16 @@
 
 #include <cl/cl_msg.hh>
 #include <cl/cldebug.hh>
+#include <cl/memdebug.hh>
 #include <cl/storage.hh>
 
+#include "glconf.hh"
 #include "plotenum.hh"
 #include "symstate.hh"
 #include "worklist.hh"
 
 #include <algorithm>
+#include <cstdio>
 #include <fstream>
 #include <map>
 #include <set>
@@ -36,6 +39,8 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/foreach.hpp>
 
+#include <unistd.h>                 // for getpid()
+
 namespace Trace {
 
 typedef const Node                                     *TNode;
@@ -81,13 +86,73 @@ bool hasDupChildren(const Node *node)
     return false;
 }
 
+MemCounter Node::cntNodes_("trace_nodes");
+size_t Node::lastId_;
+bool Node::streaming_;
+
+Node::Node():
+    idMapperList_(0),
+    id_(++lastId_),
+    nfa_(TIdMapper::NFA_TRAP_TO_DEBUGGER),
+    cntMaps_(0U),
+    alive_(true),
+    streamed_(false),
+    null_(false)
+{
+    cntNodes_.inc();
+}
+
+Node::Node(Node *ref):
+    NodeBase(ref),
+    idMapperList_(0),
+    id_(++lastId_),
+    nfa_(TIdMapper::NFA_TRAP_TO_DEBUGGER),
+    cntMaps_(1U),
+    alive_(true),
+    streamed_(false),
+    null_(false)
+{
+    ref->notifyBirth(this);
+    cntNodes_.inc();
+
+    if (streaming_)
+        ref->streamNode();
+}
+
+Node::Node(Node *ref1, Node *ref2):
+    NodeBase(ref1),
+    idMapperList_(0),
+    id_(++lastId_),
+    nfa_(TIdMapper::NFA_TRAP_TO_DEBUGGER),
+    cntMaps_(2U),
+    alive_(true),
+    streamed_(false),
+    null_(false)
+{
+    parents_.push_back(ref2);
+    ref1->notifyBirth(this);
+    ref2->notifyBirth(this);
+    cntNodes_.inc();
+
+    if (streaming_) {
+        ref1->streamNode();
+        ref2->streamNode();
+    }
+}
+
 Node::~Node()
 {
     alive_ = false;
+    delete idMapperList_;
+    cntNodes_.dec();
 }
 
 void Node::notifyBirth(NodeBase *child)
 {
+    if (null_)
+        // the null node is shared by all heaps, do not track its children
+        return;
+
     CL_BREAK_IF(hasDupChildren(this));
     children_.push_back(child);
     CL_BREAK_IF(hasDupChildren(this));
@@ -95,6 +160,9 @@ void Node::notifyBirth(NodeBase *child)
 
 void Node::notifyDeath(NodeBase *child)
 {
+    if (null_)
+        return;
+
     CL_BREAK_IF(hasDupChildren(this));
 
     // remove the dead child from the list
@@ -102,33 +170,89 @@ void Node::notifyDeath(NodeBase *child)
             std::remove(children_.begin(), children_.end(), child),
             children_.end());
 
-    if (alive_ && children_.empty())
-        // FIXME: this may cause stack overflow on complex trace graphs
-        delete this;
+    if (!alive_ || !children_.empty())
+        // still reachable from a live leaf
+        return;
+
+    if (streaming_)
+        // write the node before it is gone, if it has not been written yet
+        this->streamNode();
+
+    // FIXME: this may cause stack overflow on complex trace graphs
+    delete this;
+}
+
+/// ID mappings shared by all nodes that have not touched their own ones yet
+static const TIdMapperList& emptyIdMapperList(
+        const unsigned                      cntMaps,
+        const TIdMapper::ENotFoundAction    nfa)
+{
+    static TIdMapperList lists[/* cntMaps */ 3][/* nfa */ 3];
+    CL_BREAK_IF(2U < cntMaps);
+
+    TIdMapperList &list = lists[cntMaps][nfa];
+    if (list.size() != cntMaps)
+        list.resize(cntMaps, TIdMapper(nfa));
+
+    return list;
 }
 
 TIdMapperList& Node::idMapperList()
 {
-    CL_BREAK_IF(parents_.size() != idMapperList_.size());
-    return idMapperList_;
+    CL_BREAK_IF(!streamed_ && parents_.size() != cntMaps_);
+    if (!idMapperList_)
+        idMapperList_ = new TIdMapperList(cntMaps_, TIdMapper(nfa_));
+
+    return *idMapperList_;
 }
 
 const TIdMapperList& Node::idMapperList() const
 {
-    CL_BREAK_IF(parents_.size() != idMapperList_.size());
-    return idMapperList_;
+    CL_BREAK_IF(!streamed_ && parents_.size() != cntMaps_);
+    if (idMapperList_)
+        return *idMapperList_;
+
+    return emptyIdMapperList(cntMaps_, nfa_);
 }
 
 TIdMapper& Node::idMapper()
 {
-    CL_BREAK_IF(1U != this->idMapperList().size());
-    return idMapperList_.front();
+    CL_BREAK_IF(1U != cntMaps_);
+    return this->idMapperList().front();
 }
 
 const TIdMapper& Node::idMapper() const
 {
-    CL_BREAK_IF(1U != this->idMapperList().size());
-    return idMapperList_.front();
+    CL_BREAK_IF(1U != cntMaps_);
+    return this->idMapperList().front();
+}
+
+void Node::setNotFoundAction(TIdMapper::ENotFoundAction nfa)
+{
+    nfa_ = nfa;
+    if (!idMapperList_)
+        return;
+
+    BOOST_FOREACH(TIdMapper &idMapper, *idMapperList_)
+        idMapper.setNotFoundAction(nfa);
+}
+
+// /////////////////////////////////////////////////////////////////////////////
+// implementation of Trace::NullNode
+
+NullNode::NullNode():
+    cntLostTraces_(0)
+{
+    null_ = true;
+}
+
+NullNode* NullNode::instance()
+{
+    static NullNode *inst;
+    if (!inst)
+        inst = new NullNode;
+
+    return inst;
 }
 
 void replaceNode(Node *tr, Node *by)
@@ -299,12 +423,15 @@ std::string insnToBlock(const TInsn insn)
 // FIXME: copy-pasted from symplot.cc
 #define SL_QUOTE(what) "\"" << what << "\""
 
+// nodes are identified by their serial numbers, which survive streaming
+#define SL_NODE_ID(node) SL_QUOTE("tr" << (node)->id())
+
 #define INSN_LOC_AND_BB(insn, ptr) SL_QUOTE((insn)->loc << insnToBlock(insn) \
         << " (" << (ptr) << ")")
 
 void TransientNode::plotNode(TracePlotter &tplot) const
 {
-    tplot.out << "\t" << SL_QUOTE(this)
+    tplot.out << "\t" << SL_NODE_ID(this)
         << " [shape=box, color=red, fontcolor=red, label="
         << SL_QUOTE(origin_) << "];\n";
 }
@@ -314,17 +441,23 @@ void RootNode::plotNode(TracePlotter &tplot) const
     // TODO
     (void) rootFnc_;
 
-    tplot.out << "\t" << SL_QUOTE(this)
+    tplot.out << "\t" << SL_NODE_ID(this)
         << " [shape=circle, color=black, fontcolor=black, label=\"start\"];\n";
 }
 
+void NullNode::plotNode(TracePlotter &tplot) const
+{
+    tplot.out << "\t" << SL_NODE_ID(this)
+        << " [shape=circle, color=red, fontcolor=red, label=\"no trace\"];\n";
+}
+
 void InsnNode::plotNode(TracePlotter &tplot) const
 {
     const char *color = (isBuiltin_)
         ? "blue"
         : "black";
 
-    tplot.out << "\t" << SL_QUOTE(this)
+    tplot.out << "\t" << SL_NODE_ID(this)
         << " [shape=plaintext, fontname=monospace, fontcolor=" << color
         << ", label=" << SL_QUOTE(insnToLabel(insn_))
         << ", tooltip=" << INSN_LOC_AND_BB(insn_, this)
@@ -348,7 +481,7 @@ void AbstractionNode::plotNode(TracePlotter &tplot) const
             CL_BREAK_IF("unknown abstraction");
     }
 
-    tplot.out << "\t" << SL_QUOTE(this)
+    tplot.out << "\t" << SL_NODE_ID(this)
         << " [shape=ellipse, color=red, fontcolor=red, label="
         << SL_QUOTE(label) << ", tooltip="
         << SL_QUOTE(name_) << "];\n";
@@ -359,7 +492,7 @@ void ConcretizationNode::plotNode(TracePlotter &tplot) const
     // TODO
     (void) kind_;
 
-    tplot.out << "\t" << SL_QUOTE(this)
+    tplot.out << "\t" << SL_NODE_ID(this)
         << " [shape=ellipse, color=red, fontcolor=blue, label="
         << SL_QUOTE("concretizeObj()") << ", tooltip="
         << SL_QUOTE(name_) << "];\n";
@@ -368,7 +501,7 @@ void ConcretizationNode::plotNode(TracePlotter &tplot) const
 void SpliceOutNode::plotNode(TracePlotter &tplot) const
 {
     // TODO: kind_, successful_
-    tplot.out << "\t" << SL_QUOTE(this)
+    tplot.out << "\t" << SL_NODE_ID(this)
         << " [shape=ellipse, color=red, fontcolor=blue, label="
         << SL_QUOTE("spliceOut*(len = " << len_ << ")") << "];\n";
 }
@@ -397,7 +530,7 @@ void JoinNode::plotNode(TracePlotter &tplot) const
             break;
     }
 
-    tplot.out << "\t" << SL_QUOTE(this)
+    tplot.out << "\t" << SL_NODE_ID(this)
         << " [shape=circle, color=" << color
         << ", fontcolor=" << color
         << ", label=\"" << label << "\"];\n";
@@ -405,13 +538,13 @@ void JoinNode::plotNode(TracePlotter &tplot) const
 
 void CloneNode::plotNode(TracePlotter &tplot) const
 {
-    tplot.out << "\t" << SL_QUOTE(this) << " [shape=doubleoctagon, color=black"
+    tplot.out << "\t" << SL_NODE_ID(this) << " [shape=doubleoctagon, color=black"
         ", fontcolor=black, label=\"clone\"];\n";
 }
 
 void CallEntryNode::plotNode(TracePlotter &tplot) const
 {
-    tplot.out << "\t" << SL_QUOTE(this)
+    tplot.out << "\t" << SL_NODE_ID(this)
         << " [shape=box, fontname=monospace, color=blue, fontcolor=blue"
         ", penwidth=3.0, label=\"--> call entry: " << (insnToLabel(insn_))
         << "\", tooltip=\"" << insn_->loc << insn_->bb->name() << "\"];\n";
@@ -419,15 +552,23 @@ void CallEntryNode::plotNode(TracePlotter &tplot) const
 
 void CallCacheHitNode::plotNode(TracePlotter &tplot) const
 {
-    tplot.out << "\t" << SL_QUOTE(this)
+    tplot.out << "\t" << SL_NODE_ID(this)
         << " [shape=box, fontname=monospace, color=gold, fontcolor=blue"
         ", penwidth=3.0, label=\"(x) call cache hit: "
         << (nameOf(*fnc_)) << "()\"];\n";
 }
 
+void SummaryNode::plotNode(TracePlotter &tplot) const
+{
+    tplot.out << "\t" << SL_NODE_ID(this)
+        << " [shape=box, fontname=monospace, color=gold, fontcolor=blue"
+        ", penwidth=3.0, label=\"(s) function summary: "
+        << (nameOf(*fnc_)) << "()\"];\n";
+}
+
 void CallFrameNode::plotNode(TracePlotter &tplot) const
 {
-    tplot.out << "\t" << SL_QUOTE(this)
+    tplot.out << "\t" << SL_NODE_ID(this)
         << " [shape=box, fontname=monospace, color=blue, fontcolor=blue"
         ", label=\"--- call frame: " << (insnToLabel(insn_))
         << "\", tooltip=" << INSN_LOC_AND_BB(insn_, this) << "];\n";
@@ -435,7 +576,7 @@ void CallFrameNode::plotNode(TracePlotter &tplot) const
 
 void CallDoneNode::plotNode(TracePlotter &tplot) const
 {
-    tplot.out << "\t" << SL_QUOTE(this)
+    tplot.out << "\t" << SL_NODE_ID(this)
         << " [shape=box, fontname=monospace, color=blue, fontcolor=blue"
         ", penwidth=3.0, label=\"<-- call done: "
         << (nameOf(*fnc_)) << "()\"];\n";
@@ -443,13 +584,13 @@ void CallDoneNode::plotNode(TracePlotter &tplot) const
 
 void ImportGlVarNode::plotNode(TracePlotter &tplot) const
 {
-    tplot.out << "\t" << SL_QUOTE(this) << " [shape=ellipse, color=red"
+    tplot.out << "\t" << SL_NODE_ID(this) << " [shape=ellipse, color=red"
         ", fontcolor=red, label=\"importGlVar(" << varString_ << ")\"];\n";
 }
 
 void CondNode::plotNode(TracePlotter &tplot) const
 {
-    tplot.out << "\t" << SL_QUOTE(this) << " [shape=box, fontname=monospace"
+    tplot.out << "\t" << SL_NODE_ID(this) << " [shape=box, fontname=monospace"
         ", tooltip=" << INSN_LOC_AND_BB(inCnd_, this);
 
     if (determ_)
@@ -496,7 +637,7 @@ void MsgNode::plotNode(TracePlotter &tplot) const
             CL_BREAK_IF("unhandled EMsgLevel in MsgNode");
     }
 
-    tplot.out << "\t" << SL_QUOTE(this)
+    tplot.out << "\t" << SL_NODE_ID(this)
         << " [shape=tripleoctagon, fontcolor=monospace, color="
         << color << ", fontcolor=red, label="
         << SL_QUOTE((*loc_) << label) << "];\n";
@@ -507,7 +648,7 @@ void UserNode::plotNode(TracePlotter &tplot) const
     // TODO
     (void) insn_;
 
-    tplot.out << "\t" << SL_QUOTE(this) << " [shape=octagon, penwidth=3.0"
+    tplot.out << "\t" << SL_NODE_ID(this) << " [shape=octagon, penwidth=3.0"
         ", color=green, fontcolor=black, label=\"" << label_ << "\"];\n";
 }
 
@@ -533,8 +674,8 @@ void plotTraceCore(TracePlotter &tplot)
         if (!dst)
             continue;
 
-        tplot.out << "\t" << SL_QUOTE(src)
-            << " -> " << SL_QUOTE(dst)
+        tplot.out << "\t" << SL_NODE_ID(src)
+            << " -> " << SL_NODE_ID(dst)
             << " [color=" << ((!idx) ? "blue" : "black")
             << "];\n";
     }
@@ -589,24 +730,233 @@ bool plotTrace(Node *endPoint, const std::string &name, std::string *pName)
     return plotTrace(name, wl, pName);
 }
 
+// /////////////////////////////////////////////////////////////////////////////
+// implementation of Trace::openTraceStream()
+
+struct TraceStream {
+    std::string                         fileName;
+    FILE                               *file;
+    pid_t                               pid;
+
+    TraceStream():
+        file(0),
+        pid(0)
+    {
+    }
+};
+
+static TraceStream traceStream;
+
+/// tag of the comments carrying what printTrace() needs to know about a node
+static const std::string printTag("print");
+
+/// predecessor written for nodes where printTrace() stops
+static const std::string noPred("\"tr0\"");
+
+void Node::streamNode()
+{
+    if (streamed_)
+        return;
+
+    streamed_ = true;
+
+    // the parents have been streamed already, write the node and its in-edges
+    std::ostringstream str;
+    TWorkList wl;
+    TracePlotter tplot(str, wl);
+    this->plotNode(tplot);
+
+    const int cntParents = parents_.size();
+    for (int idx = 0; idx < cntParents; ++idx)
+        str << "\t" << SL_NODE_ID(parents_[idx])
+            << " -> " << SL_NODE_ID(this)
+            << " [color=" << ((!idx) ? "blue" : "black")
+            << "];\n";
+
+    // write what printTrace() needs as a comment ignored by dot
+    std::ostringstream note;
+    this->printNote(note);
+    std::string noteLine(note.str());
+    std::replace(noteLine.begin(), noteLine.end(), '\n', ' ');
+
+    const int idx = this->printIdx();
+    str << "\t// " << printTag << " " << SL_NODE_ID(this) << " ";
+    if (0 <= idx && idx < cntParents)
+        str << SL_NODE_ID(parents_[idx]);
+    else
+        str << noPred;
+    str << " " << noteLine << "\n";
+
+    const std::string &rec = str.str();
+    fwrite(rec.data(), 1U, rec.size(), traceStream.file);
+
+    // the node can be looked up in the stream now, keep only its ID in memory
+    delete idMapperList_;
+    idMapperList_ = 0;
+
+    const TNodeList parents = parents_;
+    parents_.clear();
+    BOOST_FOREACH(Node *parent, parents)
+        parent->notifyDeath(this);
+}
+
+/// read the lines of a file backwards, block by block
+class BackwardLineReader {
+    public:
+        BackwardLineReader(FILE *file):
+            file_(file),
+            pos_(0L)
+        {
+            if (!fseek(file_, 0L, SEEK_END))
+                pos_ = ftell(file_);
+        }
+
+        bool /* any line */ next(std::string *pLine);
+
+    private:
+        FILE                           *file_;
+        long                            pos_;
+        std::string                     buf_;
+};
+
+bool BackwardLineReader::next(std::string *pLine)
+{
+    for (;;) {
+        const size_t nl = buf_.rfind('\n');
+        if (std::string::npos != nl) {
+            // the last complete line in the buffer
+            *pLine = buf_.substr(nl + 1U);
+            buf_.resize(nl);
+            return true;
+        }
+
+        if (pos_ <= 0L) {
+            // the first line of the file
+            pLine->swap(buf_);
+            buf_.clear();
+            return !pLine->empty();
+        }
+
+        // read the preceding block
+        const long blockSize = 1L << 16;
+        const long len = std::min(pos_, blockSize);
+        pos_ -= len;
+        std::string block(len, '\0');
+        if (fseek(file_, pos_, SEEK_SET)
+                || len != static_cast<long>(fread(&block[0], 1U, len, file_)))
+            return false;
+
+        buf_.insert(0U, block);
+    }
+}
+
+/// print the trace leading to the given node from the stream written so far
+static bool printTraceFromStream(const size_t id)
+{
+    if (fflush(traceStream.file))
+        return false;
+
+    FILE *file = fopen(traceStream.fileName.c_str(), "r");
+    if (!file)
+        return false;
+
+    std::ostringstream str;
+    str << SL_QUOTE("tr" << id);
+    std::string lookFor(str.str());
+
+    // nodes are written after their predecessors, one backward pass will do
+    BackwardLineReader reader(file);
+    std::string line;
+    while (reader.next(&line)) {
+        std::istringstream rec(line);
+        std::string comment, tag, node, pred;
+        if (!(rec >> comment >> tag >> node >> pred)
+                || printTag != tag
+                || lookFor != node)
+            continue;
+
+        std::string note;
+        std::getline(rec >> std::ws, note);
+        if (!note.empty())
+            CL_MSG_STREAM(cl_note, note);
+
+        lookFor = pred;
+        if (noPred == pred)
+            break;
+    }
+
+    fclose(file);
+    return (noPred == lookFor);
+}
+
+bool openTraceStream(const std::string &fileName)
+{
+    closeTraceStream();
+
+    FILE *file = fopen(fileName.c_str(), "w");
+    if (!file) {
+        CL_ERROR("unable to create file '" << fileName << "'");
+        return false;
+    }
+
+    fprintf(file, "digraph \"%s\" {\n\tlabel=<<FONT POINT-SIZE=\"18\">"
+            "%s</FONT>>;\n\tlabelloc=t;\n",
+            fileName.c_str(), fileName.c_str());
+
+    traceStream.fileName    = fileName;
+    traceStream.file        = file;
+    traceStream.pid         = getpid();
+    Node::streaming_        = true;
+    return true;
+}
+
+void closeTraceStream()
+{
+    FILE *const file = traceStream.file;
+    if (!file)
+        return;
+
+    if (getpid() == traceStream.pid) {
+        // close the graph, the stream is not inherited from the parent process
+        fputs("}\n", file);
+        CL_NOTE("trace graph streamed to '" << traceStream.fileName << "'");
+    }
+
+    if (fclose(file))
+        CL_ERROR("unable to write file '" << traceStream.fileName << "'");
+
+    traceStream = TraceStream();
+    Node::streaming_ = false;
+}
+
 // /////////////////////////////////////////////////////////////////////////////
 // implementation of Trace::printTrace()
-Node* /* selected predecessor */ TransientNode::printNode() const
+Node* /* selected predecessor */ Node::printNode() const
 {
-    CL_BREAK_IF("please implement");
-    return this->parent();
+    std::ostringstream note;
+    this->printNote(note);
+    if (note.tellp())
+        CL_MSG_STREAM(cl_note, note.str());
+
+    const int idx = this->printIdx();
+    if (idx < 0)
+        // reaching this node means we are done with tracing!
+        return 0;
+
+    return parents_.at(idx);
 }
 
-Node* /* selected predecessor */ RootNode::printNode() const
+Node* /* selected predecessor */ TransientNode::printNode() const
 {
-    // reaching this node means we are done with tracing!
-    return 0;
+    CL_BREAK_IF("please implement");
+    return Node::printNode();
 }
 
-Node* /* selected predecessor */ InsnNode::printNode() const
+Node* /* selected predecessor */ NullNode::printNode() const
 {
-    // TODO: handle selected instructions here?
-    return this->parent();
+    CL_NOTE("the trace is not available, the trace graph has been disabled");
+    ++cntLostTraces_;
+    return 0;
 }
 
 Node* JoinNode::parent() const
@@ -623,43 +973,30 @@ Node* JoinNode::parent() const
     }
 }
 
-Node* /* selected predecessor */ JoinNode::printNode() const
-{
-    // FIXME: deal better with join nodes
-    return this->parents().front();
-}
-
 Node* /* selected predecessor */ CloneNode::printNode() const
 {
     CL_BREAK_IF("please implement");
-    return this->parent();
+    return Node::printNode();
 }
 
-Node* /* selected predecessor */ CallEntryNode::printNode() const
+void CallEntryNode::printNote(std::ostream &str) const
 {
-    CL_NOTE_MSG(&insn_->loc, "from call of " << (*insn_));
-    return this->parent();
+    str << insn_->loc << "note: from call of " << (*insn_);
 }
 
-Node* /* selected predecessor */ CallCacheHitNode::printNode() const
+void SummaryNode::printNote(std::ostream &str) const
 {
-    // follow the result, not the entry!
-    return this->parents().at(/* result */ 1);
+    str << *locationOf(*fnc_) << "note: the result of " << nameOf(*fnc_)
+        << "() has been loaded from a function summary";
 }
 
 Node* /* selected predecessor */ CallFrameNode::printNode() const
 {
     CL_BREAK_IF("please implement");
-    return this->parent();
-}
-
-Node* /* selected predecessor */ CallDoneNode::printNode() const
-{
-    // follow the call, not the frame!
-    return this->parents().front();
+    return Node::printNode();
 }
 
-Node* /* selected predecessor */ CondNode::printNode() const
+void CondNode::printNote(std::ostream &str) const
 {
     const char *action = (determ_)
         ? "evaluated as "
@@ -669,20 +1006,33 @@ Node* /* selected predecessor */ CondNode::printNode() const
         ? "TRUE"
         : "FALSE";
 
-    CL_NOTE_MSG(&inCmp_->loc, (*inCmp_) << " ... " << action << result);
-    return this->parent();
+    str << inCmp_->loc << "note: " << (*inCmp_) << " ... " << action << result;
 }
 
 Node* /* selected predecessor */ UserNode::printNode() const
 {
     CL_BREAK_IF("please implement");
-    return this->parent();
+    return Node::printNode();
 }
 
 void printTrace(Node *endPoint)
 {
-    while ((endPoint = endPoint->printNode()))
-        ;
+    if (!Node::streaming_ || endPoint->null_) {
+        Node *node = endPoint;
+        while ((node = node->printNode()))
+            ;
+
+        return;
+    }
+
+    // the predecessors of the end-point are available in the stream only
+    endPoint->streamNode();
+    if (!printTraceFromStream(endPoint->id()))
+        CL_ERROR("unable to read the trace from '" << traceStream.fileName
+                << "'");
+
+    CL_NOTE("the trace graph is being streamed to '" << traceStream.fileName
+            << "', see node tr" << endPoint->id());
 }
 
 // /////////////////////////////////////////////////////////////////////////////
@@ -712,7 +1062,12 @@ bool chkTraceGraphConsistency(Node *const from)
         plotTrace(from, "symtrace-CloneNode-reachable");
     }
 
-    if (!isNodeKindReachble<RootNode>(from)) {
+    if (!Node::streaming_
+            // the streamed nodes no longer know their predecessors
+            && !isNodeKindReachble<RootNode>(from)
+            && !isNodeKindReachble<SummaryNode>(from)
+            && !isNodeKindReachble<NullNode>(from))
+    {
         CL_ERROR("RootNode not reachable from the given trace graph node");
         plotTrace(from, "symtrace-RootNode-not-reachable");
         return false;
@@ -856,6 +1211,10 @@ Globals *Globals::inst_;
 
 void waiveCloneOperation(SymHeap &sh)
 {
+    if (GlConf::data.noTrace)
+        // no clone nodes are created if the trace graph is disabled
+        return;
+
     // just make sure the caller knows what is going on...
     Node *cnode = sh.traceNode();
     CL_BREAK_IF(!dynamic_cast<CloneNode *>(cnode));
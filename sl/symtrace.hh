@@ -27,11 +27,15 @@
 
 #include "config.h"
 
+#include "ent_pool.hh"
 #include "id_mapper.hh"
 #include "join_status.hh"
 #include "symbt.hh"                 // needed for EMsgLevel
 #include "symheap.hh"               // needed for EObjKind
 
+#include <cl/cl_msg.hh>
+#include <cl/memdebug.hh>           // needed for MemCounter
+
 #include <vector>
 #include <string>
 
@@ -55,7 +59,62 @@ typedef const struct cl_loc                        *TLoc;
 typedef const CodeStorage::Fnc                     *TFnc;
 typedef const CodeStorage::Insn                    *TInsn;
 
-typedef std::vector<Node *>                         TNodeList;
+/// list of (0..2) parent nodes, kept inline as no node has more parents
+class ParentList {
+    public:
+        typedef Node                       *value_type;
+        typedef Node                      **iterator;
+        typedef Node *const                *const_iterator;
+        typedef Node                      *&reference;
+        typedef Node *const                &const_reference;
+
+        ParentList():
+            cnt_(0U)
+        {
+        }
+
+        explicit ParentList(Node *node):
+            cnt_(1U)
+        {
+            slots_[0] = node;
+        }
+
+        size_t size()                   const { return cnt_;            }
+        bool empty()                    const { return !cnt_;           }
+
+        iterator begin()                      { return slots_;          }
+        iterator end()                        { return slots_ + cnt_;   }
+        const_iterator begin()          const { return slots_;          }
+        const_iterator end()            const { return slots_ + cnt_;   }
+
+        reference front()                     { return slots_[0];       }
+        const_reference front()         const { return slots_[0];       }
+
+        reference operator[](size_t idx)      { return slots_[idx];     }
+        const_reference operator[](size_t idx) const { return slots_[idx]; }
+
+        const_reference at(size_t idx) const {
+            CL_BREAK_IF(cnt_ <= idx);
+            return slots_[idx];
+        }
+
+        void push_back(Node *node) {
+            CL_BREAK_IF(MAX_PARENTS <= cnt_);
+            slots_[cnt_++] = node;
+        }
+
+        void clear() {
+            cnt_ = 0U;
+        }
+
+    private:
+        enum { MAX_PARENTS = 2 };
+
+        Node                   *slots_[MAX_PARENTS];
+        unsigned char           cnt_;
+};
+
+typedef ParentList                                  TNodeList;
 
 // TODO: should we use a more generic ID type?
 typedef IdMapper<TObjId, OBJ_INVALID, OBJ_MAX_ID>   TIdMapper;
@@ -74,7 +133,7 @@ class NodeBase {
 
         /// construct Node with exactly one parent, can be extended later
         NodeBase(Node *node):
-            parents_(1, node)
+            parents_(node)
         {
         }
 
@@ -104,33 +163,17 @@ class Node: public NodeBase {
 
         friend class NodeBase;
         friend class NodeHandle;
+        friend class NullNode;
 
     protected:
         /// this is an abstract class, its instantiation is @b not allowed
-        Node():
-            alive_(true)
-        {
-        }
+        Node();
 
         /// constructor for nodes with exactly one parent
-        Node(Node *ref):
-            NodeBase(ref),
-            alive_(true)
-        {
-            idMapperList_.resize(1U);
-            ref->notifyBirth(this);
-        }
+        Node(Node *ref);
 
         /// constructor for nodes with exactly two parents
-        Node(Node *ref1, Node *ref2):
-            NodeBase(ref1),
-            alive_(true)
-        {
-            parents_.push_back(ref2);
-            idMapperList_.resize(2U);
-            ref1->notifyBirth(this);
-            ref2->notifyBirth(this);
-        }
+        Node(Node *ref1, Node *ref2);
 
         virtual ~Node();
 
@@ -140,6 +183,16 @@ class Node: public NodeBase {
         friend void plotTraceCore(TracePlotter &);
 
     public:
+#if SH_ENT_POOL
+        static void* operator new(size_t size) {
+            return EntPoolSet::alloc(size);
+        }
+
+        // the size of the dynamic type is given thanks to virtual destructor
+        static void operator delete(void *ptr, size_t size) {
+            EntPoolSet::release(ptr, size);
+        }
+#endif
         /// used to store a list of child nodes
         typedef std::vector<NodeBase *> TBaseList;
 
@@ -147,9 +200,16 @@ class Node: public NodeBase {
         const TBaseList& children() const { return children_; }
 
         /// print the node in a human-readable format if considered interesting
-        virtual Node* /* selected predecessor */ printNode() const {
-            return this->parent();
-        }
+        virtual Node* /* selected predecessor */ printNode() const;
+
+        /// write the message printed by printNode() (if any) to the given stream
+        virtual void printNote(std::ostream &) const { }
+
+        /// index of the predecessor selected by printNode(), -1 if there is none
+        virtual int printIdx() const { return 0; }
+
+        /// serial number of the node, unique within a run of the analysis
+        size_t id() const { return id_; }
 
     public:
         /// return the ID mapping describing the operation behind the trace node
@@ -164,17 +224,45 @@ class Node: public NodeBase {
         /// return the ID mapping describing the operation behind the trace node
         const TIdMapper& idMapper() const;
 
+        /// set the action taken by all ID mappings of the node on a missing ID
+        void setNotFoundAction(TIdMapper::ENotFoundAction);
+
     private:
         // copying NOT allowed
         Node(const Node &);
         Node& operator=(const Node &);
 
-    protected:
-        TIdMapperList idMapperList_;
+        void initNode(unsigned cntParents);
+        void streamNode();
+
+        friend bool openTraceStream(const std::string &);
+        friend void closeTraceStream();
+        friend void printTrace(Node *);
+        friend bool chkTraceGraphConsistency(Node *);
 
     private:
-        TBaseList children_;
-        bool alive_;
+        TBaseList                   children_;
+
+        /// ID mappings are allocated on the first non-const access only
+        TIdMapperList              *idMapperList_;
+
+        size_t                      id_;
+        TIdMapper::ENotFoundAction  nfa_;
+        unsigned char               cntMaps_;
+        bool                        alive_;
+        bool                        streamed_;
+        bool                        null_;
+
+        /// count of live nodes, sampled by printMemUsage()
+        static MemCounter cntNodes_;
+
+        /// the last serial number assigned to a node
+        static size_t lastId_;
+
+        /// true if nodes are written to a file as they get their first child
+        /// or as they are released, whichever comes first.  A node written
+        /// to the file drops its parents and ID mappings, only its ID is kept.
+        static bool streaming_;
 };
 
 void replaceNode(Node *tr, Node *by);
@@ -241,10 +329,32 @@ class RootNode: public Node {
         {
         }
 
+        virtual int printIdx() const { return -1; }
+
+    protected:
+        void virtual plotNode(TracePlotter &) const;
+};
+
+/// the only node of the trace graph if it is disabled (see SE_NO_TRACE)
+class NullNode: public Node {
+    public:
+        /// shared by all heaps, its children are not tracked, never released
+        static NullNode* instance();
+
+        /// count of traces that could not be printed by printTrace()
+        int cntLostTraces() const { return cntLostTraces_; }
+
         virtual Node* printNode() const;
 
+        virtual int printIdx() const { return -1; }
+
     protected:
         void virtual plotNode(TracePlotter &) const;
+
+    private:
+        NullNode();
+
+        mutable int cntLostTraces_;
 };
 
 /// a trace graph node that represents a non-terminal instruction
@@ -264,11 +374,9 @@ class InsnNode: public Node {
             insn_(insn),
             isBuiltin_(isBuiltin)
         {
-            this->idMapper().setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
+            this->setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
         }
 
-        virtual Node* printNode() const;
-
     protected:
         void virtual plotNode(TracePlotter &) const;
 };
@@ -296,10 +404,10 @@ class CondNode: public Node {
             determ_(determ),
             branch_(branch)
         {
-            this->idMapper().setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
+            this->setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
         }
 
-        virtual Node* printNode() const;
+        virtual void printNote(std::ostream &) const;
 
     protected:
         void virtual plotNode(TracePlotter &) const;
@@ -368,7 +476,7 @@ class SpliceOutNode: public Node {
             Node(ref),
             len_(len)
         {
-            this->idMapper().setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
+            this->setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
         }
 
     protected:
@@ -383,14 +491,11 @@ class JoinNode: public Node {
             Node(ref1, ref2),
             status_(status)
         {
-            idMapperList_[0].setNotFoundAction(TIdMapper::NFA_RETURN_NOTHING);
-            idMapperList_[1].setNotFoundAction(TIdMapper::NFA_RETURN_NOTHING);
+            this->setNotFoundAction(TIdMapper::NFA_RETURN_NOTHING);
         }
 
         virtual Node* parent() const;
 
-        virtual Node* printNode() const;
-
     protected:
         void virtual plotNode(TracePlotter &) const;
 
@@ -428,7 +533,7 @@ class CallEntryNode: public Node {
         {
         }
 
-        virtual Node* printNode() const;
+        virtual void printNote(std::ostream &) const;
 
     protected:
         void virtual plotNode(TracePlotter &) const;
@@ -451,7 +556,29 @@ class CallCacheHitNode: public Node {
         {
         }
 
-        virtual Node* printNode() const;
+        /// follow the result, not the entry
+        virtual int printIdx() const { return /* result */ 1; }
+
+    protected:
+        void virtual plotNode(TracePlotter &) const;
+};
+
+/// trace graph node representing a call result loaded from a fnc summary
+class SummaryNode: public Node {
+    private:
+        const TFnc fnc_;
+
+    public:
+        /// @param fnc a CodeStorage::Fnc object representing the called fnc
+        SummaryNode(const TFnc fnc):
+            fnc_(fnc)
+        {
+        }
+
+        /// the trace of the call has not been kept, stop here
+        virtual int printIdx() const { return -1; }
+
+        virtual void printNote(std::ostream &) const;
 
     protected:
         void virtual plotNode(TracePlotter &) const;
@@ -506,8 +633,6 @@ class CallDoneNode: public Node {
         {
         }
 
-        virtual Node* printNode() const;
-
     protected:
         void virtual plotNode(TracePlotter &) const;
 };
@@ -549,7 +674,7 @@ class MsgNode: public Node {
             level_(level),
             loc_(loc)
         {
-            this->idMapper().setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
+            this->setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
         }
 
     protected:
@@ -573,7 +698,7 @@ class UserNode: public Node {
             insn_(insn),
             label_(label)
         {
-            this->idMapper().setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
+            this->setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
         }
 
         virtual Node* printNode() const;
@@ -591,6 +716,20 @@ bool plotTrace(Node *endPoint, const std::string &name, std::string *pName = 0);
 /// print a human-readable trace using the Code Listener messaging API
 void printTrace(Node *endPoint);
 
+/**
+ * write trace graph nodes to the given dot file as soon as they get their first
+ * child or are released.  A node written to the file keeps only its ID in
+ * memory, so the trace graph held in memory does not grow with the length of
+ * the traces.  printTrace() reads the traces back from the file, the trace
+ * leading to any node can be rebuilt from the file by sl/trace-by-id.sh.
+ * @note not compatible with cyclic trace graphs and the fixed-point store
+ * @note plotTrace() plots only the part of the trace graph kept in memory
+ */
+bool openTraceStream(const std::string &fileName);
+
+/// close the stream opened by openTraceStream(), if any
+void closeTraceStream();
+
 /// this runs in the debug build only
 bool chkTraceGraphConsistency(Node *const from);
 
@@ -0,0 +1,70 @@
+#!/bin/bash
+export SELF="$0"
+
+export LC_ALL=C
+
+die() {
+    printf "%s: %s\n" "$SELF" "$*" >&2
+    exit 1
+}
+
+usage() {
+    printf "Usage: %s TRACE_STREAM.dot NODE_ID\n\n" "$SELF" >&2
+    printf "Rebuild the trace leading to the given node (e.g. tr1234) of \
+a trace graph\nstreamed by Predator with -fplugin-arg-libsl-args=\
+trace_stream:FILE, print it\nas a dot graph to stdout.\n" >&2
+    exit 1
+}
+
+test 2 = "$#" || usage
+
+STREAM="$1"
+test -r "$STREAM" || die "unable to read file '$STREAM'"
+
+# accept both 1234 and tr1234
+NODE="tr${2#tr}"
+test "tr" != "$NODE" || usage
+
+# the stream consists of one line per node, one line per in-edge of a node and
+# one comment line per node read by Predator itself, each node is written after
+# all its parents and each in-edge along with its target node, so one pass from
+# the end of the file is sufficient
+tac "$STREAM" | awk -v node="\"$NODE\"" -v name="$STREAM: $NODE" '
+BEGIN {
+    want[node] = 1
+    n = 0
+}
+
+# an in-edge: "trA" -> "trB" [...];
+$2 == "->" {
+    if ($3 in want) {
+        want[$1] = 1
+        out[n++] = $0
+    }
+    next
+}
+
+# a node: "trA" [...];
+$1 ~ /^"tr[0-9]+"$/ {
+    if ($1 in want) {
+        found[$1] = 1
+        out[n++] = $0
+    }
+}
+
+END {
+    if (!(node in found)) {
+        printf "node %s not found in the stream\n", node > "/dev/stderr"
+        exit 1
+    }
+
+    printf "digraph \"%s\" {\n", name
+    printf "\tlabel=<<FONT POINT-SIZE=\"18\">%s</FONT>>;\n", name
+    printf "\tlabelloc=t;\n"
+
+    # restore the original order, so that the root comes first
+    for (i = n - 1; 0 <= i; --i)
+        print out[i]
+
+    printf "}\n"
+}'
@@ -0,0 +1,16 @@
+#include <stdlib.h>
+
+/* no main(), so that both functions are analyzed as virtual roots */
+
+void leak(void)
+{
+    void *p = malloc(sizeof(int));
+    (void) p;
+}
+
+void double_free(void)
+{
+    void *p = malloc(sizeof(int));
+    free(p);
+    free(p);
+}
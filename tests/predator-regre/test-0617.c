@@ -0,0 +1,16 @@
+#include <stdlib.h>
+
+static void release(void *p)
+{
+    free(p);
+}
+
+int main()
+{
+    void *p = malloc(sizeof(int));
+    release(p);
+
+    /* the trace of the double free leads through both calls of release() */
+    release(p);
+    return 0;
+}
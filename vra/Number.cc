@@ -40,6 +40,14 @@ namespace {
 		return out.str();
 	}
 
+	/**
+	* @brief Returns @c true if @a width is a bit width of a C integral type.
+	*/
+	bool isIntegralWidth(unsigned width) {
+		return sizeof(char) == width || sizeof(short) == width ||
+			sizeof(int) == width || sizeof(long) == width;
+	}
+
 }
 
 /**
@@ -50,9 +58,21 @@ namespace {
 * @param[in] sign Boolean flag specifies if the type is signed or unsigned.
 */
 Number::Number(Int value, unsigned width, bool sign)
+		:type(INT), intValue(intToWide(value)), sign(sign), bitWidth(width)
+{
+	fitIntoBitWidth();
+}
+
+/**
+* @brief Constructs a new number from integral value without involving GMP.
+*
+* @param[in] value Instance of this class will represent this @a value.
+* @param[in] width Bit width of the type that was used to store @a value.
+* @param[in] sign Boolean flag specifies if the type is signed or unsigned.
+*/
+Number::Number(Wide value, unsigned width, bool sign)
 		:type(INT), intValue(value), sign(sign), bitWidth(width)
 {
-	setIntLimits();
 	fitIntoBitWidth();
 }
 
@@ -100,16 +120,16 @@ Number Number::assign(const Number &n) const
 			//  inf      -2147483648
 			//  nan      -2147483648
 			if (n.isNotNumber() ||
-					n.floatValue < intToFloat(minIntLimit, isSigned()) ||
-					n.floatValue > intToFloat(maxIntLimit, isSigned())) {
-				result.intValue = minIntLimit;
+					n.floatValue < wideToFloat(minIntLimit(), isSigned()) ||
+					n.floatValue > wideToFloat(maxIntLimit(), isSigned())) {
+				result.intValue = minIntLimit();
 			} else {
-				result.intValue = floatToInt(n.floatValue);
+				result.intValue = intToWide(floatToInt(n.floatValue));
 			}
 		}
 	} else if (result.isFloatingPoint()) {
 		if (n.isIntegral()) {
-			result.floatValue = intToFloat(n.intValue, n.isSigned());
+			result.floatValue = wideToFloat(n.intValue, n.isSigned());
 		} else if (n.isFloatingPoint()) {
 			result.floatValue = n.floatValue;
 		}
@@ -119,62 +139,33 @@ Number Number::assign(const Number &n) const
 }
 
 /**
-* @brief Sets limits of an integral number.
+* @brief Returns minimal value that can be stored in an integral number.
+*
+* The limit is derived from the bit width and the sign of the number.
 */
-void Number::setIntLimits()
+Number::Wide Number::minIntLimit() const
 {
-	// According to the bitWidth finds out which type was used to store
-	// the value and computes the suitable limits.
-	if (sizeof(char) == bitWidth) {
-		// Signed char.
-		if (isSigned()) {
-			minIntLimit = numeric_limits<signed char>::min();
-			maxIntLimit = numeric_limits<signed char>::max();
-		}
-		// Unsigned char.
-		else {
-			minIntLimit = numeric_limits<unsigned char>::min();
-			maxIntLimit = numeric_limits<unsigned char>::max();
-		}
-	} else if (sizeof(short) == bitWidth) {
-		// Signed short int.
-		if (isSigned()) {
-			minIntLimit = numeric_limits<signed short>::min();
-			maxIntLimit = numeric_limits<signed short>::max();
-		}
-		// Unsigned short int.
-		else {
-			minIntLimit = numeric_limits<unsigned short>::min();
-			maxIntLimit = numeric_limits<unsigned short>::max();
-		}
-	} else if (sizeof(int) == bitWidth) {
-		// Signed int.
-		if (isSigned()) {
-			minIntLimit = numeric_limits<signed int>::min();
-			maxIntLimit = numeric_limits<signed int>::max();
-		}
-		// Unsigned int.
-		else {
-			minIntLimit = numeric_limits<unsigned int>::min();
-			maxIntLimit = numeric_limits<unsigned int>::max();
-		}
-	} else if (sizeof(long) == bitWidth) {
-		// Signed long int.
-		if (isSigned()) {
-			minIntLimit = numeric_limits<signed long>::min();
-			maxIntLimit = numeric_limits<signed long>::max();
-		}
-		// Unsigned long int.
-		else {
-			minIntLimit = numeric_limits<unsigned long>::min();
-			maxIntLimit = numeric_limits<unsigned long>::max();
-		}
-	} else {
-		std::cerr << bitWidth << "\n";
-		// This should never happen.
-		assert(!"Provided bit width of the number does not correspond to bit"
-			   "width of any integral type.");
-	}
+	assert(isIntegralWidth(bitWidth) &&
+		"Provided bit width of the number does not correspond to bit"
+		"width of any integral type.");
+	if (!isSigned())
+		return 0;
+	return -(Wide(1) << (getNumOfBits() - 1));
+}
+
+/**
+* @brief Returns maximal value that can be stored in an integral number.
+*
+* The limit is derived from the bit width and the sign of the number.
+*/
+Number::Wide Number::maxIntLimit() const
+{
+	assert(isIntegralWidth(bitWidth) &&
+		"Provided bit width of the number does not correspond to bit"
+		"width of any integral type.");
+	if (!isSigned())
+		return (Wide(1) << getNumOfBits()) - 1;
+	return (Wide(1) << (getNumOfBits() - 1)) - 1;
 }
 
 /**
@@ -289,7 +280,7 @@ bool Number::isPositiveInf() const
 */
 bool Number::isNotNumber() const
 {
-	return isFloatingPoint() && isnan(floatValue);
+	return isFloatingPoint() && std::isnan(floatValue);
 }
 
 /**
@@ -307,7 +298,7 @@ bool Number::isNumber() const
 */
 bool Number::isMin() const {
 	if (isIntegral()) {
-		return intValue == minIntLimit;
+		return intValue == minIntLimit();
 	} else { // isFloatingPoint()
 		return floatValue == minFloatLimit;
 	}
@@ -319,7 +310,7 @@ bool Number::isMin() const {
 */
 bool Number::isMax() const {
 	if (isIntegral()) {
-		return intValue == maxIntLimit;
+		return intValue == maxIntLimit();
 	} else { // isFloatingPoint()
 		return floatValue == maxFloatLimit;
 	}
@@ -351,7 +342,7 @@ Number Number::getEpsilon() const {
 Number Number::getMin() const
 {
 	if (isIntegral()) {
-		return Number(minIntLimit, bitWidth, isSigned());
+		return Number(minIntLimit(), bitWidth, isSigned());
 	} else { // isFloatingPoint()
 		return Number(minFloatLimit, bitWidth);
 	}
@@ -363,7 +354,7 @@ Number Number::getMin() const
 Number Number::getMax() const
 {
 	if (isIntegral()) {
-		return Number(maxIntLimit, bitWidth, isSigned());
+		return Number(maxIntLimit(), bitWidth, isSigned());
 	} else { // isFloatingPoint()
 		return Number(maxFloatLimit, bitWidth);
 	}
@@ -402,7 +393,7 @@ Number Number::getNegativeInf() const
 Number::Int Number::getInt() const
 {
 	assert(isIntegral());
-	return intValue;
+	return wideToInt(intValue);
 }
 
 /**
@@ -451,7 +442,6 @@ void Number::integralPromotion()
 	if (bitWidth < sizeof(int)) {
 		bitWidth = sizeof(int);
 		sign = true;
-		setIntLimits();
 	}
 }
 
@@ -462,11 +452,8 @@ void Number::integralPromotion()
 */
 void Number::convertSignedToUnsigned()
 {
-	if (intValue < 0) {
-		Int max = maxIntLimit + 1;
-		Int tmp = -(intValue / max) + 1;
-		intValue = intValue + tmp * max;
-	}
+	if (intValue < 0)
+		intValue += Wide(1) << getNumOfBits();
 }
 
 /**
@@ -516,7 +503,7 @@ pair<Number,Number> Number::extensionByCRules(Number first, Number second)
 		// the other operand is converted, without change of type domain, to a type
 		// whose corresponding real type is float.
 		if (second.isIntegral())
-			second.floatValue = intToFloat(second.intValue, second.isSigned());
+			second.floatValue = wideToFloat(second.intValue, second.isSigned());
 		second.type = first.type;
 		second.bitWidth = first.bitWidth;
 		second.setFloatLimits();
@@ -531,7 +518,6 @@ pair<Number,Number> Number::extensionByCRules(Number first, Number second)
 			// with greater rank.
 			if (first.bitWidth > second.bitWidth) {
 				second.bitWidth = first.bitWidth;
-				second.setIntLimits();
 			}
 		} else if (first.isUnsigned() && second.isSigned()) {
 			// Otherwise, if the operand that has unsigned integer type has rank
@@ -540,7 +526,6 @@ pair<Number,Number> Number::extensionByCRules(Number first, Number second)
 			// type of the operand with unsigned integer type.
 			second.bitWidth = first.bitWidth;
 			second.sign = false;
-			second.setIntLimits();
 			second.convertSignedToUnsigned();
 		} else if (first.isSigned() && second.isUnsigned()) {
 			// Otherwise, if the type of the operand with signed integer type
@@ -551,13 +536,11 @@ pair<Number,Number> Number::extensionByCRules(Number first, Number second)
 			if (first.bitWidth > second.bitWidth) {
 				second.bitWidth = first.bitWidth;
 				second.sign = true;
-				second.setIntLimits();
 			} else if (first.bitWidth == second.bitWidth) {
 				// Otherwise, both operands are converted to the unsigned
 				// integer type corresponding to the type of the operand with
 				// signed integer type.
 				first.sign = false;
-				first.setIntLimits();
 				first.convertSignedToUnsigned();
 			}
 		}
@@ -602,6 +585,58 @@ Number::Float Number::intToFloat(const Int &n, bool isSigned) {
 	}
 }
 
+/**
+* @brief Converts the given integer into the native representation.
+*
+* Values that do not fit are reduced modulo 2^N, where N is the number of bits
+* of @c unsigned @c long. This does not change the result of fitIntoBitWidth().
+*/
+Number::Wide Number::intToWide(const Int &n) {
+	if (n.fits_slong_p())
+		return n.get_si();
+	if (n.fits_ulong_p())
+		return n.get_ui();
+
+	Int low;
+	mpz_fdiv_r_2exp(low.get_mpz_t(), n.get_mpz_t(),
+		sizeof(unsigned long) * CHAR_BIT);
+	return low.get_ui();
+}
+
+/**
+* @brief Converts the given native integer into @c Int.
+*/
+Number::Int Number::wideToInt(Wide n) {
+	if (n >= numeric_limits<long>::min() && n <= numeric_limits<long>::max())
+		return Int(static_cast<long>(n));
+	if (n >= 0 && n <= numeric_limits<unsigned long>::max())
+		return Int(static_cast<unsigned long>(n));
+
+	// Compose the value from 32-bit chunks of its absolute value.
+	const bool isNegative = n < 0;
+	const UWide u = isNegative ? -static_cast<UWide>(n) : static_cast<UWide>(n);
+	Int result;
+	for (int shift = 96; shift >= 0; shift -= 32) {
+		result <<= 32;
+		result += static_cast<unsigned long>((u >> shift) & 0xffffffffUL);
+	}
+	return isNegative ? Int(-result) : result;
+}
+
+/**
+* @brief Converts the given native integer into a floating-point number.
+*
+* @param n Integer to be converted.
+* @param isSigned @c true if the integer is signed, @c false otherwise.
+*/
+Number::Float Number::wideToFloat(Wide n, bool isSigned) {
+	if (isSigned) {
+		return Float(static_cast<long>(n));
+	} else {
+		return Float(static_cast<unsigned long>(n));
+	}
+}
+
 /**
 * @brief According to the type of the number, converts its value to the predefined
 *        limits.
@@ -609,18 +644,14 @@ Number::Float Number::intToFloat(const Int &n, bool isSigned) {
 void Number::fitIntoBitWidth()
 {
 	if (isIntegral()) {
-		if (isSigned()) {
-			Int valuesInBitWidth = 2 * maxIntLimit + 2;
-			intValue -= minIntLimit;
-			if (intValue < 0) {
-				intValue += (-intValue / valuesInBitWidth + 1) * valuesInBitWidth;
-			}
-			intValue %= valuesInBitWidth;
-			intValue += minIntLimit;
-		} else {
-			convertSignedToUnsigned();
-			intValue = intValue % (maxIntLimit + 1);
-		}
+		// Two's complement wrap-around, i.e. the value modulo 2^N where N is
+		// the number of bits.
+		const UWide valuesInBitWidth = UWide(1) << getNumOfBits();
+		const UWide value = static_cast<UWide>(intValue) & (valuesInBitWidth - 1);
+		if (value > static_cast<UWide>(maxIntLimit()))
+			intValue = static_cast<Wide>(value) - static_cast<Wide>(valuesInBitWidth);
+		else
+			intValue = static_cast<Wide>(value);
 	} else if (isFloatingPoint()) {
 		if (floatValue > maxFloatLimit)
 			floatValue = INFINITY;
@@ -852,7 +883,7 @@ Number operator+(const Number& op1, const Number& op2)
 	Number &n2 = r.second;
 
 	if (n1.isIntegral() && n2.isIntegral()) {
-		Number::Int newValue = n1.intValue + n2.intValue;
+		Number::Wide newValue = n1.intValue + n2.intValue;
 		Number result(newValue, n1.bitWidth, n1.sign);
 		result.fitIntoBitWidth();
 		return result;
@@ -901,7 +932,7 @@ Number operator-(const Number& op1, const Number& op2)
 	Number &n2 = r.second;
 
 	if (n1.isIntegral() && n2.isIntegral()) {
-		Number::Int newValue = n1.intValue - n2.intValue;
+		Number::Wide newValue = n1.intValue - n2.intValue;
 		Number result(newValue, n1.bitWidth, n1.sign);
 		result.fitIntoBitWidth();
 		return result;
@@ -950,7 +981,13 @@ Number operator*(const Number& op1, const Number& op2)
 	Number &n2 = r.second;
 
 	if (n1.isIntegral() && n2.isIntegral()) {
-		Number::Int newValue = n1.intValue * n2.intValue;
+		Number::Wide newValue;
+		if (__builtin_mul_overflow(n1.intValue, n2.intValue, &newValue)) {
+			// The product of two unsigned longs may not fit, use GMP.
+			Number::Int product = Number::wideToInt(n1.intValue) *
+				Number::wideToInt(n2.intValue);
+			return Number(product, n1.bitWidth, n1.sign);
+		}
 		Number result(newValue, n1.bitWidth, n1.sign);
 		result.fitIntoBitWidth();
 		return result;
@@ -1031,7 +1068,7 @@ Number exact_div(const Number& op1, const Number& op2)
 	Number &n1 = r.first;
 	Number &n2 = r.second;
 
-	Number::Int newValue = n1.intValue / n2.intValue;
+	Number::Wide newValue = n1.intValue / n2.intValue;
 	Number result(newValue, n1.bitWidth, n1.sign);
 	result.fitIntoBitWidth();
 
@@ -1061,12 +1098,12 @@ Number Number::performTrunc(const Number &op1, const Number& op2, bool isMod)
 	Number &n2 = r.second;
 
 	// Performs operation on the C integral type.
-	Number::Int res;
+	Number::Wide res = 0;
 	if ((sizeof(int) == n1.bitWidth)) {
 		if (n1.isSigned()) {
 			int oper1, oper2;
-			oper1 = mpz_get_si(n1.intValue.get_mpz_t());
-			oper2 = mpz_get_si(n2.intValue.get_mpz_t());
+			oper1 = static_cast<long>(n1.intValue);
+			oper2 = static_cast<long>(n2.intValue);
 			if (isMod) {
 				// Computes modulo.
 				res = oper1 % oper2;
@@ -1076,8 +1113,8 @@ Number Number::performTrunc(const Number &op1, const Number& op2, bool isMod)
 			}
 		} else {
 			unsigned oper1, oper2;
-			oper1 = mpz_get_ui(n1.intValue.get_mpz_t());
-			oper2 = mpz_get_ui(n2.intValue.get_mpz_t());
+			oper1 = static_cast<unsigned long>(n1.intValue);
+			oper2 = static_cast<unsigned long>(n2.intValue);
 			if (isMod) {
 				// Computes modulo.
 				res = oper1 % oper2;
@@ -1089,8 +1126,8 @@ Number Number::performTrunc(const Number &op1, const Number& op2, bool isMod)
 	} else if ((sizeof(long) == n1.bitWidth)) {
 		if (n1.isSigned()) {
 			long oper1, oper2;
-			oper1 = mpz_get_si(n1.intValue.get_mpz_t());
-			oper2 = mpz_get_si(n2.intValue.get_mpz_t());
+			oper1 = static_cast<long>(n1.intValue);
+			oper2 = static_cast<long>(n2.intValue);
 			if (isMod) {
 				// Computes modulo.
 				res = oper1 % oper2;
@@ -1100,8 +1137,8 @@ Number Number::performTrunc(const Number &op1, const Number& op2, bool isMod)
 			}
 		} else {
 			unsigned long oper1, oper2;
-			oper1 = mpz_get_ui(n1.intValue.get_mpz_t());
-			oper2 = mpz_get_ui(n2.intValue.get_mpz_t());
+			oper1 = static_cast<unsigned long>(n1.intValue);
+			oper2 = static_cast<unsigned long>(n2.intValue);
 			if (isMod) {
 				// Computes modulo.
 				res = oper1 % oper2;
@@ -1200,8 +1237,7 @@ Number bitNot(const Number& op)
 
 	Number promotedOp = op;
 	promotedOp.integralPromotion();
-	Number::Int result;
-	mpz_com(result.get_mpz_t(), promotedOp.intValue.get_mpz_t());
+	Number::Wide result = ~promotedOp.intValue;
 
 	return Number(result, promotedOp.bitWidth, promotedOp.sign);
 }
@@ -1228,24 +1264,21 @@ Number Number::performBitOp(const Number &op1, const Number &op2, char mode)
 	Number &n1 = r.first;
 	Number &n2 = r.second;
 
-	Number::Int res;
+	Number::Wide res = 0;
 	switch (mode) {
 		case 'A':
 			// Performs bit and.
-			mpz_and(res.get_mpz_t(), n1.intValue.get_mpz_t(),
-					n2.intValue.get_mpz_t());
+			res = n1.intValue & n2.intValue;
 			break;
 
 		case 'O':
 			// Performs bit or.
-			mpz_ior(res.get_mpz_t(), n1.intValue.get_mpz_t(),
-					n2.intValue.get_mpz_t());
+			res = n1.intValue | n2.intValue;
 			break;
 
 		case 'X':
 			// Performs bit xor.
-			mpz_xor(res.get_mpz_t(), n1.intValue.get_mpz_t(),
-					n2.intValue.get_mpz_t());
+			res = n1.intValue ^ n2.intValue;
 			break;
 	}
 
@@ -1298,31 +1331,30 @@ Number Number::performShift(Number op1, Number op2, bool isLeft)
 	// is used in the Range class. It must be after integralPromotion()!
 	assert(op1.bitWidth * CHAR_BIT > op2.intValue);
 
-	// Shift are not defined for Int, so we have to use left shift from C.
-	// We have to store Int values into C types.
-	Number::Int res;
+	// Shifts are performed by the C types of the operands.
+	Number::Wide res = 0;
 	if ((sizeof(int) == op1.bitWidth)) {
 		if (op1.isSigned()) {
 			int signedOP1, signedOP2;
-			signedOP1 = mpz_get_si(op1.intValue.get_mpz_t());
-			signedOP2 = mpz_get_si(op2.intValue.get_mpz_t());
+			signedOP1 = static_cast<long>(op1.intValue);
+			signedOP2 = static_cast<long>(op2.intValue);
 			res = isLeft ? (signedOP1 << signedOP2) : (signedOP1 >> signedOP2);
 		} else {
 			unsigned signedOP1, signedOP2;
-			signedOP1 = mpz_get_ui(op1.intValue.get_mpz_t());
-			signedOP2 = mpz_get_ui(op2.intValue.get_mpz_t());
+			signedOP1 = static_cast<unsigned long>(op1.intValue);
+			signedOP2 = static_cast<unsigned long>(op2.intValue);
 			res = isLeft ? (signedOP1 << signedOP2) : (signedOP1 >> signedOP2);
 		}
 	} else if ((sizeof(long) == op1.bitWidth)) {
 		if (op1.isSigned()) {
 			long signedOP1, signedOP2;
-			signedOP1 = mpz_get_si(op1.intValue.get_mpz_t());
-			signedOP2 = mpz_get_si(op2.intValue.get_mpz_t());
+			signedOP1 = static_cast<long>(op1.intValue);
+			signedOP2 = static_cast<long>(op2.intValue);
 			res = isLeft ? (signedOP1 << signedOP2) : (signedOP1 >> signedOP2);
 		} else {
 			unsigned long signedOP1, signedOP2;
-			signedOP1 = mpz_get_ui(op1.intValue.get_mpz_t());
-			signedOP2 = mpz_get_ui(op2.intValue.get_mpz_t());
+			signedOP1 = static_cast<unsigned long>(op1.intValue);
+			signedOP2 = static_cast<unsigned long>(op2.intValue);
 			res = isLeft ? (signedOP1 << signedOP2) : (signedOP1 >> signedOP2);
 		}
 	}
@@ -1382,9 +1414,9 @@ Number intToFloat(const Number& op)
 {
 	assert(op.isIntegral());
 	if (op.sign) {
-		return Number((float) mpz_get_si(op.intValue.get_mpz_t()), sizeof(float));
+		return Number((float) static_cast<long>(op.intValue), sizeof(float));
 	} else {
-		return Number((float) mpz_get_ui(op.intValue.get_mpz_t()), sizeof(float));
+		return Number((float) static_cast<unsigned long>(op.intValue), sizeof(float));
 	}
 }
 
@@ -1428,7 +1460,7 @@ Number max(const Number &op1, const Number &op2)
 ostream& operator<<(ostream &os, const Number &n)
 {
 	if (n.isIntegral())
-		os << n.intValue;
+		os << Number::wideToInt(n.intValue);
 	else if (n.isFloatingPoint()) {
 		os << n.floatValue;
 	}
@@ -34,14 +34,23 @@ class Number {
 		/// Biggest integer.
 		typedef mpz_class Int;
 
+		/// Native integer that can hold any value of a C integral type, both
+		/// signed and unsigned, and the results of arithmetic operations on
+		/// such values (except multiplication, which is checked for overflow).
+		__extension__ typedef __int128 Wide;
+
+		/// Unsigned counterpart of @c Wide.
+		__extension__ typedef unsigned __int128 UWide;
+
 		/// Biggest float.
 		typedef long double Float;
 
 		/// Type of the stored number.
 		Type type;
 
-		/// Value of the number if @c type of the number is @c INT.
-		Int intValue;
+		/// Value of the number if @c type of the number is @c INT. GMP is used
+		/// only when converting from/to @c Int and on overflow.
+		Wide intValue;
 
 		/// Value of the number if @c type of the number is @c FLOAT.
 		Float floatValue;
@@ -53,14 +62,6 @@ class Number {
 		/// Bit width of the represented number.
 		unsigned bitWidth;
 
-		/// Minimal value that can be stored in the number. It is used only if
-		/// @c type of the number is @c INT.
-		Int minIntLimit;
-
-		/// Maximal value that can be stored in the number. It is used only if
-		/// @c type of the number is @c INT.
-		Int maxIntLimit;
-
 		/// Minimal value that can be stored in the number. It is used only if
 		/// @c type of the number is @c FLOAT.
 		Float minFloatLimit;
@@ -69,7 +70,8 @@ class Number {
 		/// @c type of the number is @c FLOAT.
 		Float maxFloatLimit;
 
-		void setIntLimits();
+		Wide minIntLimit() const;
+		Wide maxIntLimit() const;
 		void setFloatLimits();
 		void fitIntoBitWidth();
 		void integralPromotion();
@@ -79,8 +81,13 @@ class Number {
 		static Number performBitOp(const Number &op1, const Number &op2, char mode);
 		static Number performShift(Number op1, Number op2, bool isLeft);
 
+		static Wide intToWide(const Int &n);
+		static Int wideToInt(Wide n);
+		static Float wideToFloat(Wide n, bool isSigned);
+
 	public:
 		Number(Int value, unsigned width, bool sign);
+		Number(Wide value, unsigned width, bool sign);
 		Number(Float value, unsigned width);
 
 		Number assign(const Number &n) const;
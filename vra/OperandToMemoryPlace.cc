@@ -11,6 +11,7 @@
 #include <string>
 #include <cassert>
 #include <iostream>
+#include <pthread.h>
 #include "OperandToMemoryPlace.h"
 
 using std::string;
@@ -21,6 +22,44 @@ using std::deque;
 map<OperandToMemoryPlace::UidVector, MemoryPlace*>
 	OperandToMemoryPlace::memoryPlaceMap;
 
+namespace {
+
+/// Guards @c memoryPlaceMap, functions may be analysed in parallel threads.
+pthread_mutex_t memoryPlaceMapLock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+* @brief Holds @c memoryPlaceMapLock for the lifetime of the object.
+*/
+class MemoryPlaceMapGuard {
+	public:
+		MemoryPlaceMapGuard()  { pthread_mutex_lock(&memoryPlaceMapLock); }
+		~MemoryPlaceMapGuard() { pthread_mutex_unlock(&memoryPlaceMapLock); }
+};
+
+}
+
+/**
+* @brief Returns the memory place identified by @a uidVector. If there is no such
+*        memory place yet, it is created from @a name and @a artificial.
+*/
+MemoryPlace* OperandToMemoryPlace::lookup(const UidVector &uidVector,
+										  const string &name, bool artificial)
+{
+	MemoryPlaceMapGuard guard;
+
+	map<UidVector, MemoryPlace*>::const_iterator it =
+		OperandToMemoryPlace::memoryPlaceMap.find(uidVector);
+	if (it != OperandToMemoryPlace::memoryPlaceMap.end()) {
+		// This variable was used before. We return found record.
+		return it->second;
+	}
+
+	// This variable is used for the first time.
+	MemoryPlace *var = new MemoryPlace(name, artificial);
+	OperandToMemoryPlace::memoryPlaceMap[uidVector] = var;
+	return var;
+}
+
 /**
 * @brief Converts @c cl_operand to the instance of the @c MemoryPlace class. Used only
 *        for simple variables, elements of array, items of structures.
@@ -61,15 +100,7 @@ MemoryPlace* OperandToMemoryPlace::convertSimpleOperand(const cl_operand *operan
 
 	if (NULL == operand->accessor) {
 		// If the given cl_operand represents a simple variable.
-		if (OperandToMemoryPlace::memoryPlaceMap.count(uidVector) == 0) {
-			// This variable is used for the first time.
-			MemoryPlace *var = new MemoryPlace(name, artificial);
-			OperandToMemoryPlace::memoryPlaceMap[uidVector] = var;
-			return var;
-		} else {
-			// This variable was used before. We return found record.
-			return OperandToMemoryPlace::memoryPlaceMap[uidVector];
-		}
+		return OperandToMemoryPlace::lookup(uidVector, name, artificial);
 	} else if (CL_ACCESSOR_ITEM == (operand->accessor)->code ||
 			   CL_ACCESSOR_DEREF_ARRAY == (operand->accessor)->code) {
 		// If the given cl_operand represents an item of a structure or
@@ -92,15 +123,7 @@ MemoryPlace* OperandToMemoryPlace::convertSimpleOperand(const cl_operand *operan
 			actualAccessor = actualAccessor->next;
 		}
 
-		if (OperandToMemoryPlace::memoryPlaceMap.count(uidVector) == 0) {
-			// This variable is used for the first time.
-			MemoryPlace *var = new MemoryPlace(name, artificial);
-			OperandToMemoryPlace::memoryPlaceMap[uidVector] = var;
-			return var;
-		} else {
-			// This variable was used before. We return found record.
-			return OperandToMemoryPlace::memoryPlaceMap[uidVector];
-		}
+		return OperandToMemoryPlace::lookup(uidVector, name, artificial);
 	}
 
 	assert(!"Memory place cannot be created for the provided cl_operand.");
@@ -176,15 +199,7 @@ MemoryPlace* OperandToMemoryPlace::convert(const cl_operand *operand,
 		currentType = ((currentType->items)[index]).type;
 	}
 
-	if (OperandToMemoryPlace::memoryPlaceMap.count(uidVector) == 0) {
-		// This variable is used for the first time.
-		MemoryPlace *var = new MemoryPlace(name, artificial);
-		OperandToMemoryPlace::memoryPlaceMap[uidVector] = var;
-		return var;
-	} else {
-		// This variable was used before. We return found record.
-		return OperandToMemoryPlace::memoryPlaceMap[uidVector];
-	}
+	return OperandToMemoryPlace::lookup(uidVector, name, artificial);
 
 	assert(!"Memory places does not created for provided cl_operand.");
 	return new MemoryPlace("", true);
@@ -195,5 +210,6 @@ MemoryPlace* OperandToMemoryPlace::convert(const cl_operand *operand,
 */
 void OperandToMemoryPlace::init()
 {
+	MemoryPlaceMapGuard guard;
 	OperandToMemoryPlace::memoryPlaceMap.clear();
 }
@@ -11,6 +11,7 @@
 #include <vector>
 #include <map>
 #include <deque>
+#include <string>
 #include <cl/code_listener.h>
 #include <gmpxx.h>
 #include "MemoryPlace.h"
@@ -37,6 +38,9 @@ class OperandToMemoryPlace {
 
 		static MemoryPlace* convertSimpleOperand(const cl_operand *operand);
 
+		static MemoryPlace* lookup(const UidVector &uidVector,
+								   const std::string &name, bool artificial);
+
 	public:
 		static MemoryPlace* convert(const cl_operand *operand,
 									std::deque<int> indexes = std::deque<int>());
@@ -12,7 +12,10 @@
 #include <iostream>
 #include <cassert>
 #include <iterator>
+#include <sstream>
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include "Utility.h"
 #include "ValueAnalysis.h"
@@ -35,13 +38,7 @@ using std::deque;
 using std::sort;
 using std::pair;
 
-ValueAnalysis::BlockToTrimmedRangesMap ValueAnalysis::blockToTrimmedRangesMap;
-ValueAnalysis::BlockToResultMap ValueAnalysis::blockToInputRangesMap;
-ValueAnalysis::BlockToResultMap ValueAnalysis::blockToOutputRangesMap;
-ValueAnalysis::SchedulerQueue ValueAnalysis::todoQueue;
-ValueAnalysis::SchedulerSet ValueAnalysis::todoSet;
-ValueAnalysis::BlockToCounterMap ValueAnalysis::blockToCounterMap;
-LoopFinder::BlockToUpperLimit ValueAnalysis::tripCountOfBlockMap;
+ValueAnalysis::FncToAnalysisMap ValueAnalysis::analysisOfFnc;
 
 const unsigned ValueAnalysis::NumberOfPassesBeforeExpand = 1000;
 
@@ -49,12 +46,22 @@ namespace {
 
 /**
 * @brief Sorts memory places information alphabetically according to the names of
-*        variables stored in memory places.
+*        variables stored in memory places. Places of the same name are sorted
+*        by their ranges, so the order does not depend on the addresses of memory
+*        places (they are allocated by several threads).
 */
 bool sortBlockInfo(const ValueAnalysis::MemoryPlaceRangePair &f,
 				   const ValueAnalysis::MemoryPlaceRangePair &s)
 {
-	return f.first->asString() < s.first->asString();
+	const string fName = f.first->asString();
+	const string sName = s.first->asString();
+	if (fName != sName)
+		return fName < sName;
+
+	std::ostringstream fRange, sRange;
+	fRange << f.second;
+	sRange << s.second;
+	return fRange.str() < sRange.str();
 }
 
 }
@@ -64,11 +71,7 @@ bool sortBlockInfo(const ValueAnalysis::MemoryPlaceRangePair &f,
 *        nothing. Otherwise, it inserts @a block into schedulers.
 */
 void ValueAnalysis::scheduleBlock(const Block *block) {
-	if (todoSet.find(block) == todoSet.end()) {
-		// If block was not scheduled, we schedule it.
-		todoQueue.push(block);
-		todoSet.insert(block);
-	}
+	todo.schedule(block);
 }
 
 /**
@@ -396,23 +399,82 @@ bool ValueAnalysis::containOnlyGotoInsn(const Block *block)
 	return false;
 }
 
+/**
+* @brief Keeps the finished @a analysis for printing. A previous analysis of the
+*        same function is released.
+*/
+void ValueAnalysis::storeAnalysis(AnalysisPtr analysis)
+{
+	const Fnc *pFnc = &analysis->fnc;
+	analysisOfFnc[pFnc] = std::move(analysis);
+}
+
 /**
 * @brief Computes value-range analysis for the given @a fnc.
 */
 void ValueAnalysis::computeAnalysisForFnc(const Fnc &fnc)
+{
+	AnalysisPtr analysis(new ValueAnalysis(fnc));
+	analysis->compute();
+	ValueAnalysis::storeAnalysis(std::move(analysis));
+}
+
+/**
+* @brief Computes value-range analysis for all defined functions of @a stor.
+*
+* Each function is analysed by its own instance of @c ValueAnalysis, so up to
+* @a jobs functions are analysed in parallel threads. The results are stored
+* once all threads are finished, thus the output of @c printRanges() does not
+* depend on the number of threads.
+*/
+void ValueAnalysis::computeAnalysis(const Storage &stor, unsigned jobs)
+{
+	vector<AnalysisPtr> todo;
+	BOOST_FOREACH(const Fnc* pFnc, stor.fncs) {
+		if (isDefined(*pFnc))
+			todo.push_back(AnalysisPtr(new ValueAnalysis(*pFnc)));
+	}
+
+	if (jobs > todo.size())
+		jobs = todo.size();
+
+	if (jobs <= 1) {
+		BOOST_FOREACH(AnalysisPtr &analysis, todo)
+			analysis->compute();
+	} else {
+		// Functions are picked by the threads one by one, since their sizes
+		// differ a lot.
+		std::atomic<size_t> next(0);
+		vector<std::thread> workers;
+		for (unsigned i = 0; i < jobs; ++i) {
+			workers.push_back(std::thread([&todo, &next]() {
+				for (size_t idx = next++; idx < todo.size(); idx = next++)
+					todo[idx]->compute();
+			}));
+		}
+
+		BOOST_FOREACH(std::thread &worker, workers)
+			worker.join();
+	}
+
+	BOOST_FOREACH(AnalysisPtr &analysis, todo)
+		ValueAnalysis::storeAnalysis(std::move(analysis));
+}
+
+/**
+* @brief Computes value-range analysis for the function of this instance.
+*/
+void ValueAnalysis::compute()
 {
 	const Block *entryBlock = fnc.cfg.entry();
 
 	// Sets the ranges for global variables for the input of the entry block.
 	blockToInputRangesMap[entryBlock] = GlobAnalysis::getGlobVarMap();
 
-	todoQueue.push(entryBlock);
-	todoSet.insert(entryBlock);
+	todo.schedule(entryBlock);
 
-	while (!todoQueue.empty()) {
-		const Block *block = todoQueue.front();
-		todoQueue.pop();
-		todoSet.erase(block);
+	const Block *block;
+	while (todo.next(block)) {
 
 		MemoryPlaceToRangeMap oldResult = ValueAnalysis::getRanges(block,
 			blockToOutputRangesMap);
@@ -1046,72 +1108,114 @@ ostream& ValueAnalysis::printRanges(ostream &os, const Storage &stor)
 {
 	BOOST_FOREACH(const Fnc* pFnc, stor.callGraph.topOrder) {
 		// Iterates over all functions.
-		const Fnc &fnc = *pFnc;
-		if (!isDefined(fnc))
+		if (!isDefined(*pFnc))
 			continue;
 
-		string delimeter(10, '-');
-		os << delimeter << " Function " << nameOf(fnc) << "() ";
-		os << delimeter << endl;
-
-		BOOST_FOREACH(const Block* pBlock, fnc.cfg) {
-			// Iterates over all blocks.
-			const Block &block = *pBlock;
-			int firstLine = ((block.front())->loc).line;
-			int lastLine = ((block.back())->loc).line;
+		FncToAnalysisMap::const_iterator it = analysisOfFnc.find(pFnc);
+		if (it != analysisOfFnc.end()) {
+			it->second->printRangesOfFnc(os);
+		} else {
+			// The function was not analysed, its blocks are printed empty.
+			ValueAnalysis(*pFnc).printRangesOfFnc(os);
+		}
+	}
+	return os;
+}
 
-			if (firstLine > lastLine) {
-				std::swap(firstLine, lastLine);
-			}
+/**
+* @brief Emits the result of analysis of the function of this instance
+*        into @a os.
+*/
+ostream& ValueAnalysis::printRangesOfFnc(ostream &os) const
+{
+	string delimeter(10, '-');
+	os << delimeter << " Function " << nameOf(fnc) << "() ";
+	os << delimeter << endl;
+
+	BOOST_FOREACH(const Block* pBlock, fnc.cfg) {
+		// Iterates over all blocks.
+		const Block &block = *pBlock;
+		int firstLine = ((block.front())->loc).line;
+		int lastLine = ((block.back())->loc).line;
+
+		if (firstLine > lastLine) {
+			std::swap(firstLine, lastLine);
+		}
 
-			// Prints input ranges.
-			os << "Block " << block.name() << "[IN]" << " at lines from ";
-			os << firstLine << " to ";
-			os << lastLine << ":" << endl;
+		// Prints input ranges.
+		os << "Block " << block.name() << "[IN]" << " at lines from ";
+		os << firstLine << " to ";
+		os << lastLine << ":" << endl;
 
-			// Gets the result of analysis for the currently processed block.
-			MemoryPlaceToRangeMap &blockInfo = blockToInputRangesMap[pBlock];
-			vector<MemoryPlaceRangePair> sortedBlockInfo(
-				blockInfo.begin(), blockInfo.end());
+		// Gets the result of analysis for the currently processed block.
+		MemoryPlaceToRangeMap blockInfo = ValueAnalysis::getRanges(pBlock,
+			blockToInputRangesMap);
+		vector<MemoryPlaceRangePair> sortedBlockInfo(
+			blockInfo.begin(), blockInfo.end());
 
-			sort(sortedBlockInfo.begin(), sortedBlockInfo.end(),
-				sortBlockInfo);
+		sort(sortedBlockInfo.begin(), sortedBlockInfo.end(),
+			sortBlockInfo);
 
-			BOOST_FOREACH(MemoryPlaceRangePair &mem, sortedBlockInfo) {
-				// Iterates over all memory places in the block.
-				if ((mem.first)->isArtificial())
-					continue;
+		BOOST_FOREACH(MemoryPlaceRangePair &mem, sortedBlockInfo) {
+			// Iterates over all memory places in the block.
+			if ((mem.first)->isArtificial())
+				continue;
 
-				// User variables and corresponding ranges in block are printed.
-				os << "\t" << (mem.first)->asString();
-				os << " = " << mem.second;
-			}
+			// User variables and corresponding ranges in block are printed.
+			os << "\t" << (mem.first)->asString();
+			os << " = " << mem.second;
+		}
 
-			// Prints output ranges.
-			os << "Block " << block.name() << "[OUT]:" << endl;
+		// Prints output ranges.
+		os << "Block " << block.name() << "[OUT]:" << endl;
 
-			// Gets the result of analysis for the currently processed block.
-			MemoryPlaceToRangeMap &blockInfoOut = blockToOutputRangesMap[pBlock];
-			vector<MemoryPlaceRangePair> sortedBlockInfoOut(
-				blockInfoOut.begin(), blockInfoOut.end());
+		// Gets the result of analysis for the currently processed block.
+		MemoryPlaceToRangeMap blockInfoOut = ValueAnalysis::getRanges(pBlock,
+			blockToOutputRangesMap);
+		vector<MemoryPlaceRangePair> sortedBlockInfoOut(
+			blockInfoOut.begin(), blockInfoOut.end());
 
-			sort(sortedBlockInfoOut.begin(), sortedBlockInfoOut.end(),
-				sortBlockInfo);
+		sort(sortedBlockInfoOut.begin(), sortedBlockInfoOut.end(),
+			sortBlockInfo);
 
-			BOOST_FOREACH(MemoryPlaceRangePair &mem, sortedBlockInfoOut) {
-				// Iterates over all memory places in the block.
-				if ((mem.first)->isArtificial())
-					continue;
+		BOOST_FOREACH(MemoryPlaceRangePair &mem, sortedBlockInfoOut) {
+			// Iterates over all memory places in the block.
+			if ((mem.first)->isArtificial())
+				continue;
 
-				// User variables and corresponding ranges in block are printed.
-				os << "\t" << (mem.first)->asString();
-				os << " = " << mem.second;
-			}
+			// User variables and corresponding ranges in block are printed.
+			os << "\t" << (mem.first)->asString();
+			os << " = " << mem.second;
 		}
 	}
 	return os;
 }
 
+/**
+* @brief Emits the number of block visits needed by the analysis of each
+*        function of @a stor into @a os.
+*/
+ostream& ValueAnalysis::printStats(ostream &os, const Storage &stor)
+{
+	BOOST_FOREACH(const Fnc* pFnc, stor.callGraph.topOrder) {
+		FncToAnalysisMap::const_iterator it = analysisOfFnc.find(pFnc);
+		if (it != analysisOfFnc.end())
+			it->second->printStatsOfFnc(os);
+	}
+	return os;
+}
+
+/**
+* @brief Emits the number of block visits needed by the analysis of the function
+*        of this instance into @a os.
+*/
+ostream& ValueAnalysis::printStatsOfFnc(ostream &os) const
+{
+	os << "Function " << nameOf(fnc) << "(): " << todo.cntVisits();
+	os << " visits of " << todo.cntBlocksVisited() << " blocks" << endl;
+	return os;
+}
+
 /**
 * @brief Joins data that was gained from the analysis of several blocks.
 *
@@ -13,10 +13,9 @@
 
 #include <ostream>
 #include <map>
+#include <memory>
 #include <utility>
 #include <vector>
-#include <set>
-#include <queue>
 
 #include "Range.h"
 #include "MemoryPlace.h"
@@ -39,12 +38,12 @@ class ValueAnalysis {
 		typedef std::pair<const MemoryPlace*, Range> MemoryPlaceRangePair;
 
 	private:
-		/// Just for assurance that nobody will try to use it.
-		ValueAnalysis() { }
+		/// Function this instance of the analysis is computed for.
+		const CodeStorage::Fnc &fnc;
 
 		/// Stores maximal number of passes through the block or zero if we do
 		/// not know.
-		static LoopFinder::BlockToUpperLimit tripCountOfBlockMap;
+		LoopFinder::BlockToUpperLimit tripCountOfBlockMap;
 
 		/// Type for representing key into map that stores trimmed ranges.
 		struct TrimmedKey {
@@ -94,43 +93,48 @@ class ValueAnalysis {
 		typedef std::map<const CodeStorage::Block*, MemoryPlaceToRangeMap>
 			BlockToResultMap;
 
-		/// Type for representing scheduler.
-		typedef std::queue<const CodeStorage::Block *> SchedulerQueue;
-
-		/// Type for representing scheduler.
-		typedef std::set<const CodeStorage::Block *> SchedulerSet;
-
 		/// Type for representing block counter.
 		typedef std::map<const CodeStorage::Block *, unsigned> BlockToCounterMap;
 
+		/// Type for owning an instance of the analysis.
+		typedef std::unique_ptr<ValueAnalysis> AnalysisPtr;
+
+		/// Type for storing the finished analysis of each function.
+		typedef std::map<const CodeStorage::Fnc *, AnalysisPtr> FncToAnalysisMap;
+
 		/// Mapping block to the trimmed ranges of this block.
-		static BlockToTrimmedRangesMap blockToTrimmedRangesMap;
+		BlockToTrimmedRangesMap blockToTrimmedRangesMap;
 
 		/// Mapping block to the input ranges of this block.
-		static BlockToResultMap blockToInputRangesMap;
+		BlockToResultMap blockToInputRangesMap;
 
 		/// Mapping block to the output ranges of this block.
-		static BlockToResultMap blockToOutputRangesMap;
+		BlockToResultMap blockToOutputRangesMap;
 
-		/// Block scheduler.
-		static SchedulerQueue todoQueue;
-
-		/// Block scheduler.
-		static SchedulerSet todoSet;
+		/// Block scheduler, blocks are taken in weak topological order.
+		CodeStorage::WtoScheduler todo;
 
 		/// Specifies how many times the block is executed before the expansion
 		/// of changing ranges will be performed.
 		static const unsigned NumberOfPassesBeforeExpand;
 
 		/// Stores how many times was the block executed.
-		static BlockToCounterMap blockToCounterMap;
+		BlockToCounterMap blockToCounterMap;
+
+		/// Finished analyses of all analysed functions.
+		static FncToAnalysisMap analysisOfFnc;
+
+		ValueAnalysis(const ValueAnalysis &);
+		ValueAnalysis& operator=(const ValueAnalysis &);
+
+		static void storeAnalysis(AnalysisPtr analysis);
 
-		static void scheduleBlock(const CodeStorage::Block *block);
+		void scheduleBlock(const CodeStorage::Block *block);
 
 		static MemoryPlaceToRangeMap getRanges(const CodeStorage::Block* block,
 											   const BlockToResultMap &inputMap);
 
-		static TrimmedRangesMap getTrimmedRanges(const CodeStorage::Block* block);
+		TrimmedRangesMap getTrimmedRanges(const CodeStorage::Block* block);
 
 		static MemoryPlaceToRangeMap join(const MemoryPlaceToRangeMapVector &vec);
 
@@ -139,21 +143,21 @@ class ValueAnalysis {
 											const MemoryPlaceToRangeMap &out,
 											const TrimmedRangesMap &trimmed);
 
-		static void computeInputRanges(const CodeStorage::Block *current);
+		void computeInputRanges(const CodeStorage::Block *current);
 
-		static void expandChangingRanges(const CodeStorage::Block *block,
-										 const MemoryPlaceToRangeMap &oldResult,
-										 const MemoryPlaceToRangeMap &newResult);
+		void expandChangingRanges(const CodeStorage::Block *block,
+								  const MemoryPlaceToRangeMap &oldResult,
+								  const MemoryPlaceToRangeMap &newResult);
 
-		static void computeAnalysisForBlock(const CodeStorage::Block *block);
+		void computeAnalysisForBlock(const CodeStorage::Block *block);
 
-		static void computeAnalysisForInsn(const CodeStorage::Insn *insn,
-										   const CodeStorage::Insn *prevInsn,
-										   MemoryPlaceToRangeMap &output);
+		void computeAnalysisForInsn(const CodeStorage::Insn *insn,
+									const CodeStorage::Insn *prevInsn,
+									MemoryPlaceToRangeMap &output);
 
-		static void computeAnalysisForCond(const CodeStorage::Insn *insn,
-										   const CodeStorage::Insn *prevInsn,
-										   MemoryPlaceToRangeMap &output);
+		void computeAnalysisForCond(const CodeStorage::Insn *insn,
+									const CodeStorage::Insn *prevInsn,
+									MemoryPlaceToRangeMap &output);
 
 		static void computeAnalysisForUnop(const CodeStorage::Insn *insn,
 										   MemoryPlaceToRangeMap &output);
@@ -195,11 +199,26 @@ class ValueAnalysis {
 			const enum cl_binop_e code);
 
 	public:
+		/// Creates an empty analysis of the given @a fnc.
+		explicit ValueAnalysis(const CodeStorage::Fnc &fnc):
+			fnc(fnc), todo(fnc.cfg) {}
+
+		void compute();
+
+		std::ostream& printRangesOfFnc(std::ostream &os) const;
+
+		std::ostream& printStatsOfFnc(std::ostream &os) const;
 
 		static std::ostream& printRanges(std::ostream &os,
 										 const CodeStorage::Storage &stor);
 
+		static std::ostream& printStats(std::ostream &os,
+										const CodeStorage::Storage &stor);
+
 		static void computeAnalysisForFnc(const CodeStorage::Fnc &fnc);
+
+		static void computeAnalysis(const CodeStorage::Storage &stor,
+									unsigned jobs = 1);
 };
 
 #endif
@@ -642,6 +642,23 @@ GetIntOfIntegralNumberWorksCorrectly)
 	EXPECT_EQ(mpz_class(vmin<int>()), (I<int>(vmin<int>())).getInt());
 }
 
+TEST_F(NumberTest,
+GetIntOfUnsignedLongLimitsWorksCorrectly)
+{
+	EXPECT_EQ(mpz_class(vmax<unsigned long>()),
+		(I<unsigned long>(vmax<unsigned long>())).getInt());
+	EXPECT_EQ(mpz_class(vmin<long>()), (I<long>(vmin<long>())).getInt());
+}
+
+TEST_F(NumberTest,
+ConstructionFromIntThatDoesNotFitInto64BitsWrapsAround)
+{
+	mpz_class big(vmax<unsigned long>());
+	big = big * big + 5;
+	EXPECT_EQ(I<unsigned long>(6), Number(big, sizeof(long), false));
+	EXPECT_EQ(I<long>(-6), Number(-big, sizeof(long), true));
+}
+
 TEST_F(NumberTest,
 GetIntOfFloatingPointNumberWorksCorrectly)
 {
@@ -1517,6 +1534,16 @@ MultiplicationOfTwoUnsignedIntsWorksCorrectlyWhenOverflowOccurs)
 		I<unsigned>(vmax<unsigned>()) * I<unsigned>(vmax<unsigned>()));
 }
 
+TEST_F(NumberTest,
+MultiplicationOfTwoUnsignedLongsWorksCorrectlyWhenOverflowOccurs)
+{
+	EXPECT_EQ(I<unsigned long>(1),
+		I<unsigned long>(vmax<unsigned long>()) *
+		I<unsigned long>(vmax<unsigned long>()));
+	EXPECT_EQ(I<long>(1),
+		I<long>(vmin<long>() + 1) * I<long>(vmin<long>() + 1));
+}
+
 TEST_F(NumberTest,
 MultiplicationOfUnsignedIntAndFloatWorksCorrectly)
 {
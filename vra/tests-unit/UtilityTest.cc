@@ -333,6 +333,7 @@ GetMaxRangeWithSpecifiedIndexesForNestedStructureWorksCorrecly)
 	op1.data.var->name = "q";
 	op1.data.var->artificial = false;
 	op1.code = CL_OPERAND_VAR;
+	op1.accessor = NULL;
 	op1.type = new struct cl_type;
 	op1.type->code = CL_TYPE_STRUCT;
 	op1.type->items = new struct cl_type_item[1];
@@ -8,7 +8,11 @@
 #undef NDEBUG   // It is necessary for using assertions.
 
 #include <iostream>
+#include <string>
+#include <vector>
+#include <boost/algorithm/string.hpp>
 #include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
 #include <cl/easy.hh>
 
 #include "ValueAnalysis.h"
@@ -20,10 +24,56 @@ extern "C" {
     __attribute__ ((__visibility__ ("default"))) int plugin_is_GPL_compatible;
 }
 
-using CodeStorage::Fnc;
 using CodeStorage::Storage;
 
-void clEasyRun(const Storage &stor, const char *)
+namespace {
+
+/// Options of the analyzer given by the plug-in arguments.
+struct VraConf {
+	/// Number of threads analysing functions in parallel.
+	unsigned jobs;
+
+	/// If true, the number of block visits per function is printed.
+	bool printStats;
+
+	VraConf(): jobs(1), printStats(false) {}
+};
+
+/**
+* @brief Parses the given @a configString (options are separated by ';'). It
+*        understands "jobs:N" and "stats".
+*/
+VraConf parseConfig(const char *configString)
+{
+	VraConf conf;
+	if (configString == NULL)
+		return conf;
+
+	std::vector<std::string> args;
+	boost::split(args, configString, boost::is_any_of(";"));
+	BOOST_FOREACH(const std::string &arg, args) {
+		if (arg == "stats") {
+			conf.printStats = true;
+		} else if (boost::starts_with(arg, "jobs:")) {
+			try {
+				const int jobs =
+					boost::lexical_cast<int>(arg.substr(sizeof "jobs:" - 1));
+				conf.jobs = (jobs < 1) ? 1 : jobs;
+			}
+			catch (...) {
+				std::cerr << "vra: ignoring invalid option \"" << arg << "\"\n";
+			}
+		} else if (!arg.empty()) {
+			std::cerr << "vra: unknown option \"" << arg << "\"\n";
+		}
+	}
+
+	return conf;
+}
+
+}
+
+void clEasyRun(const Storage &stor, const char *configString)
 {
 	LoopFinder::computeLoopAnalysis(stor);
 	// LoopFinder::printLoopAnalysis(std::cout);
@@ -31,14 +81,11 @@ void clEasyRun(const Storage &stor, const char *)
 	GlobAnalysis::computeGlobAnalysis(stor);
 	// GlobAnalysis::printGlobAnalysis(std::cout);
 
-	BOOST_FOREACH(const Fnc* pFnc, stor.fncs) {
-		const Fnc &fnc = *pFnc;
-
-		if (!isDefined(fnc))
-			continue;
-
-		ValueAnalysis::computeAnalysisForFnc(fnc);
-	}
+	const VraConf conf = parseConfig(configString);
+	ValueAnalysis::computeAnalysis(stor, conf.jobs);
 
 	ValueAnalysis::printRanges(std::cout, stor);
+
+	if (conf.printStats)
+		ValueAnalysis::printStats(std::cerr, stor);
 }